@@ -0,0 +1,567 @@
+/**********************************************************************************************
+*
+*   maze - Procedural maze generation module
+*
+*   Grid-based maze generator shared by the game and the headless tools, it does not
+*   require a window, OpenGL context or audio device and it does not touch any global
+*   state, so multiple mazes can be generated concurrently from different threads
+*
+*   The authoritative maze representation is MazeGrid: a bit-packed grid (1 bit per cell,
+*   1=Wall, 0=Walkable) stored in 64-bit words, row by row, every row starting on a new word,
+*   the raylib Image/Texture used for display is generated from it (LoadImageFromMazeGrid())
+*
+*   Random values are counter-based: every value is a hash of (seed, cell coordinates, stream),
+*   no random state is carried between values, so the same seed always generates a bit-identical
+*   maze on any thread count or machine. Mazes are generated in bands of MAZE_BAND_ROWS rows,
+*   every band only depends on the seed and its own cells, so bands can be generated in parallel
+*   (GenMazeGridEx()) or on demand (GenMazeGridBand())
+*
+*   CONFIGURATION:
+*       #define MAZE_IMPLEMENTATION
+*           Generates the implementation of the module in the including file,
+*           only ONE file of the program should define it
+*
+*       #define MAZE_MALLOC/MAZE_CALLOC/MAZE_REALLOC/MAZE_FREE
+*           Custom memory allocators, by default stdlib malloc(), calloc(), realloc() and free() are used
+*
+*       #define MAZE_NO_THREADS
+*           Disables worker threads (C11 threads.h), maze bands are generated by the calling thread
+*
+*   DEPENDENCIES:
+*       raylib.h    - OPTIONAL: If included before this module, raylib interop functions are
+*                     available (GenImageMaze(), LoadImageFromMazeGrid())
+*       threads.h   - Maze generation worker threads (C11), not required if MAZE_NO_THREADS is defined
+*
+**********************************************************************************************/
+
+#ifndef MAZE_H
+#define MAZE_H
+
+#include <stdbool.h>                    // Required for: bool
+#include <stdint.h>                     // Required for: uint64_t
+#include <stddef.h>                     // Required for: size_t
+#include <math.h>                       // Required for: floorf(), roundf()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#ifndef MAZE_MALLOC
+    #define MAZE_MALLOC(sz)         malloc(sz)
+#endif
+#ifndef MAZE_CALLOC
+    #define MAZE_CALLOC(n,sz)       calloc(n,sz)
+#endif
+#ifndef MAZE_REALLOC
+    #define MAZE_REALLOC(ptr,sz)    realloc(ptr,sz)
+#endif
+#ifndef MAZE_FREE
+    #define MAZE_FREE(ptr)          free(ptr)
+#endif
+
+// Maze generation band size (rows), bands are generated independently
+// NOTE: Walls growing vertically stop at band borders
+#define MAZE_BAND_ROWS      64
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Declare new data type: Point
+typedef struct Point {
+    int x;
+    int y;
+} Point;
+
+// Maze grid, bit-packed (1=Wall, 0=Walkable)
+typedef struct MazeGrid {
+    int width;                  // Maze width in cells
+    int height;                 // Maze height in cells
+    int stride;                 // Words per row
+    uint64_t *cells;            // Cells bits, row by row, bit (x%64) of word (x/64) is cell x
+} MazeGrid;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+// Maze grid management
+MazeGrid LoadMazeGrid(int width, int height);                       // Load maze grid, all cells walkable
+void UnloadMazeGrid(MazeGrid grid);                                 // Unload maze grid from memory
+
+// Generate procedural maze grid, using grid-based algorithm
+// NOTE: The same seed always generates the same maze, no global random state is used
+MazeGrid GenMazeGrid(int width, int height, int spacingRows, int spacingCols, float skipChance, unsigned int seed);
+MazeGrid GenMazeGridEx(int width, int height, int spacingRows, int spacingCols, float skipChance, unsigned int seed, int threadCount);  // Generate maze grid, bands generated by several threads (threadCount: 0 = all processors)
+bool GenMazeGridBand(MazeGrid *grid, int band, int spacingRows, int spacingCols, float skipChance, unsigned int seed);   // Generate maze band rows [band*MAZE_BAND_ROWS, (band + 1)*MAZE_BAND_ROWS) into grid
+
+bool ExportMazeGrid(MazeGrid grid, const char *fileName);           // Export maze grid as PBM (P4) bitmap image (WHITE=Wall, BLACK=Walkable)
+
+#if defined(RAYLIB_H)
+// raylib interop, the maze grid is the authoritative data, images are for display only
+Image GenImageMaze(int width, int height, int spacingRows, int spacingCols, float skipChance, unsigned int seed); // Generate maze image, using grid-based algorithm
+Image LoadImageFromMazeGrid(MazeGrid grid);                         // Load image from maze grid (WHITE=Wall, BLACK=Walkable)
+#endif
+
+double GetElapsedTime(void);            // Get time in seconds from a monotonic clock (for measurements)
+int GetProcessorCount(void);            // Get number of logical processors available
+
+// Maze random value streams, independent values for the same cell
+typedef enum {
+    MAZE_RANDOM_CHANCE = 0,     // Grid point selection chance
+    MAZE_RANDOM_DIRECTION,      // Wall growing direction
+    MAZE_RANDOM_SHUFFLE,        // Band points shuffle
+    MAZE_RANDOM_ALGORITHM,      // Sequential values (generation algorithms)
+    MAZE_RANDOM_CHUNK,          // Stream chunk seed
+    MAZE_RANDOM_DOOR,           // Stream chunk border doors
+    MAZE_RANDOM_ITEM,           // Items bulk placement cells
+    MAZE_RANDOM_BOT,            // Bots random choices
+} MazeRandomStream;
+
+// Get random value for a maze cell (counter-based, same inputs always give the same value)
+// NOTE: stream selects independent values for the same cell (i.e. chance and direction)
+static inline unsigned int GetMazeRandom(unsigned int seed, int x, int y, unsigned int stream)
+{
+    // Hash inputs with splitmix64 finalizer rounds
+    uint64_t hash = ((uint64_t)seed << 32) | stream;
+
+    for (int i = 0; i < 3; i++)
+    {
+        hash += 0x9e3779b97f4a7c15ull;
+        hash = (hash ^ (hash >> 30))*0xbf58476d1ce4e5b9ull;
+        hash = (hash ^ (hash >> 27))*0x94d049bb133111ebull;
+        hash ^= hash >> 31;
+        hash ^= (i == 0)? (uint64_t)(unsigned int)x : (i == 1)? (uint64_t)(unsigned int)y << 32 : 0;
+    }
+
+    return (unsigned int)hash;
+}
+
+// Get maze grid row words
+static inline uint64_t *GetMazeRow(MazeGrid grid, int y)
+{
+    return grid.cells + (size_t)y*grid.stride;
+}
+
+// Check if maze cell is a wall, cells out of the grid are considered walls
+static inline bool IsMazeWall(MazeGrid grid, int x, int y)
+{
+    if (((unsigned int)x >= (unsigned int)grid.width) || ((unsigned int)y >= (unsigned int)grid.height)) return true;
+    return (grid.cells[(size_t)y*grid.stride + (x >> 6)] >> (x & 63)) & 1;
+}
+
+// Set maze cell as wall or walkable, cells out of the grid are ignored
+static inline void SetMazeWall(MazeGrid *grid, int x, int y, bool wall)
+{
+    if (((unsigned int)x >= (unsigned int)grid->width) || ((unsigned int)y >= (unsigned int)grid->height)) return;
+
+    uint64_t *word = &grid->cells[(size_t)y*grid->stride + (x >> 6)];
+    if (wall) *word |= (1ull << (x & 63));
+    else *word &= ~(1ull << (x & 63));
+}
+
+// Get cells under the leading side corners of a square (center x, y, half size radius) moving along one axis
+// NOTE: dirX or dirY is the moving direction (-1 or 1, the other one 0), cell (x, y) covers [x, x + 1)
+static inline void GetMazeBoxCells(float x, float y, float radius, int dirX, int dirY, Point *cells)
+{
+    if (dirX != 0)
+    {
+        cells[0] = (Point){ (int)floorf(x + dirX*radius), (int)floorf(y - radius) };
+        cells[1] = (Point){ cells[0].x, (int)floorf(y + radius) };
+    }
+    else
+    {
+        cells[0] = (Point){ (int)floorf(x - radius), (int)floorf(y + dirY*radius) };
+        cells[1] = (Point){ (int)floorf(x + radius), cells[0].y };
+    }
+}
+
+// Get cells reached by a point (x, y) moving (dx, dy), one cell per axis
+// NOTE: Cell (x, y) is centered at (x, y), positions are rounded to cells
+static inline void GetMazeStepCells(float x, float y, float dx, float dy, Point *cells)
+{
+    cells[0] = (Point){ (int)roundf(x + dx), (int)roundf(y) };
+    cells[1] = (Point){ (int)roundf(x), (int)roundf(y + dy) };
+}
+
+// Check collision of a square moving along one axis (2D movement), see GetMazeBoxCells()
+static inline bool CheckMazeCollisionBox(MazeGrid grid, float x, float y, float radius, int dirX, int dirY)
+{
+    Point cells[2];
+    GetMazeBoxCells(x, y, radius, dirX, dirY, cells);
+
+    return IsMazeWall(grid, cells[0].x, cells[0].y) || IsMazeWall(grid, cells[1].x, cells[1].y);
+}
+
+// Check collision of a point moving (3D movement), see GetMazeStepCells()
+static inline bool CheckMazeCollisionStep(MazeGrid grid, float x, float y, float dx, float dy)
+{
+    Point cells[2];
+    GetMazeStepCells(x, y, dx, dy, cells);
+
+    return IsMazeWall(grid, cells[0].x, cells[0].y) || IsMazeWall(grid, cells[1].x, cells[1].y);
+}
+
+#if defined(__cplusplus)
+}
+#endif
+
+/***********************************************************************************
+*
+*   MAZE IMPLEMENTATION
+*
+************************************************************************************/
+#if defined(MAZE_IMPLEMENTATION)
+
+#include <stdlib.h>                     // Required for: malloc(), free()
+#include <stdio.h>                      // Required for: FILE, fopen(), fwrite(), fclose()
+#include <string.h>                     // Required for: memset()
+#include <time.h>                       // Required for: clock_gettime(), timespec_get()
+
+#if !defined(MAZE_NO_THREADS)
+    #include <threads.h>                // Required for: thrd_create(), thrd_join()
+    #include <stdatomic.h>              // Required for: atomic_int, atomic_fetch_add()
+#endif
+
+#if defined(_WIN32)
+    // NOTE: Declaring the required Win32 functions to avoid including windows.h,
+    // it collides with raylib symbols (CloseWindow, ShowCursor, Rectangle...)
+    __declspec(dllimport) int __stdcall QueryPerformanceCounter(unsigned long long *lpPerformanceCount);
+    __declspec(dllimport) int __stdcall QueryPerformanceFrequency(unsigned long long *lpFrequency);
+    __declspec(dllimport) unsigned long __stdcall GetActiveProcessorCount(unsigned short groupNumber);
+#else
+    #include <unistd.h>                 // Required for: sysconf()
+#endif
+
+#define MAX_MAZE_THREADS    64          // Maximum threads generating a maze grid
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+#if !defined(MAZE_NO_THREADS)
+// Maze generation work shared by workers, bands are taken in order
+typedef struct MazeGenWork {
+    MazeGrid *grid;             // Grid being generated
+    int spacingRows;            // Grid points spacing (rows)
+    int spacingCols;            // Grid points spacing (columns)
+    float skipChance;           // Grid point skip chance
+    unsigned int seed;          // Maze seed
+    atomic_int nextBand;        // Next band to be taken
+    atomic_int failed;          // Bands failed (out of memory)
+} MazeGenWork;
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+#if !defined(MAZE_NO_THREADS)
+static int MazeGenWorker(void *arg);    // Worker thread: generate bands until no band is left
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Load maze grid, all cells walkable
+MazeGrid LoadMazeGrid(int width, int height)
+{
+    MazeGrid grid = { 0 };
+
+    if ((width <= 0) || (height <= 0)) return grid;
+
+    grid.width = width;
+    grid.height = height;
+    grid.stride = (width + 63)/64;
+    grid.cells = (uint64_t *)MAZE_CALLOC((size_t)grid.stride*height, sizeof(uint64_t));
+
+    if (grid.cells == NULL) grid = (MazeGrid){ 0 };
+
+    return grid;
+}
+
+// Unload maze grid from memory
+void UnloadMazeGrid(MazeGrid grid)
+{
+    MAZE_FREE(grid.cells);
+}
+
+// Generate procedural maze grid, using grid-based algorithm
+MazeGrid GenMazeGrid(int width, int height, int spacingRows, int spacingCols, float skipChance, unsigned int seed)
+{
+    return GenMazeGridEx(width, height, spacingRows, spacingCols, skipChance, seed, 1);
+}
+
+// Generate procedural maze grid, bands generated by several threads (threadCount: 0 = all processors)
+// NOTE: Result only depends on seed, never on threadCount
+MazeGrid GenMazeGridEx(int width, int height, int spacingRows, int spacingCols, float skipChance, unsigned int seed, int threadCount)
+{
+    // Generate grid with all cells walkable
+    MazeGrid grid = LoadMazeGrid(width, height);
+    if (grid.cells == NULL) return grid;
+
+    int bandCount = (height + MAZE_BAND_ROWS - 1)/MAZE_BAND_ROWS;
+    bool failed = false;
+
+    if (threadCount <= 0) threadCount = GetProcessorCount();
+    if (threadCount > bandCount) threadCount = bandCount;
+
+#if !defined(MAZE_NO_THREADS)
+    if (threadCount > MAX_MAZE_THREADS) threadCount = MAX_MAZE_THREADS;
+
+    if (threadCount > 1)
+    {
+        // Bands write disjoint rows (every row starts on a new word), no locking required,
+        // the calling thread also generates bands
+        MazeGenWork work = { .grid = &grid, .spacingRows = spacingRows, .spacingCols = spacingCols, .skipChance = skipChance, .seed = seed };
+        thrd_t threads[MAX_MAZE_THREADS] = { 0 };
+        int workerCount = 0;
+
+        for (int i = 1; i < threadCount; i++)
+        {
+            if (thrd_create(&threads[workerCount], MazeGenWorker, &work) == thrd_success) workerCount++;
+        }
+
+        MazeGenWorker(&work);
+
+        for (int i = 0; i < workerCount; i++) thrd_join(threads[i], NULL);
+
+        failed = (atomic_load(&work.failed) > 0);
+    }
+    else
+#endif
+    {
+        for (int band = 0; band < bandCount; band++)
+        {
+            if (!GenMazeGridBand(&grid, band, spacingRows, spacingCols, skipChance, seed)) failed = true;
+        }
+    }
+
+    if (failed)
+    {
+        UnloadMazeGrid(grid);
+        return (MazeGrid){ 0 };
+    }
+
+    return grid;
+}
+
+// Generate maze band rows [band*MAZE_BAND_ROWS, (band + 1)*MAZE_BAND_ROWS) into grid
+// NOTE: Band rows are cleared first, band only depends on seed and its cells (not on other bands)
+bool GenMazeGridBand(MazeGrid *grid, int band, int spacingRows, int spacingCols, float skipChance, unsigned int seed)
+{
+    int width = grid->width;
+    int height = grid->height;
+    int firstRow = band*MAZE_BAND_ROWS;
+    int lastRow = firstRow + MAZE_BAND_ROWS;
+
+    if ((grid->cells == NULL) || (band < 0) || (firstRow >= height)) return false;
+    if (lastRow > height) lastRow = height;
+
+    if (spacingRows < 1) spacingRows = 1;
+    if (spacingCols < 1) spacingCols = 1;
+
+    // Allocate an array of point used for maze generation, one per band grid point (worst case)
+    // NOTE: Dynamic array allocation, memory allocated in HEAP (MAX: Available RAM)
+    size_t maxMazePoints = (size_t)(width/spacingCols + 1)*(MAZE_BAND_ROWS/spacingRows + 1);
+    Point *mazePoints = (Point *)MAZE_MALLOC(maxMazePoints*sizeof(Point));
+    int mazePointsCounter = 0;
+
+    if (mazePoints == NULL) return false;
+
+    // Clear band rows, grid borders (1 cell) are walls
+    memset(GetMazeRow(*grid, firstRow), 0, (size_t)grid->stride*(lastRow - firstRow)*sizeof(uint64_t));
+
+    for (int y = firstRow; y < lastRow; y++)
+    {
+        SetMazeWall(grid, 0, y, true);
+        SetMazeWall(grid, width - 1, y, true);
+    }
+
+    if (firstRow == 0) for (int x = 0; x < width; x++) SetMazeWall(grid, x, 0, true);
+    if (lastRow == height) for (int x = 0; x < width; x++) SetMazeWall(grid, x, height - 1, true);
+
+    // Start traversing band grid points, line by line, to paint our maze
+    int firstY = ((firstRow + spacingRows - 1)/spacingRows)*spacingRows;
+    if (firstY < spacingRows) firstY = spacingRows;
+
+    for (int y = firstY; (y < lastRow) && (y < (height - 1)); y += spacingRows)
+    {
+        for (int x = spacingCols; x < (width - 1); x += spacingCols)
+        {
+            // Get change to define a point for further processing
+            float chance = (float)(GetMazeRandom(seed, x, y, MAZE_RANDOM_CHANCE)%101)/100.0f;
+
+            if (chance >= skipChance)
+            {
+                // Set point as wall...
+                SetMazeWall(grid, x, y, true);
+
+                // ...save point for further processing
+                mazePoints[mazePointsCounter] = (Point){ x, y };
+                mazePointsCounter++;
+            }
+        }
+    }
+
+    // Define an array of 4 directions for convenience
+    Point directions[4] = {
+        { 0, -1 },      // Up
+        { 0, 1 },       // Down
+        { -1, 0 },      // Left
+        { 1, 0 },       // Right
+    };
+
+    // Shuffle points (Fisher-Yates), so we process mazePoints[] randomly,
+    // instead of following the order we got them
+    for (int i = mazePointsCounter - 1; i > 0; i--)
+    {
+        int j = (int)(GetMazeRandom(seed, i, band, MAZE_RANDOM_SHUFFLE)%(unsigned int)(i + 1));
+        Point temp = mazePoints[i];
+        mazePoints[i] = mazePoints[j];
+        mazePoints[j] = temp;
+    }
+
+    // Process every random maze point, moving in one random direction,
+    // until we collision with another wall or the band border
+    for (int i = 0; i < mazePointsCounter; i++)
+    {
+        Point currentPoint = mazePoints[i];
+        Point currentDir = directions[GetMazeRandom(seed, currentPoint.x, currentPoint.y, MAZE_RANDOM_DIRECTION)%4];
+        currentPoint.x += currentDir.x;
+        currentPoint.y += currentDir.y;
+
+        // Keep incrementing wall in selected direction until a wall is found
+        while ((currentPoint.y >= firstRow) && (currentPoint.y < lastRow) && !IsMazeWall(*grid, currentPoint.x, currentPoint.y))
+        {
+            SetMazeWall(grid, currentPoint.x, currentPoint.y, true);
+
+            currentPoint.x += currentDir.x;
+            currentPoint.y += currentDir.y;
+        }
+    }
+
+    MAZE_FREE(mazePoints);
+
+    return true;
+}
+
+// Export maze grid as PBM (P4) bitmap image (WHITE=Wall, BLACK=Walkable)
+// NOTE: PBM stores 1 bit per pixel, most significant bit first, 1=Black
+bool ExportMazeGrid(MazeGrid grid, const char *fileName)
+{
+    FILE *file = fopen(fileName, "wb");
+    if (file == NULL) return false;
+
+    int lineSize = (grid.width + 7)/8;
+    unsigned char *line = (unsigned char *)MAZE_MALLOC(lineSize);
+    bool success = (line != NULL) && (fprintf(file, "P4\n%i %i\n", grid.width, grid.height) > 0);
+
+    for (int y = 0; success && (y < grid.height); y++)
+    {
+        const uint64_t *row = GetMazeRow(grid, y);
+
+        for (int i = 0; i < lineSize; i++)
+        {
+            // Reverse bits order and invert, walkable cells are black
+            unsigned char bits = (unsigned char)(row[i >> 3] >> ((i & 7)*8));
+            bits = (unsigned char)(((bits*0x0802u & 0x22110u) | (bits*0x8020u & 0x88440u))*0x10101u >> 16);
+            line[i] = (unsigned char)~bits;
+        }
+
+        success = (fwrite(line, 1, lineSize, file) == (size_t)lineSize);
+    }
+
+    MAZE_FREE(line);
+    fclose(file);
+
+    return success;
+}
+
+#if defined(RAYLIB_H)
+// Generate maze image, using grid-based algorithm
+// NOTE: Black=Walkable cell, White=Wall/Block cell
+Image GenImageMaze(int width, int height, int spacingRows, int spacingCols, float skipChance, unsigned int seed)
+{
+    MazeGrid grid = GenMazeGrid(width, height, spacingRows, spacingCols, skipChance, seed);
+    Image image = LoadImageFromMazeGrid(grid);
+    UnloadMazeGrid(grid);
+
+    return image;
+}
+
+// Load image from maze grid (WHITE=Wall, BLACK=Walkable)
+// NOTE: Image is generated in grayscale format (1 byte per pixel) to reduce memory usage
+Image LoadImageFromMazeGrid(MazeGrid grid)
+{
+    Image image = { 0 };
+
+    image.data = RL_MALLOC((size_t)grid.width*grid.height);
+    if (image.data == NULL) return image;
+
+    image.width = grid.width;
+    image.height = grid.height;
+    image.mipmaps = 1;
+    image.format = PIXELFORMAT_UNCOMPRESSED_GRAYSCALE;
+
+    unsigned char *pixels = (unsigned char *)image.data;
+
+    for (int y = 0; y < grid.height; y++)
+    {
+        const uint64_t *row = GetMazeRow(grid, y);
+        unsigned char *line = pixels + (size_t)y*grid.width;
+
+        for (int x = 0; x < grid.width; x++) line[x] = ((row[x >> 6] >> (x & 63)) & 1)? 255 : 0;
+    }
+
+    return image;
+}
+#endif
+
+// Get time in seconds from a monotonic clock (for measurements)
+double GetElapsedTime(void)
+{
+#if defined(_WIN32)
+    unsigned long long counter = 0, frequency = 1;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter/(double)frequency;
+#else
+    struct timespec now = { 0 };
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec*1e-9;
+#endif
+}
+
+// Get number of logical processors available
+int GetProcessorCount(void)
+{
+#if defined(_WIN32)
+    int count = (int)GetActiveProcessorCount(0xffff);   // ALL_PROCESSOR_GROUPS
+#else
+    int count = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    return (count > 0)? count : 1;
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+#if !defined(MAZE_NO_THREADS)
+// Maze generation worker: generate bands until no band is left
+static int MazeGenWorker(void *arg)
+{
+    MazeGenWork *work = (MazeGenWork *)arg;
+    int bandCount = (work->grid->height + MAZE_BAND_ROWS - 1)/MAZE_BAND_ROWS;
+
+    for (int band = atomic_fetch_add(&work->nextBand, 1); band < bandCount; band = atomic_fetch_add(&work->nextBand, 1))
+    {
+        if (!GenMazeGridBand(work->grid, band, work->spacingRows, work->spacingCols, work->skipChance, work->seed)) atomic_fetch_add(&work->failed, 1);
+    }
+
+    return 0;
+}
+#endif
+
+#endif // MAZE_IMPLEMENTATION
+
+#endif // MAZE_H
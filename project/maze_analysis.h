@@ -0,0 +1,580 @@
+/**********************************************************************************************
+*
+*   maze_analysis - Maze structure analysis module
+*
+*   Linear time analysis of a MazeGrid (MazeAnalysis): walkable connected components, exit
+*   reachability from start, solution length, dead ends, junctions and corridor lengths, so
+*   generated mazes can be checked (and rejected) before being played
+*
+*   Connected components (4-connected) are found with union-find over horizontal runs of
+*   walkable cells: runs are extracted from the grid row words with bit scans and joined with
+*   the overlapping runs of the previous row, so the work depends on runs, not on cells.
+*   Cell neighbour counts (dead ends, corridors, junctions) are computed 64 cells at once with
+*   bitwise adders over the grid words, solution length is the flow field distance (word-parallel
+*   BFS, maze_path.h) from exit to start
+*
+*   Connectivity repair (RepairMazeConnectivity()) connects walkable components to the start
+*   component removing interior walls, instead of generating mazes again until they are solvable:
+*   a 0-1 BFS from start (walkable cells cost 0, walls cost 1) reaches every component through
+*   the fewest walls from the components already reached, and those walls are removed (greedy,
+*   not a global minimum), linear time in grid cells (every cell is queued once). Border walls
+*   are kept, components only reachable through them (i.e. walkable corner cells) are left
+*   unconnected and counted (MazeAnalyzer.unconnected)
+*
+*   Analysis contexts (MazeAnalyzer) are reusable, buffers are only allocated again when the
+*   maze size changes, one context should be used per thread
+*
+*   CONFIGURATION:
+*       #define MAZE_IMPLEMENTATION
+*           Generates the implementation of the module in the including file,
+*           only ONE file of the program should define it
+*
+*   DEPENDENCIES:
+*       maze.h      - MazeGrid, Point, memory allocators
+*       maze_path.h - FlowField, ComputeFlowField() (solution length)
+*
+**********************************************************************************************/
+
+#ifndef MAZE_ANALYSIS_H
+#define MAZE_ANALYSIS_H
+
+#include "maze.h"                       // Required for: MazeGrid, Point, GetMazeRow()
+#include "maze_path.h"                  // Required for: FlowField, ComputeFlowField()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define MAZE_ANALYSIS_CORRIDOR_BINS     16      // Corridor length histogram bins, bin i: lengths [2^i, 2^(i + 1))
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Maze analysis results
+typedef struct MazeAnalysis {
+    int walkable;               // Walkable cells
+    int components;             // Walkable connected components (4-connected)
+    int largestComponent;       // Cells of largest component
+    int startComponent;         // Cells of start cell component (cells reachable from start, 0 if start is a wall)
+    bool exitReachable;         // Exit cell reachable from start cell
+    int solutionLength;         // Shortest path steps from start to exit (-1: exit not reachable)
+    int deadEnds;               // Walkable cells with one walkable neighbour
+    int junctions;              // Walkable cells with three or more walkable neighbours
+    int corridors;              // Corridors: chains of walkable cells with two walkable neighbours
+    int corridorHistogram[MAZE_ANALYSIS_CORRIDOR_BINS];    // Corridors per length (cells), bin i: lengths [2^i, 2^(i + 1))
+} MazeAnalysis;
+
+// Maze analysis context, reusable between analyses
+typedef struct MazeAnalyzer {
+    int width;                  // Context width in cells
+    int height;                 // Context height in cells
+
+    int *parent;                // Union-find parent, per run (root: component)
+    int *size;                  // Run cells, component cells at root
+    int runCapacity;            // Runs allocated
+    int *rows[2];               // Previous and current row runs: start x, end x (excluded), run index
+    uint64_t *traced;           // Corridor cells already traced bits, per grid word
+    FlowField field;            // Distances to exit (valid after analysis if exit is reachable)
+    int *queue;                 // Repair cells queue (double ended, ring buffer), allocated on first repair
+    unsigned char *from;        // Repair cells parent direction (0: not visited), allocated on first repair
+    int unconnected;            // Walkable components left unconnected by last repair (only reachable through border walls)
+} MazeAnalyzer;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+MazeAnalyzer LoadMazeAnalyzer(int width, int height);               // Load analysis context for a maze size (resized if required)
+void UnloadMazeAnalyzer(MazeAnalyzer analyzer);                     // Unload analysis context
+MazeAnalysis AnalyzeMaze(MazeAnalyzer *analyzer, MazeGrid grid, Point start, Point end);   // Analyze maze structure, start to exit
+int RepairMazeConnectivity(MazeAnalyzer *analyzer, MazeGrid *grid, Point start, Point end);    // Remove interior walls to connect walkable cells to start, returns walls removed
+
+#if defined(__cplusplus)
+}
+#endif
+
+/***********************************************************************************
+*
+*   MAZE ANALYSIS IMPLEMENTATION
+*
+************************************************************************************/
+#if defined(MAZE_IMPLEMENTATION)
+
+#include <string.h>                     // Required for: memset()
+
+#if defined(_MSC_VER)
+    #include <intrin.h>                 // Required for: _BitScanForward64(), __popcnt64()
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static bool AnalyzerReset(MazeAnalyzer *analyzer, int width, int height);      // Resize context buffers if required
+static int AnalyzerLabelRuns(MazeAnalyzer *analyzer, MazeGrid grid, Point start, Point end, int *startRun, int *endRun);   // Join walkable runs into components, returns runs count (-1 on failure)
+static bool AnalyzerAddRun(MazeAnalyzer *analyzer, int index, int cells);       // Add run as a new component
+static int AnalyzerFind(MazeAnalyzer *analyzer, int run);                       // Get run component root (path halving)
+static void AnalyzerUnion(MazeAnalyzer *analyzer, int a, int b);                // Join runs components (union by size)
+static int AnalyzerTraceCorridor(MazeAnalyzer *analyzer, MazeGrid grid, int x, int y);     // Trace corridor through cell, returns corridor cells
+static inline uint64_t AnalysisRowWord(MazeGrid grid, int y, int k);            // Get row word walkable bits, cells out of the grid are walls
+static inline int AnalysisNextCell(MazeGrid grid, int y, int x, bool walkable);    // Get first walkable (or wall) cell x from x, width if none
+static inline int AnalysisNeighbours(MazeGrid grid, int x, int y);              // Get cell walkable neighbours count
+static inline int AnalysisLowestBit(uint64_t word);                            // Get index of lowest set bit (word must not be 0)
+static inline int AnalysisBitCount(uint64_t word);                             // Get number of set bits
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Load analysis context for a maze size (resized if required)
+MazeAnalyzer LoadMazeAnalyzer(int width, int height)
+{
+    MazeAnalyzer analyzer = { 0 };
+
+    AnalyzerReset(&analyzer, width, height);
+
+    return analyzer;
+}
+
+// Unload analysis context
+void UnloadMazeAnalyzer(MazeAnalyzer analyzer)
+{
+    MAZE_FREE(analyzer.parent);
+    MAZE_FREE(analyzer.size);
+    MAZE_FREE(analyzer.rows[0]);
+    MAZE_FREE(analyzer.rows[1]);
+    MAZE_FREE(analyzer.traced);
+    MAZE_FREE(analyzer.queue);
+    MAZE_FREE(analyzer.from);
+    UnloadFlowField(analyzer.field);
+}
+
+// Analyze maze structure, start to exit
+// NOTE: Solution length is only computed if exit is reachable (components are checked first)
+MazeAnalysis AnalyzeMaze(MazeAnalyzer *analyzer, MazeGrid grid, Point start, Point end)
+{
+    MazeAnalysis analysis = { 0 };
+    analysis.solutionLength = -1;
+
+    if ((grid.cells == NULL) || !AnalyzerReset(analyzer, grid.width, grid.height)) return analysis;
+
+    // Connected components: union-find over horizontal runs of walkable cells
+    int startRun = -1;
+    int endRun = -1;
+    int runCount = AnalyzerLabelRuns(analyzer, grid, start, end, &startRun, &endRun);
+
+    if (runCount < 0) return analysis;
+
+    for (int i = 0; i < runCount; i++)
+    {
+        if (analyzer->parent[i] != i) continue;
+
+        analysis.components++;
+        if (analyzer->size[i] > analysis.largestComponent) analysis.largestComponent = analyzer->size[i];
+    }
+
+    if (startRun >= 0) analysis.startComponent = analyzer->size[AnalyzerFind(analyzer, startRun)];
+    analysis.exitReachable = (startRun >= 0) && (endRun >= 0) && (AnalyzerFind(analyzer, startRun) == AnalyzerFind(analyzer, endRun));
+
+    // Neighbour counts, 64 cells at once: up + down + left + right with bitwise adders
+    memset(analyzer->traced, 0, (size_t)grid.stride*grid.height*sizeof(uint64_t));
+
+    for (int y = 0; y < grid.height; y++)
+    {
+        for (int k = 0; k < grid.stride; k++)
+        {
+            uint64_t cells = AnalysisRowWord(grid, y, k);
+            if (cells == 0) continue;
+
+            uint64_t up = AnalysisRowWord(grid, y - 1, k);
+            uint64_t down = AnalysisRowWord(grid, y + 1, k);
+            uint64_t left = (cells << 1) | (AnalysisRowWord(grid, y, k - 1) >> 63);
+            uint64_t right = (cells >> 1) | (AnalysisRowWord(grid, y, k + 1) << 63);
+
+            uint64_t sum1 = up ^ down;
+            uint64_t carry1 = up & down;
+            uint64_t sum2 = left ^ right;
+            uint64_t carry2 = left & right;
+            uint64_t ones = sum1 ^ sum2;            // Count bit 0
+            uint64_t carry3 = sum1 & sum2;          // Exclusive with carry1 and carry2 (count = ones + 2*carries)
+
+            uint64_t oneNeighbour = cells & ones & ~(carry1 | carry2 | carry3);
+            uint64_t twoNeighbours = cells & ~ones & (carry1 ^ carry2 ^ carry3);
+            uint64_t moreNeighbours = cells & ((ones & (carry1 | carry2 | carry3)) | (carry1 & carry2));
+
+            analysis.walkable += AnalysisBitCount(cells);
+            analysis.deadEnds += AnalysisBitCount(oneNeighbour);
+            analysis.junctions += AnalysisBitCount(moreNeighbours);
+
+            // Corridors: every not traced cell with two neighbours starts a corridor trace
+            while (twoNeighbours != 0)
+            {
+                int x = k*64 + AnalysisLowestBit(twoNeighbours);
+                twoNeighbours &= twoNeighbours - 1;
+
+                if ((analyzer->traced[(size_t)y*grid.stride + k] >> (x & 63)) & 1) continue;
+
+                int length = AnalyzerTraceCorridor(analyzer, grid, x, y);
+                int bin = 0;
+                while (((length >> (bin + 1)) != 0) && (bin < MAZE_ANALYSIS_CORRIDOR_BINS - 1)) bin++;
+
+                analysis.corridors++;
+                analysis.corridorHistogram[bin]++;
+            }
+        }
+    }
+
+    // Solution length: distance from start on exit flow field
+    if (analysis.exitReachable && ComputeFlowField(&analyzer->field, grid, end, 1)) analysis.solutionLength = GetFlowFieldDistance(analyzer->field, start.x, start.y);
+
+    return analysis;
+}
+
+// Remove interior walls to connect walkable cells to start, returns walls removed
+// NOTE: Start and exit cells are opened if they are walls. Cells are visited with a 0-1 BFS from start
+// (walkable cells queued at front with same walls count, walls queued at back with one more wall), so every
+// component is reached through the fewest walls from the cells already reached, and the walls of that path
+// are removed. Walls shared by several paths are removed once, total is not a global minimum
+// NOTE: Border walls are never removed (maze keeps its frame), BFS stops once every walkable cell is reached,
+// components only reachable through border walls are left unconnected, counted in analyzer->unconnected
+// WARNING: Repair buffers are allocated on first repair, 5 bytes per cell (queue and parent directions)
+int RepairMazeConnectivity(MazeAnalyzer *analyzer, MazeGrid *grid, Point start, Point end)
+{
+    static const Point directions[4] = { { 0, -1 }, { 1, 0 }, { 0, 1 }, { -1, 0 } };
+
+    if ((grid == NULL) || (grid->cells == NULL) || !AnalyzerReset(analyzer, grid->width, grid->height)) return 0;
+
+    int width = grid->width;
+    int height = grid->height;
+
+    if ((start.x < 0) || (start.y < 0) || (start.x >= width) || (start.y >= height)) return 0;
+
+    int removed = 0;
+    analyzer->unconnected = 0;
+
+    if (IsMazeWall(*grid, start.x, start.y)) { SetMazeWall(grid, start.x, start.y, false); removed++; }
+    if ((end.x >= 0) && (end.y >= 0) && (end.x < width) && (end.y < height) && IsMazeWall(*grid, end.x, end.y)) { SetMazeWall(grid, end.x, end.y, false); removed++; }
+
+    // Components: nothing to repair if all walkable cells are connected
+    int startRun = -1;
+    int endRun = -1;
+    int runCount = AnalyzerLabelRuns(analyzer, *grid, start, end, &startRun, &endRun);
+    int components = 0;
+    int walkable = 0;
+
+    for (int i = 0; i < runCount; i++)
+    {
+        if (analyzer->parent[i] != i) continue;
+
+        components++;
+        walkable += analyzer->size[i];
+    }
+
+    if (components <= 1) return removed;
+
+    size_t cellCount = (size_t)width*height;
+
+    if (analyzer->queue == NULL) analyzer->queue = (int *)MAZE_MALLOC(cellCount*sizeof(int));
+    if (analyzer->from == NULL) analyzer->from = (unsigned char *)MAZE_MALLOC(cellCount);
+    if ((analyzer->queue == NULL) || (analyzer->from == NULL))
+    {
+        analyzer->unconnected = components - 1;
+        return removed;
+    }
+
+    // Parent direction per cell: 0 not visited, direction + 1 (from parent to cell), 5 start
+    int *queue = analyzer->queue;
+    unsigned char *from = analyzer->from;
+    int offsets[4] = { -width, 1, width, -1 };
+    size_t head = 0;
+    size_t count = 1;
+    int reached = 1;
+
+    memset(from, 0, cellCount);
+    queue[0] = start.y*width + start.x;
+    from[queue[0]] = 5;
+
+    while ((count > 0) && (reached < walkable))
+    {
+        int index = queue[head];
+        int x = index%width;
+        int y = index/width;
+
+        head = (head + 1 < cellCount)? head + 1 : 0;
+        count--;
+
+        for (int d = 0; d < 4; d++)
+        {
+            int nx = x + directions[d].x;
+            int ny = y + directions[d].y;
+
+            if ((nx < 0) || (ny < 0) || (nx >= width) || (ny >= height) || (from[index + offsets[d]] != 0)) continue;
+
+            if (!IsMazeWall(*grid, nx, ny))
+            {
+                // Walkable cell reached from a wall: walls path to reached cells is removed
+                for (int cell = index; IsMazeWall(*grid, cell%width, cell/width); cell -= offsets[from[cell] - 1])
+                {
+                    SetMazeWall(grid, cell%width, cell/width, false);
+                    removed++;
+                }
+
+                head = (head > 0)? head - 1 : cellCount - 1;
+                queue[head] = index + offsets[d];
+                reached++;
+            }
+            else if ((nx > 0) && (ny > 0) && (nx < width - 1) && (ny < height - 1)) queue[(head + count)%cellCount] = index + offsets[d];
+            else continue;
+
+            from[index + offsets[d]] = (unsigned char)(d + 1);
+            count++;
+        }
+    }
+
+    // Walkable cells not reached are enclosed by border walls: components are counted again
+    if (reached < walkable)
+    {
+        runCount = AnalyzerLabelRuns(analyzer, *grid, start, end, &startRun, &endRun);
+        for (int i = 0; i < runCount; i++) if (analyzer->parent[i] == i) analyzer->unconnected++;
+        analyzer->unconnected = (runCount < 0)? components - 1 : analyzer->unconnected - 1;
+    }
+
+    return removed;
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+// Resize context buffers if required
+static bool AnalyzerReset(MazeAnalyzer *analyzer, int width, int height)
+{
+    if ((width <= 0) || (height <= 0)) return false;
+    if ((analyzer->width == width) && (analyzer->height == height) && (analyzer->traced != NULL)) return true;
+
+    size_t wordCount = (size_t)((width + 63)/64)*height;
+
+    MAZE_FREE(analyzer->rows[0]);
+    MAZE_FREE(analyzer->rows[1]);
+    MAZE_FREE(analyzer->traced);
+    MAZE_FREE(analyzer->queue);
+    MAZE_FREE(analyzer->from);
+    UnloadFlowField(analyzer->field);
+
+    analyzer->queue = NULL;
+    analyzer->from = NULL;
+
+    // Row runs: at most one run every two cells
+    analyzer->rows[0] = (int *)MAZE_MALLOC((size_t)(width/2 + 1)*3*sizeof(int));
+    analyzer->rows[1] = (int *)MAZE_MALLOC((size_t)(width/2 + 1)*3*sizeof(int));
+    analyzer->traced = (uint64_t *)MAZE_MALLOC(wordCount*sizeof(uint64_t));
+    analyzer->field = LoadFlowField(width, height);
+
+    if ((analyzer->rows[0] == NULL) || (analyzer->rows[1] == NULL) || (analyzer->traced == NULL) || (analyzer->field.distance == NULL))
+    {
+        UnloadMazeAnalyzer(*analyzer);
+        *analyzer = (MazeAnalyzer){ 0 };
+        return false;
+    }
+
+    analyzer->width = width;
+    analyzer->height = height;
+
+    return true;
+}
+
+// Join walkable runs into components, returns runs count (-1 on failure)
+// NOTE: Runs are extracted from row words, previous row runs overlapping a run (same columns) are joined,
+// start and exit cells runs are returned (-1 if cell is a wall)
+static int AnalyzerLabelRuns(MazeAnalyzer *analyzer, MazeGrid grid, Point start, Point end, int *startRun, int *endRun)
+{
+    int runCount = 0;
+    int previousCount = 0;
+
+    for (int y = 0; y < grid.height; y++)
+    {
+        int *previous = analyzer->rows[y & 1];
+        int *current = analyzer->rows[(y + 1) & 1];
+        int currentCount = 0;
+        int p = 0;
+
+        for (int x0 = AnalysisNextCell(grid, y, 0, true); x0 < grid.width; )
+        {
+            int x1 = AnalysisNextCell(grid, y, x0, false);
+
+            if (!AnalyzerAddRun(analyzer, runCount, x1 - x0)) return -1;
+
+            // Previous row runs overlapping run (same columns) are joined
+            while ((p < previousCount) && (previous[p*3 + 1] <= x0)) p++;
+            for (int q = p; (q < previousCount) && (previous[q*3] < x1); q++) AnalyzerUnion(analyzer, runCount, previous[q*3 + 2]);
+
+            if ((y == start.y) && (start.x >= x0) && (start.x < x1)) *startRun = runCount;
+            if ((y == end.y) && (end.x >= x0) && (end.x < x1)) *endRun = runCount;
+
+            current[currentCount*3] = x0;
+            current[currentCount*3 + 1] = x1;
+            current[currentCount*3 + 2] = runCount;
+            currentCount++;
+            runCount++;
+
+            x0 = AnalysisNextCell(grid, y, x1, true);
+        }
+
+        previousCount = currentCount;
+    }
+
+    return runCount;
+}
+
+// Add run as a new component
+static bool AnalyzerAddRun(MazeAnalyzer *analyzer, int index, int cells)
+{
+    if (index >= analyzer->runCapacity)
+    {
+        int capacity = (analyzer->runCapacity > 0)? analyzer->runCapacity*2 : 4096;
+        int *parent = (int *)MAZE_REALLOC(analyzer->parent, (size_t)capacity*sizeof(int));
+        if (parent != NULL) analyzer->parent = parent;
+        int *size = (int *)MAZE_REALLOC(analyzer->size, (size_t)capacity*sizeof(int));
+        if (size != NULL) analyzer->size = size;
+
+        if ((parent == NULL) || (size == NULL)) return false;
+
+        analyzer->runCapacity = capacity;
+    }
+
+    analyzer->parent[index] = index;
+    analyzer->size[index] = cells;
+
+    return true;
+}
+
+// Get run component root (path halving)
+static int AnalyzerFind(MazeAnalyzer *analyzer, int run)
+{
+    while (analyzer->parent[run] != run)
+    {
+        analyzer->parent[run] = analyzer->parent[analyzer->parent[run]];
+        run = analyzer->parent[run];
+    }
+
+    return run;
+}
+
+// Join runs components (union by size)
+static void AnalyzerUnion(MazeAnalyzer *analyzer, int a, int b)
+{
+    a = AnalyzerFind(analyzer, a);
+    b = AnalyzerFind(analyzer, b);
+
+    if (a == b) return;
+
+    if (analyzer->size[a] < analyzer->size[b]) { int temp = a; a = b; b = temp; }
+
+    analyzer->parent[b] = a;
+    analyzer->size[a] += analyzer->size[b];
+}
+
+// Trace corridor through cell, returns corridor cells
+// NOTE: Corridor cells have two walkable neighbours, both directions are followed until a cell
+// with other neighbours count (dead end or junction) or an already traced cell (closed loop)
+static int AnalyzerTraceCorridor(MazeAnalyzer *analyzer, MazeGrid grid, int x, int y)
+{
+    static const Point directions[4] = { { 0, -1 }, { 1, 0 }, { 0, 1 }, { -1, 0 } };
+
+    analyzer->traced[(size_t)y*grid.stride + (x >> 6)] |= 1ull << (x & 63);
+    int length = 1;
+
+    for (int d = 0; d < 4; d++)
+    {
+        Point previous = { x, y };
+        Point cell = { x + directions[d].x, y + directions[d].y };
+
+        if (IsMazeWall(grid, cell.x, cell.y)) continue;
+
+        while (AnalysisNeighbours(grid, cell.x, cell.y) == 2)
+        {
+            uint64_t *word = &analyzer->traced[(size_t)cell.y*grid.stride + (cell.x >> 6)];
+            if ((*word >> (cell.x & 63)) & 1) break;
+
+            *word |= 1ull << (cell.x & 63);
+            length++;
+
+            // Continue to the neighbour that is not the previous cell
+            Point next = cell;
+            for (int i = 0; i < 4; i++)
+            {
+                Point candidate = { cell.x + directions[i].x, cell.y + directions[i].y };
+
+                if (((candidate.x != previous.x) || (candidate.y != previous.y)) && !IsMazeWall(grid, candidate.x, candidate.y)) next = candidate;
+            }
+
+            previous = cell;
+            cell = next;
+        }
+    }
+
+    return length;
+}
+
+// Get row word walkable bits, cells out of the grid are walls
+static inline uint64_t AnalysisRowWord(MazeGrid grid, int y, int k)
+{
+    if ((y < 0) || (y >= grid.height) || (k < 0) || (k >= grid.stride)) return 0;
+
+    uint64_t word = ~GetMazeRow(grid, y)[k];
+    if ((k == (grid.stride - 1)) && ((grid.width & 63) != 0)) word &= ~(~0ull << (grid.width & 63));
+
+    return word;
+}
+
+// Get first walkable (or wall) cell x from x, width if none
+// NOTE: Row words are scanned 64 cells at once
+static inline int AnalysisNextCell(MazeGrid grid, int y, int x, bool walkable)
+{
+    if (x >= grid.width) return grid.width;
+
+    int k = x >> 6;
+    uint64_t word = walkable? AnalysisRowWord(grid, y, k) : ~AnalysisRowWord(grid, y, k);
+    word &= ~0ull << (x & 63);
+
+    while (word == 0)
+    {
+        if (++k >= grid.stride) return grid.width;
+        word = walkable? AnalysisRowWord(grid, y, k) : ~AnalysisRowWord(grid, y, k);
+    }
+
+    int next = k*64 + AnalysisLowestBit(word);
+
+    return (next < grid.width)? next : grid.width;
+}
+
+// Get cell walkable neighbours count
+static inline int AnalysisNeighbours(MazeGrid grid, int x, int y)
+{
+    return !IsMazeWall(grid, x, y - 1) + !IsMazeWall(grid, x + 1, y) + !IsMazeWall(grid, x, y + 1) + !IsMazeWall(grid, x - 1, y);
+}
+
+// Get index of lowest set bit (word must not be 0)
+static inline int AnalysisLowestBit(uint64_t word)
+{
+#if defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanForward64(&index, word);
+    return (int)index;
+#else
+    return __builtin_ctzll(word);
+#endif
+}
+
+// Get number of set bits
+static inline int AnalysisBitCount(uint64_t word)
+{
+#if defined(_MSC_VER)
+    return (int)__popcnt64(word);
+#else
+    return __builtin_popcountll(word);
+#endif
+}
+
+#endif // MAZE_IMPLEMENTATION
+
+#endif // MAZE_ANALYSIS_H
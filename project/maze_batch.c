@@ -0,0 +1,389 @@
+/*******************************************************************************************
+*
+*   raylib maze generator - headless batch generator
+*
+*   Generates a range of mazes (one per seed) using all available cores, no window,
+*   OpenGL context or audio device is required, every maze is written to disk
+*   as a 1-bit PBM image, directly from the bit-packed maze grid
+*
+*   Sweep mode: spacing rows, spacing cols and skip chance can be ranges, every configuration
+*   of the ranges generates the seeds range. Mazes are analyzed (maze_analysis.h, start cell
+*   (1, 1) to exit cell (width - 2, height - 2), as the game) and mazes missing the target
+*   metrics are rejected and generated again with another seed, statistics are reported per
+*   configuration (acceptance rate, components, solution length and dead ends)
+*
+*   Repair mode: interior walls are removed to connect walkable regions to start cell after
+*   generation (RepairMazeConnectivity()), so mazes never miss exit reachable or components targets
+*   and only length or dead ends targets require generating them again. Border walls are kept,
+*   regions only reachable through them (not generated, reported) are left unconnected
+*
+*   USAGE:
+*       maze_batch [options]
+*           -n <count>      Number of mazes to generate, per configuration (default: 1000)
+*           -s <seed>       First seed of the range, mazes use seeds [seed, seed + count) (default: 1)
+*           -w <width>      Maze width (default: 64)
+*           -h <height>     Maze height (default: 64)
+*           -r <rows>       Spacing rows, or range min,max (default: 3)
+*           -c <cols>       Spacing cols, or range min,max (default: 3)
+*           -k <chance>     Skip chance [0.0..1.0], or range min,max,step (default: 0.75)
+*           -e              Target: exit reachable from start
+*           -L <length>     Target: minimum solution length (exit reachable), in steps
+*           -D <count>      Target: minimum dead ends
+*           -M <count>      Target: maximum walkable components
+*           -A <attempts>   Seeds tried per maze before giving up on targets (default: 16)
+*           -f              Repair mazes: connect walkable regions to start cell (interior walls only)
+*           -t <threads>    Worker threads (default: number of logical processors)
+*           -o <dir>        Output directory, it must exist (default: current directory)
+*           -x              Do not write results, only measure generation
+*
+*   BUILD (Linux):
+*       gcc maze_batch.c -o maze_batch -O2 -lpthread
+*
+********************************************************************************************/
+
+#define MAZE_IMPLEMENTATION
+#include "maze.h"                       // Required for: GenMazeGrid(), ExportMazeGrid(), GetElapsedTime()
+#include "maze_path.h"                  // Required for: FlowField (maze_analysis.h)
+#include "maze_analysis.h"              // Required for: MazeAnalyzer, AnalyzeMaze(), RepairMazeConnectivity()
+
+#include <stdio.h>                      // Required for: printf(), snprintf(), sscanf()
+#include <stdlib.h>                     // Required for: atoi(), atof(), malloc(), free()
+#include <string.h>                     // Required for: strcmp()
+#include <threads.h>                    // Required for: thrd_create(), thrd_join()
+#include <stdatomic.h>                  // Required for: atomic_int, atomic_fetch_add()
+
+#define MAX_BATCH_THREADS   256
+#define MAX_BATCH_CONFIGS   4096        // Sweep configurations
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Sweep configuration statistics (accepted mazes)
+typedef struct BatchSweepStats {
+    atomic_int generated;               // Mazes generated (rejected included)
+    atomic_int accepted;                // Mazes meeting target metrics
+    atomic_llong components;            // Walkable components sum
+    atomic_llong solutionLength;        // Solution length sum (exit reachable)
+    atomic_int solved;                  // Mazes with exit reachable
+    atomic_llong deadEnds;              // Dead ends sum
+    atomic_int repaired;                // Mazes repaired (walls removed)
+    atomic_llong wallsRemoved;          // Walls removed sum (repaired mazes)
+} BatchSweepStats;
+
+// Batch configuration and shared work counters
+typedef struct BatchConfig {
+    int count;
+    unsigned int firstSeed;
+    int width;
+    int height;
+    int spacingRows[2];                 // Spacing rows range (min, max)
+    int spacingCols[2];                 // Spacing cols range (min, max)
+    float skipChance[3];                // Skip chance range (min, max, step)
+    const char *outputDir;
+    bool writeResults;
+
+    bool analyze;                       // Mazes are analyzed (sweep or targets)
+    bool targetReachable;               // Target: exit reachable
+    int targetLength;                   // Target: minimum solution length (0: none)
+    int targetDeadEnds;                 // Target: minimum dead ends (0: none)
+    int targetComponents;               // Target: maximum components (0: none)
+    int attempts;                       // Seeds tried per maze
+    bool repair;                        // Mazes are repaired after generation
+
+    int rowsCount;                      // Sweep spacing rows values
+    int colsCount;                      // Sweep spacing cols values
+    int skipCount;                      // Sweep skip chance values
+    int configCount;                    // Sweep configurations
+    BatchSweepStats *stats;             // Statistics per configuration
+
+    atomic_int nextIndex;               // Next maze index to be taken by a worker
+    atomic_int generated;               // Mazes generated
+    atomic_int failed;                  // Mazes that could not be generated or written
+    atomic_int rejected;                // Mazes that missed targets on every attempt
+    atomic_int unconnected;             // Repaired mazes with regions left unconnected (enclosed by border walls)
+} BatchConfig;
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static int BatchWorker(void *arg);      // Worker thread: take maze indices until the range is done
+static bool CheckBatchTargets(BatchConfig *config, MazeAnalysis analysis);     // Check maze analysis meets target metrics
+static void GetBatchSweepConfig(BatchConfig *config, int sweep, int *spacingRows, int *spacingCols, float *skipChance);    // Get sweep configuration parameters
+
+//----------------------------------------------------------------------------------
+// Main entry point
+//----------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    static BatchConfig config = { 0 };
+    config.count = 1000;
+    config.firstSeed = 1;
+    config.width = 64;
+    config.height = 64;
+    config.spacingRows[0] = config.spacingRows[1] = 3;
+    config.spacingCols[0] = config.spacingCols[1] = 3;
+    config.skipChance[0] = config.skipChance[1] = 0.75f;
+    config.skipChance[2] = 0.05f;
+    config.outputDir = ".";
+    config.writeResults = true;
+    config.attempts = 16;
+
+    int threadCount = GetProcessorCount();
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = (i + 1 < argc);
+
+        if ((strcmp(argv[i], "-n") == 0) && hasValue) config.count = atoi(argv[++i]);
+        else if ((strcmp(argv[i], "-s") == 0) && hasValue) config.firstSeed = (unsigned int)strtoul(argv[++i], NULL, 10);
+        else if ((strcmp(argv[i], "-w") == 0) && hasValue) config.width = atoi(argv[++i]);
+        else if ((strcmp(argv[i], "-h") == 0) && hasValue) config.height = atoi(argv[++i]);
+        else if ((strcmp(argv[i], "-r") == 0) && hasValue)
+        {
+            if (sscanf(argv[++i], "%i,%i", &config.spacingRows[0], &config.spacingRows[1]) < 2) config.spacingRows[1] = config.spacingRows[0];
+        }
+        else if ((strcmp(argv[i], "-c") == 0) && hasValue)
+        {
+            if (sscanf(argv[++i], "%i,%i", &config.spacingCols[0], &config.spacingCols[1]) < 2) config.spacingCols[1] = config.spacingCols[0];
+        }
+        else if ((strcmp(argv[i], "-k") == 0) && hasValue)
+        {
+            if (sscanf(argv[++i], "%f,%f,%f", &config.skipChance[0], &config.skipChance[1], &config.skipChance[2]) < 2) config.skipChance[1] = config.skipChance[0];
+        }
+        else if (strcmp(argv[i], "-e") == 0) config.targetReachable = true;
+        else if ((strcmp(argv[i], "-L") == 0) && hasValue) config.targetLength = atoi(argv[++i]);
+        else if ((strcmp(argv[i], "-D") == 0) && hasValue) config.targetDeadEnds = atoi(argv[++i]);
+        else if ((strcmp(argv[i], "-M") == 0) && hasValue) config.targetComponents = atoi(argv[++i]);
+        else if ((strcmp(argv[i], "-A") == 0) && hasValue) config.attempts = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-f") == 0) config.repair = true;
+        else if ((strcmp(argv[i], "-t") == 0) && hasValue) threadCount = atoi(argv[++i]);
+        else if ((strcmp(argv[i], "-o") == 0) && hasValue) config.outputDir = argv[++i];
+        else if (strcmp(argv[i], "-x") == 0) config.writeResults = false;
+        else
+        {
+            printf("USAGE: %s [-n count] [-s seed] [-w width] [-h height] [-r rows[,max]] [-c cols[,max]] [-k skipChance[,max,step]]\n"
+                "       [-e] [-L length] [-D deadEnds] [-M components] [-A attempts] [-f] [-t threads] [-o dir] [-x]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if ((config.count <= 0) || (config.width < 3) || (config.height < 3) || (config.spacingRows[0] < 1) || (config.spacingCols[0] < 1) ||
+        (config.spacingRows[1] < config.spacingRows[0]) || (config.spacingCols[1] < config.spacingCols[0]) ||
+        (config.skipChance[1] < config.skipChance[0]) || (config.skipChance[2] <= 0.0f) || (config.attempts < 1))
+    {
+        printf("ERROR: Invalid batch parameters\n");
+        return 1;
+    }
+
+    config.rowsCount = config.spacingRows[1] - config.spacingRows[0] + 1;
+    config.colsCount = config.spacingCols[1] - config.spacingCols[0] + 1;
+    config.skipCount = (int)((config.skipChance[1] - config.skipChance[0])/config.skipChance[2] + 1.001f);
+    config.configCount = config.rowsCount*config.colsCount*config.skipCount;
+
+    if ((config.configCount > MAX_BATCH_CONFIGS) || ((long long)config.configCount*config.count > 0x7fffffff))
+    {
+        printf("ERROR: Too many sweep configurations or mazes\n");
+        return 1;
+    }
+
+    config.analyze = (config.configCount > 1) || config.targetReachable || (config.targetLength > 0) || (config.targetDeadEnds > 0) || (config.targetComponents > 0);
+    config.stats = (BatchSweepStats *)calloc((size_t)config.configCount, sizeof(BatchSweepStats));
+
+    if (config.stats == NULL)
+    {
+        printf("ERROR: Failed to allocate sweep statistics\n");
+        return 1;
+    }
+
+    int total = config.configCount*config.count;
+
+    if (threadCount < 1) threadCount = 1;
+    if (threadCount > MAX_BATCH_THREADS) threadCount = MAX_BATCH_THREADS;
+    if (threadCount > total) threadCount = total;
+
+    if (config.configCount > 1) printf("Sweeping %i configurations (rows [%i, %i], cols [%i, %i], skip chance [%.2f, %.2f] step %.2f)\n", config.configCount,
+        config.spacingRows[0], config.spacingRows[1], config.spacingCols[0], config.spacingCols[1], config.skipChance[0], config.skipChance[1], config.skipChance[2]);
+
+    printf("Generating %i mazes (%ix%i) for seeds [%u, %u] using %i threads\n", total, config.width, config.height,
+        config.firstSeed, config.firstSeed + (unsigned int)config.count - 1, threadCount);
+
+    double startTime = GetElapsedTime();
+
+    thrd_t threads[MAX_BATCH_THREADS] = { 0 };
+    for (int i = 0; i < threadCount; i++) thrd_create(&threads[i], BatchWorker, &config);
+    for (int i = 0; i < threadCount; i++) thrd_join(threads[i], NULL);
+
+    double elapsed = GetElapsedTime() - startTime;
+    int generated = atomic_load(&config.generated);
+
+    if (config.analyze)
+    {
+        printf("  rows  cols  skip   accepted  components  exit reachable  solution length  dead ends  repaired  walls removed\n");
+
+        int accepted = 0;
+
+        for (int i = 0; i < config.configCount; i++)
+        {
+            BatchSweepStats *stats = &config.stats[i];
+            int spacingRows = 0, spacingCols = 0;
+            float skipChance = 0.0f;
+            GetBatchSweepConfig(&config, i, &spacingRows, &spacingCols, &skipChance);
+
+            int statsAccepted = atomic_load(&stats->accepted);
+            int statsGenerated = atomic_load(&stats->generated);
+            int statsSolved = atomic_load(&stats->solved);
+            int statsRepaired = atomic_load(&stats->repaired);
+            accepted += statsAccepted;
+
+            printf("  %4i  %4i  %.2f  %6.1f%%  %10.1f  %13.1f%%  %15.1f  %9.1f  %7.1f%%  %13.1f\n", spacingRows, spacingCols, skipChance,
+                (statsGenerated > 0)? 100.0f*statsAccepted/statsGenerated : 0.0f,
+                (statsAccepted > 0)? (float)atomic_load(&stats->components)/statsAccepted : 0.0f,
+                (statsAccepted > 0)? 100.0f*statsSolved/statsAccepted : 0.0f,
+                (statsSolved > 0)? (float)atomic_load(&stats->solutionLength)/statsSolved : 0.0f,
+                (statsAccepted > 0)? (float)atomic_load(&stats->deadEnds)/statsAccepted : 0.0f,
+                (statsGenerated > 0)? 100.0f*statsRepaired/statsGenerated : 0.0f,
+                (statsRepaired > 0)? (float)atomic_load(&stats->wallsRemoved)/statsRepaired : 0.0f);
+        }
+
+        printf("Generated %i mazes in %.3f s: %.1f mazes/sec, %i accepted (%.1f accepted mazes/sec)\n", generated, elapsed,
+            (elapsed > 0.0)? generated/elapsed : 0.0, accepted, (elapsed > 0.0)? accepted/elapsed : 0.0);
+    }
+    else printf("Generated %i mazes in %.3f s: %.1f mazes/sec\n", generated, elapsed, (elapsed > 0.0)? generated/elapsed : 0.0);
+
+    if (config.repair)
+    {
+        int repaired = 0;
+        long long wallsRemoved = 0;
+
+        for (int i = 0; i < config.configCount; i++)
+        {
+            repaired += atomic_load(&config.stats[i].repaired);
+            wallsRemoved += atomic_load(&config.stats[i].wallsRemoved);
+        }
+
+        printf("Repaired %i mazes (%.1f%%), %.1f walls removed per repaired maze\n", repaired, (generated > 0)? 100.0*repaired/generated : 0.0,
+            (repaired > 0)? (double)wallsRemoved/repaired : 0.0);
+    }
+
+    if (atomic_load(&config.unconnected) > 0) printf("WARNING: %i repaired mazes have regions only reachable through border walls (left unconnected)\n", atomic_load(&config.unconnected));
+    if (atomic_load(&config.rejected) > 0) printf("WARNING: %i mazes missed targets after %i attempts (not written)\n", atomic_load(&config.rejected), config.attempts);
+    if (atomic_load(&config.failed) > 0) printf("WARNING: %i mazes could not be generated or written\n", atomic_load(&config.failed));
+
+    free(config.stats);
+
+    return (atomic_load(&config.failed) > 0)? 1 : 0;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Worker thread: take maze indices until the range is done
+// NOTE: Maze index selects sweep configuration (index/count) and seed (index%count),
+// rejected mazes are generated again with seed + attempt*count (not used by other mazes)
+static int BatchWorker(void *arg)
+{
+    BatchConfig *config = (BatchConfig *)arg;
+    MazeAnalyzer analyzer = { 0 };
+    char fileName[512] = { 0 };
+    int total = config->configCount*config->count;
+
+    for (int index = atomic_fetch_add(&config->nextIndex, 1); index < total; index = atomic_fetch_add(&config->nextIndex, 1))
+    {
+        int sweep = index/config->count;
+        int spacingRows = 0, spacingCols = 0;
+        float skipChance = 0.0f;
+        GetBatchSweepConfig(config, sweep, &spacingRows, &spacingCols, &skipChance);
+
+        BatchSweepStats *stats = &config->stats[sweep];
+        unsigned int seed = 0;
+        MazeGrid grid = { 0 };
+        bool rejected = false;
+
+        for (int attempt = 0; attempt < config->attempts; attempt++)
+        {
+            seed = config->firstSeed + (unsigned int)(index%config->count) + (unsigned int)attempt*(unsigned int)config->count;
+            grid = GenMazeGrid(config->width, config->height, spacingRows, spacingCols, skipChance, seed);
+
+            if (grid.cells == NULL)
+            {
+                rejected = false;
+                break;
+            }
+
+            atomic_fetch_add(&config->generated, 1);
+            atomic_fetch_add(&stats->generated, 1);
+
+            if (config->repair)
+            {
+                int removed = RepairMazeConnectivity(&analyzer, &grid, (Point){ 1, 1 }, (Point){ grid.width - 2, grid.height - 2 });
+                if (analyzer.unconnected > 0) atomic_fetch_add(&config->unconnected, 1);
+
+                if (removed > 0)
+                {
+                    atomic_fetch_add(&stats->repaired, 1);
+                    atomic_fetch_add(&stats->wallsRemoved, removed);
+                }
+            }
+
+            if (!config->analyze) break;
+
+            MazeAnalysis analysis = AnalyzeMaze(&analyzer, grid, (Point){ 1, 1 }, (Point){ grid.width - 2, grid.height - 2 });
+
+            if (CheckBatchTargets(config, analysis))
+            {
+                atomic_fetch_add(&stats->accepted, 1);
+                atomic_fetch_add(&stats->components, analysis.components);
+                atomic_fetch_add(&stats->deadEnds, analysis.deadEnds);
+
+                if (analysis.exitReachable)
+                {
+                    atomic_fetch_add(&stats->solved, 1);
+                    atomic_fetch_add(&stats->solutionLength, analysis.solutionLength);
+                }
+                break;
+            }
+
+            UnloadMazeGrid(grid);
+            grid = (MazeGrid){ 0 };
+            rejected = true;
+        }
+
+        if (grid.cells == NULL)
+        {
+            if (rejected) atomic_fetch_add(&config->rejected, 1);
+            else atomic_fetch_add(&config->failed, 1);
+        }
+        else if (config->writeResults)
+        {
+            if (config->configCount > 1) snprintf(fileName, sizeof(fileName), "%s/maze_r%i_c%i_k%.2f_%010u.pbm", config->outputDir, spacingRows, spacingCols, skipChance, seed);
+            else snprintf(fileName, sizeof(fileName), "%s/maze_%010u.pbm", config->outputDir, seed);
+
+            if (!ExportMazeGrid(grid, fileName)) atomic_fetch_add(&config->failed, 1);
+        }
+
+        UnloadMazeGrid(grid);
+    }
+
+    UnloadMazeAnalyzer(analyzer);
+
+    return 0;
+}
+
+// Check maze analysis meets target metrics
+static bool CheckBatchTargets(BatchConfig *config, MazeAnalysis analysis)
+{
+    if ((config->targetReachable || (config->targetLength > 0)) && !analysis.exitReachable) return false;
+    if ((config->targetLength > 0) && (analysis.solutionLength < config->targetLength)) return false;
+    if ((config->targetDeadEnds > 0) && (analysis.deadEnds < config->targetDeadEnds)) return false;
+    if ((config->targetComponents > 0) && (analysis.components > config->targetComponents)) return false;
+
+    return true;
+}
+
+// Get sweep configuration parameters
+static void GetBatchSweepConfig(BatchConfig *config, int sweep, int *spacingRows, int *spacingCols, float *skipChance)
+{
+    *skipChance = config->skipChance[0] + config->skipChance[2]*(sweep%config->skipCount);
+    *spacingCols = config->spacingCols[0] + (sweep/config->skipCount)%config->colsCount;
+    *spacingRows = config->spacingRows[0] + sweep/(config->skipCount*config->colsCount);
+}
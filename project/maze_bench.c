@@ -0,0 +1,912 @@
+/*******************************************************************************************
+*
+*   raylib maze generator - headless benchmark
+*
+*   Measures the maze algorithms on GenMazeGrid() output, no window, OpenGL context
+*   or audio device is required
+*
+*   USAGE:
+*       maze_bench path [options]       Compare A* and Jump Point Search, nodes expanded and
+*                                       time per solve, for several spacingRows/spacingCols/skipChance
+*           -w <width>      Maze width (default: 256)
+*           -h <height>     Maze height (default: 256)
+*           -n <count>      Mazes per configuration (default: 20)
+*           -s <seed>       First seed (default: 1)
+*
+*       maze_bench flow [options]       Compare flow field computation (word-parallel BFS, single and
+*                                       multi-threaded) against a scalar BFS, and incremental cell updates
+*                                       against full recomputation, same options than path
+*           -t <threads>    Threads for multi-threaded computation (default: number of logical processors)
+*
+*       maze_bench gen [options]        Compare generation algorithms, cells/sec and peak memory (grid
+*                                       included) for square mazes from 64x64 to 16384x16384, perfect
+*                                       algorithms are checked first on odd and even sizes (one path
+*                                       between any two cells: adjacencies = walkable cells - 1, all reached)
+*           -m <size>       Biggest maze size (default: 16384)
+*           -n <count>      Mazes of 256x256 cells per size, scaled by maze cells (default: 20, min 1 per size)
+*           -s <seed>       First seed (default: 1)
+*           -t <threads>    Threads for multi-threaded grid generation (default: number of logical processors)
+*
+*       maze_bench hot [options]        Hot paths regression suite with fixed seeds: grid generation (sizes,
+*                                       spacing and skipChance), A* worst cases, 2D/3D collision checks and
+*                                       3D model meshes (greedy mesher, only if built with BENCH_MESH),
+*                                       level file loading (raw and RLE grid, file in disk cache),
+*                                       median and minimum time of repetitions after warmup
+*           -r <count>      Measured repetitions per case (default: 7)
+*           -u <count>      Warmup repetitions per case (default: 2)
+*           -o <file>       Write results as JSON
+*           -b <file>       Compare against baseline results (JSON written with -o), exit code 2 on regression
+*           -x <percent>    Regression threshold, median slower than baseline (default: 10)
+*           -s <seed>       Seed of all cases (default: 1)
+*
+*   BUILD (Linux):
+*       gcc maze_bench.c -o maze_bench -O2 -lm -lpthread
+*       gcc maze_bench.c -o maze_bench -O2 -DBENCH_MESH -lraylib -lm -lpthread     (meshes cases, no GPU used)
+*
+********************************************************************************************/
+
+#include <stdio.h>                      // Required for: printf(), remove()
+#include <stdlib.h>                     // Required for: atoi(), strtoul(), malloc(), free()
+#include <string.h>                     // Required for: strcmp(), memcmp(), memset()
+#include <stdbool.h>                    // Required for: bool
+#include <stdatomic.h>                  // Required for: atomic_size_t
+#include <stdarg.h>                     // Required for: va_list, va_start(), va_end()
+
+// Maze modules allocations are tracked to measure peak memory
+#define MAZE_MALLOC(sz)         BenchAlloc(sz, false)
+#define MAZE_CALLOC(n,sz)       BenchAlloc((n)*(sz), true)
+#define MAZE_REALLOC(ptr,sz)    BenchRealloc(ptr, sz)
+#define MAZE_FREE(ptr)          BenchFree(ptr)
+
+static void *BenchAlloc(size_t size, bool clear);   // Allocate tracked memory block
+static void *BenchRealloc(void *ptr, size_t size);  // Reallocate tracked memory block
+static void BenchFree(void *ptr);                   // Free tracked memory block
+
+#define MAZE_IMPLEMENTATION
+#include "maze.h"                       // Required for: GenMazeGrid(), GenMazeGridEx(), GetElapsedTime()
+#include "maze_path.h"                  // Required for: PathFinder, FindPath(), FlowField
+#include "maze_gen.h"                   // Required for: GenMazeGridAlgorithm()
+#include "maze_file.h"                  // Required for: ExportMazeLevel(), LoadMazePack()
+#if defined(BENCH_MESH)
+    #include "maze_mesh.h"              // Required for: GenMeshMazeData()
+#endif
+
+#define BENCH_ALLOC_HEADER      16      // Tracked allocation header (block size), keeps alignment
+#define BENCH_MAX_RESULTS       64      // Maximum hot paths suite results
+#define BENCH_MAX_REPETITIONS   100     // Maximum measured repetitions per case
+#define BENCH_COLLISION_CHECKS  65536   // Collision checks per collision case repetition
+#define BENCH_FILE_SIZE         16384   // Level file cases maze size (limited by -m)
+#define BENCH_FILE_NAME         "maze_bench_level.mzl"  // Level file cases file, removed after cases
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Benchmark options
+typedef struct BenchConfig {
+    int width;
+    int height;
+    int count;
+    unsigned int firstSeed;
+    int threadCount;
+    int maxSize;
+    int repetitions;
+    int warmup;
+    float threshold;
+    const char *outputFile;
+    const char *baselineFile;
+} BenchConfig;
+
+// Hot paths suite result
+typedef struct BenchResult {
+    char name[48];              // Case name
+    double median;              // Median time per repetition (ms)
+    double min;                 // Minimum time per repetition (ms)
+} BenchResult;
+
+// Hot paths suite, results of all cases
+typedef struct BenchSuite {
+    BenchConfig config;
+    BenchResult results[BENCH_MAX_RESULTS];
+    int resultCount;
+} BenchSuite;
+
+// Run case once, returns time (seconds)
+typedef double (*BenchCaseFunc)(void *data);
+
+// Grid generation case
+typedef struct BenchGenCase {
+    int size;
+    int spacing;
+    float skipChance;
+    unsigned int seed;
+} BenchGenCase;
+
+// A* case
+typedef struct BenchPathCase {
+    MazeGrid grid;
+    PathFinder *finder;
+    Point start;
+    Point end;
+    bool allocate;              // Use LoadPathAStar() (allocates path) instead of reused finder
+} BenchPathCase;
+
+// Collision checks case
+typedef struct BenchCollisionCase {
+    MazeGrid grid;
+    float *positions;           // Check positions (x, y), BENCH_COLLISION_CHECKS
+    bool step;                  // Check 3D point step instead of 2D square
+    int collisions;             // Collisions found by last run
+} BenchCollisionCase;
+
+// Level file case
+typedef struct BenchFileCase {
+    const char *fileName;       // Level file (single level pack)
+    int cellsRead;              // Walkable cells in middle row found by last run
+} BenchFileCase;
+
+#if defined(BENCH_MESH)
+// Model meshes case
+typedef struct BenchMeshCase {
+    MazeGrid grid;
+    int chunkSize;
+} BenchMeshCase;
+#endif
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static atomic_size_t allocatedBytes = 0;        // Bytes currently allocated by maze modules
+static atomic_size_t peakBytes = 0;             // Peak bytes allocated since last reset
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static void BenchPath(BenchConfig config);      // Compare A* and JPS on generated mazes
+static void BenchFlow(BenchConfig config);      // Compare flow field computation and updates
+static void BenchGen(BenchConfig config);       // Compare generation algorithms
+static int BenchHot(BenchConfig config);        // Hot paths regression suite, returns exit code
+static void BenchRunCase(BenchSuite *suite, const char *name, BenchCaseFunc run, void *data);  // Run case repetitions and add result
+static bool BenchExportResults(const BenchSuite *suite, const char *fileName);     // Write suite results as JSON
+static int BenchCompareBaseline(const BenchSuite *suite, const char *fileName);    // Compare suite results against baseline results file
+static int BenchCompareTimes(const void *a, const void *b);        // Compare times (qsort)
+static const char *BenchFormat(const char *format, ...);           // Format case name, static buffer
+static double BenchGenRun(void *data);          // Grid generation case
+static double BenchPathRun(void *data);         // A* case
+static double BenchCollisionRun(void *data);    // Collision checks case
+static double BenchFileRun(void *data);         // Level file loading case
+#if defined(BENCH_MESH)
+static double BenchMeshRun(void *data);         // Model meshes case
+#endif
+static void BenchTrackBytes(size_t freed, size_t allocated);   // Track allocated bytes change
+static int BenchScalarBFS(MazeGrid grid, Point goal, int *distance, int *queue);   // Reference distance field, scalar BFS
+static bool BenchCheckPerfect(MazeGrid grid, int *distance, int *queue);   // Check maze is perfect (walkable cells form a tree)
+
+//----------------------------------------------------------------------------------
+// Main entry point
+//----------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    BenchConfig config = { 256, 256, 20, 1, 0, 16384, 7, 2, 10.0f, NULL, NULL };
+    const char *suite = (argc > 1)? argv[1] : "";
+
+    for (int i = 2; i < argc; i++)
+    {
+        bool hasValue = (i + 1 < argc);
+
+        if ((strcmp(argv[i], "-w") == 0) && hasValue) config.width = atoi(argv[++i]);
+        else if ((strcmp(argv[i], "-h") == 0) && hasValue) config.height = atoi(argv[++i]);
+        else if ((strcmp(argv[i], "-n") == 0) && hasValue) config.count = atoi(argv[++i]);
+        else if ((strcmp(argv[i], "-s") == 0) && hasValue) config.firstSeed = (unsigned int)strtoul(argv[++i], NULL, 10);
+        else if ((strcmp(argv[i], "-t") == 0) && hasValue) config.threadCount = atoi(argv[++i]);
+        else if ((strcmp(argv[i], "-m") == 0) && hasValue) config.maxSize = atoi(argv[++i]);
+        else if ((strcmp(argv[i], "-r") == 0) && hasValue) config.repetitions = atoi(argv[++i]);
+        else if ((strcmp(argv[i], "-u") == 0) && hasValue) config.warmup = atoi(argv[++i]);
+        else if ((strcmp(argv[i], "-x") == 0) && hasValue) config.threshold = (float)atof(argv[++i]);
+        else if ((strcmp(argv[i], "-o") == 0) && hasValue) config.outputFile = argv[++i];
+        else if ((strcmp(argv[i], "-b") == 0) && hasValue) config.baselineFile = argv[++i];
+        else suite = "";
+    }
+
+    if ((config.width < 5) || (config.height < 5) || (config.count < 1)) suite = "";
+    if ((config.repetitions < 1) || (config.repetitions > BENCH_MAX_REPETITIONS) || (config.warmup < 0)) suite = "";
+
+    if (strcmp(suite, "path") == 0) BenchPath(config);
+    else if (strcmp(suite, "flow") == 0) BenchFlow(config);
+    else if (strcmp(suite, "gen") == 0) BenchGen(config);
+    else if (strcmp(suite, "hot") == 0) return BenchHot(config);
+    else
+    {
+        printf("USAGE: %s path|flow|gen|hot [-w width] [-h height] [-n count] [-s seed] [-t threads] [-m size]\n", argv[0]);
+        printf("       %s hot [-r repetitions] [-u warmup] [-o results.json] [-b baseline.json] [-x percent]\n", argv[0]);
+        return 1;
+    }
+
+    return 0;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Compare A* and JPS on generated mazes
+// NOTE: Every maze is solved from top-left to bottom-right corner, both cells are cleared
+static void BenchPath(BenchConfig config)
+{
+    const int spacings[] = { 2, 3, 4, 6 };
+    const float skipChances[] = { 0.5f, 0.75f, 0.9f };
+    const char *algorithmNames[] = { "A*", "JPS" };
+
+    PathFinder finder = LoadPathFinder(config.width, config.height);
+    Point start = { 1, 1 };
+    Point end = { config.width - 2, config.height - 2 };
+
+    printf("Path benchmark: %ix%i mazes, %i per configuration\n\n", config.width, config.height, config.count);
+    printf("%-8s %-8s %-6s %-10s %-10s %-10s %-8s\n", "spacing", "skip", "algo", "expanded", "ms/solve", "length", "speedup");
+
+    for (int s = 0; s < (int)(sizeof(spacings)/sizeof(spacings[0])); s++)
+    {
+        for (int k = 0; k < (int)(sizeof(skipChances)/sizeof(skipChances[0])); k++)
+        {
+            double time[2] = { 0 };
+            double expanded[2] = { 0 };
+            double length[2] = { 0 };
+            int solved = 0;
+
+            for (int i = 0; i < config.count; i++)
+            {
+                MazeGrid grid = GenMazeGrid(config.width, config.height, spacings[s], spacings[s], skipChances[k], config.firstSeed + (unsigned int)i);
+                SetMazeWall(&grid, start.x, start.y, false);
+                SetMazeWall(&grid, end.x, end.y, false);
+
+                for (int a = 0; a < 2; a++)
+                {
+                    int pointCount = 0;
+                    double startTime = GetElapsedTime();
+                    const Point *path = FindPath(&finder, grid, start, end, a, &pointCount);
+                    time[a] += GetElapsedTime() - startTime;
+                    expanded[a] += finder.expanded;
+                    length[a] += pointCount;
+
+                    if ((a == 0) && (path != NULL)) solved++;
+                }
+
+                UnloadMazeGrid(grid);
+            }
+
+            for (int a = 0; a < 2; a++)
+            {
+                printf("%ix%-6i %-8.2f %-6s %-10.0f %-10.4f %-10.1f ", spacings[s], spacings[s], skipChances[k], algorithmNames[a],
+                    expanded[a]/config.count, time[a]*1000.0/config.count, length[a]/config.count);
+
+                if (a == 0) printf("%-8s\n", "-");
+                else printf("%.2fx\n", (time[a] > 0.0)? time[0]/time[a] : 0.0);
+            }
+
+            if (solved < config.count) printf("    (%i of %i mazes not solvable)\n", config.count - solved, config.count);
+        }
+    }
+
+    UnloadPathFinder(finder);
+}
+
+// Compare flow field computation and updates
+// NOTE: Goal is bottom-right corner, every field is verified against the scalar BFS,
+// updates toggle random cells and are verified after the last one
+static void BenchFlow(BenchConfig config)
+{
+    const int spacings[] = { 2, 3, 4, 6 };
+    const float skipChances[] = { 0.5f, 0.75f, 0.9f };
+    const int updateCount = 100;
+
+    int threadCount = (config.threadCount > 0)? config.threadCount : GetProcessorCount();
+    size_t cellCount = (size_t)config.width*config.height;
+    int *distance = (int *)malloc(cellCount*sizeof(int));
+    int *queue = (int *)malloc(cellCount*sizeof(int));
+    FlowField field = LoadFlowField(config.width, config.height);
+    Point goal = { config.width - 2, config.height - 2 };
+    int mismatches = 0;
+
+    if ((distance == NULL) || (queue == NULL) || (field.distance == NULL))
+    {
+        printf("ERROR: Flow benchmark memory could not be allocated\n");
+        free(distance);
+        free(queue);
+        UnloadFlowField(field);
+        return;
+    }
+
+    printf("Flow field benchmark: %ix%i mazes, %i per configuration, %i threads\n\n", config.width, config.height, config.count, threadCount);
+    printf("%-8s %-8s %-10s %-10s %-10s %-10s %-12s %-10s\n", "spacing", "skip", "reached", "bfs ms", "flow ms", "flowMT ms", "update ms", "cells/upd");
+
+    for (int s = 0; s < (int)(sizeof(spacings)/sizeof(spacings[0])); s++)
+    {
+        for (int k = 0; k < (int)(sizeof(skipChances)/sizeof(skipChances[0])); k++)
+        {
+            double time[4] = { 0 };
+            double reached = 0.0;
+            double updated = 0.0;
+
+            for (int i = 0; i < config.count; i++)
+            {
+                unsigned int seed = config.firstSeed + (unsigned int)i;
+                MazeGrid grid = GenMazeGrid(config.width, config.height, spacings[s], spacings[s], skipChances[k], seed);
+                SetMazeWall(&grid, goal.x, goal.y, false);
+
+                double startTime = GetElapsedTime();
+                reached += BenchScalarBFS(grid, goal, distance, queue);
+                time[0] += GetElapsedTime() - startTime;
+
+                startTime = GetElapsedTime();
+                ComputeFlowField(&field, grid, goal, 1);
+                time[1] += GetElapsedTime() - startTime;
+                if (memcmp(field.distance, distance, cellCount*sizeof(int)) != 0) mismatches++;
+
+                startTime = GetElapsedTime();
+                ComputeFlowField(&field, grid, goal, threadCount);
+                time[2] += GetElapsedTime() - startTime;
+                if (memcmp(field.distance, distance, cellCount*sizeof(int)) != 0) mismatches++;
+
+                // Toggle random inner cells (goal excluded), field is repaired after every change
+                unsigned int random = seed*2654435761u + 1;
+                for (int u = 0; u < updateCount; u++)
+                {
+                    random = random*1103515245u + 12345u;
+                    int x = 1 + (int)((random >> 8)%(unsigned int)(config.width - 2));
+                    random = random*1103515245u + 12345u;
+                    int y = 1 + (int)((random >> 8)%(unsigned int)(config.height - 2));
+                    if ((x == goal.x) && (y == goal.y)) continue;
+
+                    SetMazeWall(&grid, x, y, !IsMazeWall(grid, x, y));
+
+                    startTime = GetElapsedTime();
+                    UpdateFlowFieldCell(&field, grid, x, y);
+                    time[3] += GetElapsedTime() - startTime;
+                    updated += field.updated;
+                }
+
+                BenchScalarBFS(grid, goal, distance, queue);
+                if (memcmp(field.distance, distance, cellCount*sizeof(int)) != 0) mismatches++;
+
+                UnloadMazeGrid(grid);
+            }
+
+            printf("%ix%-6i %-8.2f %-10.0f %-10.3f %-10.3f %-10.3f %-12.5f %-10.1f\n", spacings[s], spacings[s], skipChances[k],
+                reached/config.count, time[0]*1000.0/config.count, time[1]*1000.0/config.count, time[2]*1000.0/config.count,
+                time[3]*1000.0/(config.count*updateCount), updated/(config.count*updateCount));
+        }
+    }
+
+    if (mismatches > 0) printf("\nERROR: %i flow fields differ from scalar BFS\n", mismatches);
+
+    free(distance);
+    free(queue);
+    UnloadFlowField(field);
+}
+
+// Compare generation algorithms
+// NOTE: Every algorithm runs on the same seeds, memory is the peak of maze modules allocations
+// during generation (grid included)
+static void BenchGen(BenchConfig config)
+{
+    int threadCount = (config.threadCount > 0)? config.threadCount : GetProcessorCount();
+
+    // Perfect algorithms check: odd, even and mixed sizes (even sizes add a column/row next to the border)
+    const int checkSizes[6][2] = { { 31, 31 }, { 32, 32 }, { 33, 64 }, { 64, 33 }, { 64, 64 }, { 5, 4 } };
+    int *distance = (int *)malloc(64*64*sizeof(int));
+    int *queue = (int *)malloc(64*64*sizeof(int));
+    int checked = 0;
+    int imperfect = 0;
+
+    for (int a = MAZE_GEN_KRUSKAL; (distance != NULL) && (queue != NULL) && (a <= MAZE_GEN_ELLER); a++)
+    {
+        for (int i = 0; i < 6; i++)
+        {
+            for (int seed = 0; seed < config.count; seed++)
+            {
+                MazeGrid grid = GenMazeGridAlgorithm(checkSizes[i][0], checkSizes[i][1], 4, 4, 0.75f, config.firstSeed + (unsigned int)seed, a);
+                if (grid.cells == NULL) continue;
+
+                checked++;
+                if (!BenchCheckPerfect(grid, distance, queue))
+                {
+                    if (imperfect == 0) printf("ERROR: %s %ix%i seed %u is not a perfect maze\n", GetMazeGenAlgorithmName(a), grid.width, grid.height, config.firstSeed + (unsigned int)seed);
+                    imperfect++;
+                }
+
+                UnloadMazeGrid(grid);
+            }
+        }
+    }
+
+    free(distance);
+    free(queue);
+
+    printf("Perfect mazes check: %i mazes, %i not perfect\n\n", checked, imperfect);
+
+    printf("Generation benchmark: 64x64 to %ix%i mazes, %i threads for grid MT\n\n", config.maxSize, config.maxSize, threadCount);
+    printf("%-8s %-12s %-8s %-12s %-10s %-10s %-10s\n", "size", "algorithm", "mazes", "Mcells/s", "ms/maze", "peak MB", "bytes/cell");
+
+    for (int size = 64; size <= config.maxSize; size *= 4)
+    {
+        double cellCount = (double)size*size;
+        int mazeCount = (int)((double)config.count*256*256/cellCount);
+        if (mazeCount < 1) mazeCount = 1;
+
+        // Grid generation also measured with several threads (last row)
+        for (int a = MAZE_GEN_GRID; a <= (MAZE_GEN_ELLER + 1); a++)
+        {
+            double time = 0.0;
+            size_t peak = 0;
+            bool failed = false;
+
+            for (int i = 0; i < mazeCount; i++)
+            {
+                unsigned int seed = config.firstSeed + (unsigned int)i;
+                atomic_store(&peakBytes, atomic_load(&allocatedBytes));
+
+                double startTime = GetElapsedTime();
+                MazeGrid grid = (a <= MAZE_GEN_ELLER)? GenMazeGridAlgorithm(size, size, 4, 4, 0.75f, seed, a) :
+                    GenMazeGridEx(size, size, 4, 4, 0.75f, seed, threadCount);
+                time += GetElapsedTime() - startTime;
+
+                if (atomic_load(&peakBytes) > peak) peak = atomic_load(&peakBytes);
+                if (grid.cells == NULL) failed = true;
+
+                UnloadMazeGrid(grid);
+                if (failed) break;
+            }
+
+            const char *name = (a <= MAZE_GEN_ELLER)? GetMazeGenAlgorithmName(a) : "grid MT";
+
+            if (failed) printf("%-8i %-12s ERROR: out of memory\n", size, name);
+            else printf("%-8i %-12s %-8i %-12.2f %-10.3f %-10.2f %-10.3f\n", size, name, mazeCount,
+                cellCount*mazeCount/time/1000000.0, time*1000.0/mazeCount, peak/(1024.0*1024.0), peak/cellCount);
+        }
+    }
+}
+
+// Hot paths regression suite, median of repetitions after warmup
+// NOTE: Every case uses fixed seeds, results can be saved (-o) and compared against a baseline (-b),
+// returns 2 if a case is slower than baseline by more than threshold
+static int BenchHot(BenchConfig config)
+{
+    static BenchSuite suite = { 0 };
+    suite.config = config;
+
+    printf("Hot paths benchmark: %i warmup, %i repetitions per case, seed %u\n\n", config.warmup, config.repetitions, config.firstSeed);
+    printf("%-36s %-14s %-14s\n", "case", "median ms", "min ms");
+
+    // Grid generation: sizes, spacing and skipChance
+    const int spacings[] = { 2, 3, 6 };
+    const float skipChances[] = { 0.5f, 0.75f, 0.9f };
+
+    for (int size = 256; (size <= 4096) && (size <= config.maxSize); size *= 4)
+    {
+        for (int s = 0; s < (int)(sizeof(spacings)/sizeof(spacings[0])); s++)
+        {
+            BenchGenCase genCase = { size, spacings[s], skipChances[s], config.firstSeed };
+            BenchRunCase(&suite, BenchFormat("gen/grid/%i/s%i/k%.2f", size, spacings[s], skipChances[s]), BenchGenRun, &genCase);
+        }
+    }
+
+    // A* worst cases: opposite corners and unreachable end (whole reachable region expanded)
+    MazeGrid grid = GenMazeGrid(512, 512, 3, 3, 0.75f, config.firstSeed);
+    PathFinder finder = LoadPathFinder(grid.width, grid.height);
+    Point corners[4] = { { 1, 1 }, { grid.width - 2, grid.height - 2 }, { grid.width - 2, 1 }, { 1, grid.height - 2 } };
+
+    for (int i = 0; i < 4; i++) SetMazeWall(&grid, corners[i].x, corners[i].y, false);
+
+    BenchPathCase pathCase = { grid, &finder, corners[0], corners[1], false };
+    BenchRunCase(&suite, "astar/512/corners", BenchPathRun, &pathCase);
+    pathCase = (BenchPathCase){ grid, &finder, corners[2], corners[3], false };
+    BenchRunCase(&suite, "astar/512/anti-diagonal", BenchPathRun, &pathCase);
+    pathCase = (BenchPathCase){ grid, &finder, corners[0], corners[1], true };
+    BenchRunCase(&suite, "astar-alloc/512/corners", BenchPathRun, &pathCase);
+
+    MazeGrid closed = LoadMazeGrid(grid.width, grid.height);
+    memcpy(closed.cells, grid.cells, (size_t)grid.stride*grid.height*sizeof(uint64_t));
+    SetMazeWall(&closed, corners[1].x - 1, corners[1].y, true);
+    SetMazeWall(&closed, corners[1].x, corners[1].y - 1, true);
+    pathCase = (BenchPathCase){ closed, &finder, corners[0], corners[1], false };
+    BenchRunCase(&suite, "astar/512/unreachable", BenchPathRun, &pathCase);
+
+    UnloadMazeGrid(closed);
+    UnloadPathFinder(finder);
+    UnloadMazeGrid(grid);
+
+    // Collision checks: 2D square moving along one axis and 3D point step, random positions
+    grid = GenMazeGrid(1024, 1024, 3, 3, 0.75f, config.firstSeed);
+    BenchCollisionCase collisionCase = { grid, (float *)malloc(BENCH_COLLISION_CHECKS*2*sizeof(float)), false, 0 };
+
+    if (collisionCase.positions != NULL)
+    {
+        unsigned int random = config.firstSeed*2654435761u + 1;
+        for (int i = 0; i < BENCH_COLLISION_CHECKS*2; i++)
+        {
+            random = random*1103515245u + 12345u;
+            collisionCase.positions[i] = 1.0f + (float)(random >> 8)/(float)(1 << 24)*(grid.width - 2);
+        }
+
+        BenchRunCase(&suite, BenchFormat("collision/box/%i", BENCH_COLLISION_CHECKS), BenchCollisionRun, &collisionCase);
+        collisionCase.step = true;
+        BenchRunCase(&suite, BenchFormat("collision/step/%i", BENCH_COLLISION_CHECKS), BenchCollisionRun, &collisionCase);
+    }
+
+    free(collisionCase.positions);
+    UnloadMazeGrid(grid);
+
+    // Level file loading: uncompressed grid is used from mapped file (zero-copy), RLE grid is decoded
+    int fileSize = (config.maxSize < BENCH_FILE_SIZE)? config.maxSize : BENCH_FILE_SIZE;
+    MazeLevel level = { 0 };
+    level.grid = GenMazeGridEx(fileSize, fileSize, 3, 3, 0.75f, config.firstSeed, 0);
+    level.start = (Point){ 1, 1 };
+    level.end = (Point){ fileSize - 2, fileSize - 2 };
+    BenchFileCase fileCase = { BENCH_FILE_NAME, 0 };
+
+    if (ExportMazeLevel(level, BENCH_FILE_NAME, MAZE_FILE_RAW)) BenchRunCase(&suite, BenchFormat("file/load/%i/raw", fileSize), BenchFileRun, &fileCase);
+    if (ExportMazeLevel(level, BENCH_FILE_NAME, MAZE_FILE_RLE)) BenchRunCase(&suite, BenchFormat("file/load/%i/rle", fileSize), BenchFileRun, &fileCase);
+
+    remove(BENCH_FILE_NAME);
+    UnloadMazeGrid(level.grid);
+
+#if defined(BENCH_MESH)
+    // 3D model meshes (greedy mesher, CPU only), full model of 32x32 cells chunks
+    for (int size = 256; size <= 512; size *= 2)
+    {
+        BenchMeshCase meshCase = { GenMazeGrid(size, size, 3, 3, 0.75f, config.firstSeed), 32 };
+        BenchRunCase(&suite, BenchFormat("mesh/greedy/%i", size), BenchMeshRun, &meshCase);
+        UnloadMazeGrid(meshCase.grid);
+    }
+#endif
+
+    if ((config.outputFile != NULL) && !BenchExportResults(&suite, config.outputFile))
+    {
+        printf("ERROR: Results could not be written to %s\n", config.outputFile);
+    }
+
+    return (config.baselineFile != NULL)? BenchCompareBaseline(&suite, config.baselineFile) : 0;
+}
+
+// Run case repetitions and add result, warmup repetitions are not measured
+static void BenchRunCase(BenchSuite *suite, const char *name, BenchCaseFunc run, void *data)
+{
+    double times[BENCH_MAX_REPETITIONS] = { 0 };
+    int repetitions = suite->config.repetitions;
+
+    for (int i = 0; i < suite->config.warmup; i++) run(data);
+    for (int i = 0; i < repetitions; i++) times[i] = run(data);
+
+    qsort(times, repetitions, sizeof(double), BenchCompareTimes);
+
+    double median = (repetitions%2 == 1)? times[repetitions/2] : (times[repetitions/2 - 1] + times[repetitions/2])/2.0;
+
+    printf("%-36s %-14.4f %-14.4f\n", name, median*1000.0, times[0]*1000.0);
+
+    if (suite->resultCount < BENCH_MAX_RESULTS)
+    {
+        BenchResult *result = &suite->results[suite->resultCount++];
+        snprintf(result->name, sizeof(result->name), "%s", name);
+        result->median = median*1000.0;
+        result->min = times[0]*1000.0;
+    }
+}
+
+// Write suite results as JSON, one result per line
+static bool BenchExportResults(const BenchSuite *suite, const char *fileName)
+{
+    FILE *file = fopen(fileName, "wt");
+
+    if (file == NULL) return false;
+
+    fprintf(file, "{\n    \"suite\": \"hot\",\n    \"seed\": %u,\n    \"repetitions\": %i,\n    \"results\": [\n",
+        suite->config.firstSeed, suite->config.repetitions);
+
+    for (int i = 0; i < suite->resultCount; i++)
+    {
+        fprintf(file, "        { \"name\": \"%s\", \"median_ms\": %.6f, \"min_ms\": %.6f }%s\n", suite->results[i].name,
+            suite->results[i].median, suite->results[i].min, (i < (suite->resultCount - 1))? "," : "");
+    }
+
+    fprintf(file, "    ]\n}\n");
+
+    return (fclose(file) == 0);
+}
+
+// Compare suite results against baseline results file, returns 2 if any case regressed
+// NOTE: Baseline is read line by line, as written by BenchExportResults(), medians are compared
+static int BenchCompareBaseline(const BenchSuite *suite, const char *fileName)
+{
+    FILE *file = fopen(fileName, "rt");
+
+    if (file == NULL)
+    {
+        printf("ERROR: Baseline %s could not be read\n", fileName);
+        return 1;
+    }
+
+    static BenchResult baseline[BENCH_MAX_RESULTS] = { 0 };
+    int baselineCount = 0;
+    char line[256] = { 0 };
+
+    while ((baselineCount < BENCH_MAX_RESULTS) && (fgets(line, sizeof(line), file) != NULL))
+    {
+        BenchResult *result = &baseline[baselineCount];
+        const char *name = strstr(line, "\"name\": \"");
+        const char *median = strstr(line, "\"median_ms\": ");
+
+        if ((name != NULL) && (median != NULL) && (sscanf(name + 9, "%47[^\"]", result->name) == 1))
+        {
+            result->median = atof(median + 13);
+            baselineCount++;
+        }
+    }
+
+    fclose(file);
+
+    printf("\nBaseline comparison: %s, regression threshold %.1f%%\n\n", fileName, suite->config.threshold);
+    printf("%-36s %-14s %-14s %-10s\n", "case", "baseline ms", "median ms", "change");
+
+    int regressions = 0;
+
+    for (int i = 0; i < suite->resultCount; i++)
+    {
+        const BenchResult *result = &suite->results[i];
+        const BenchResult *reference = NULL;
+
+        for (int j = 0; j < baselineCount; j++)
+        {
+            if (strcmp(baseline[j].name, result->name) == 0) reference = &baseline[j];
+        }
+
+        if ((reference == NULL) || (reference->median <= 0.0))
+        {
+            printf("%-36s %-14s %-14.4f %-10s\n", result->name, "-", result->median, "new");
+            continue;
+        }
+
+        double change = (result->median/reference->median - 1.0)*100.0;
+        bool regressed = (change > suite->config.threshold);
+        if (regressed) regressions++;
+
+        char changeText[16] = { 0 };
+        snprintf(changeText, sizeof(changeText), "%+.1f%%", change);
+
+        printf("%-36s %-14.4f %-14.4f %-10s%s\n", result->name, reference->median, result->median, changeText, regressed? " REGRESSION" : "");
+    }
+
+    if (regressions > 0) printf("\n%i of %i cases regressed\n", regressions, suite->resultCount);
+
+    return (regressions > 0)? 2 : 0;
+}
+
+// Compare times (qsort)
+static int BenchCompareTimes(const void *a, const void *b)
+{
+    double timeA = *(const double *)a;
+    double timeB = *(const double *)b;
+
+    return (timeA > timeB) - (timeA < timeB);
+}
+
+// Format case name, static buffer (valid until next call)
+static const char *BenchFormat(const char *format, ...)
+{
+    static char buffer[64] = { 0 };
+
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+
+    return buffer;
+}
+
+// Grid generation case: generate and unload one maze
+static double BenchGenRun(void *data)
+{
+    BenchGenCase *genCase = (BenchGenCase *)data;
+
+    double startTime = GetElapsedTime();
+    MazeGrid grid = GenMazeGrid(genCase->size, genCase->size, genCase->spacing, genCase->spacing, genCase->skipChance, genCase->seed);
+    UnloadMazeGrid(grid);
+
+    return GetElapsedTime() - startTime;
+}
+
+// A* case: one search, reusing search context or allocating path (LoadPathAStar())
+static double BenchPathRun(void *data)
+{
+    BenchPathCase *pathCase = (BenchPathCase *)data;
+    int pointCount = 0;
+
+    double startTime = GetElapsedTime();
+
+    if (pathCase->allocate) UnloadPath(LoadPathAStar(pathCase->grid, pathCase->start, pathCase->end, &pointCount));
+    else FindPath(pathCase->finder, pathCase->grid, pathCase->start, pathCase->end, PATH_ASTAR, &pointCount);
+
+    return GetElapsedTime() - startTime;
+}
+
+// Collision case: BENCH_COLLISION_CHECKS checks at random positions, directions cycled
+static double BenchCollisionRun(void *data)
+{
+    BenchCollisionCase *collisionCase = (BenchCollisionCase *)data;
+    const int direction[4][2] = { { 0, -1 }, { 0, 1 }, { -1, 0 }, { 1, 0 } };
+    const float *positions = collisionCase->positions;
+    int collisions = 0;
+
+    double startTime = GetElapsedTime();
+
+    if (collisionCase->step)
+    {
+        for (int i = 0; i < BENCH_COLLISION_CHECKS; i++)
+        {
+            collisions += CheckMazeCollisionStep(collisionCase->grid, positions[i*2], positions[i*2 + 1], direction[i & 3][0]*0.05f, direction[(i + 1) & 3][1]*0.05f);
+        }
+    }
+    else
+    {
+        for (int i = 0; i < BENCH_COLLISION_CHECKS; i++)
+        {
+            collisions += CheckMazeCollisionBox(collisionCase->grid, positions[i*2], positions[i*2 + 1], 0.45f, direction[i & 3][0], direction[i & 3][1]);
+        }
+    }
+
+    double time = GetElapsedTime() - startTime;
+
+    // Collisions count is kept so the checks are not optimized away
+    collisionCase->collisions = collisions;
+
+    return time;
+}
+
+// Level file case: load pack, get level and read its middle row, unload
+static double BenchFileRun(void *data)
+{
+    BenchFileCase *fileCase = (BenchFileCase *)data;
+    int cellsRead = 0;
+
+    double startTime = GetElapsedTime();
+
+    MazePack pack = LoadMazePack(fileCase->fileName);
+    MazeLevel level = GetMazePackLevel(pack, 0);
+
+    for (int x = 0; x < level.grid.width; x++) cellsRead += !IsMazeWall(level.grid, x, level.grid.height/2);
+
+    UnloadMazeLevel(level);
+    UnloadMazePack(pack);
+
+    double time = GetElapsedTime() - startTime;
+
+    // Cells count is kept so the reads are not optimized away
+    fileCase->cellsRead = cellsRead;
+
+    return time;
+}
+
+#if defined(BENCH_MESH)
+// Mesh case: meshes of every model chunk (CPU only, not uploaded)
+static double BenchMeshRun(void *data)
+{
+    BenchMeshCase *meshCase = (BenchMeshCase *)data;
+    int chunk = meshCase->chunkSize;
+
+    double startTime = GetElapsedTime();
+
+    for (int y = 0; y < meshCase->grid.height; y += chunk)
+    {
+        for (int x = 0; x < meshCase->grid.width; x += chunk)
+        {
+            UnloadMesh(GenMeshMazeData(meshCase->grid, (Rectangle){ (float)x, (float)y, (float)chunk, (float)chunk }));
+        }
+    }
+
+    return GetElapsedTime() - startTime;
+}
+#endif
+
+// Allocate tracked memory block
+static void *BenchAlloc(size_t size, bool clear)
+{
+    unsigned char *block = (unsigned char *)(clear? calloc(1, size + BENCH_ALLOC_HEADER) : malloc(size + BENCH_ALLOC_HEADER));
+    if (block == NULL) return NULL;
+
+    *(size_t *)block = size;
+    BenchTrackBytes(0, size);
+
+    return block + BENCH_ALLOC_HEADER;
+}
+
+// Reallocate tracked memory block
+static void *BenchRealloc(void *ptr, size_t size)
+{
+    if (ptr == NULL) return BenchAlloc(size, false);
+
+    unsigned char *block = (unsigned char *)ptr - BENCH_ALLOC_HEADER;
+    size_t previous = *(size_t *)block;
+
+    block = (unsigned char *)realloc(block, size + BENCH_ALLOC_HEADER);
+    if (block == NULL) return NULL;
+
+    *(size_t *)block = size;
+    BenchTrackBytes(previous, size);
+
+    return block + BENCH_ALLOC_HEADER;
+}
+
+// Free tracked memory block
+static void BenchFree(void *ptr)
+{
+    if (ptr == NULL) return;
+
+    unsigned char *block = (unsigned char *)ptr - BENCH_ALLOC_HEADER;
+    BenchTrackBytes(*(size_t *)block, 0);
+    free(block);
+}
+
+// Track allocated bytes change, peak is updated atomically (modules allocate from worker threads)
+static void BenchTrackBytes(size_t freed, size_t allocated)
+{
+    size_t current = atomic_fetch_add(&allocatedBytes, allocated) + allocated - freed;
+    atomic_fetch_sub(&allocatedBytes, freed);
+
+    size_t peak = atomic_load(&peakBytes);
+    while ((current > peak) && !atomic_compare_exchange_weak(&peakBytes, &peak, current));
+}
+
+// Reference distance field, scalar BFS (one cell per queue entry), returns reached cells
+static int BenchScalarBFS(MazeGrid grid, Point goal, int *distance, int *queue)
+{
+    const Point directions[4] = { { 0, -1 }, { 0, 1 }, { -1, 0 }, { 1, 0 } };
+    int head = 0;
+    int tail = 0;
+
+    memset(distance, 0xff, (size_t)grid.width*grid.height*sizeof(int));
+    if (IsMazeWall(grid, goal.x, goal.y)) return 0;
+
+    distance[goal.y*grid.width + goal.x] = 0;
+    queue[tail++] = goal.y*grid.width + goal.x;
+
+    while (head < tail)
+    {
+        int cell = queue[head++];
+        int x = cell%grid.width;
+        int y = cell/grid.width;
+
+        for (int i = 0; i < 4; i++)
+        {
+            int nx = x + directions[i].x;
+            int ny = y + directions[i].y;
+            if (IsMazeWall(grid, nx, ny) || (distance[ny*grid.width + nx] >= 0)) continue;
+
+            distance[ny*grid.width + nx] = distance[cell] + 1;
+            queue[tail++] = ny*grid.width + nx;
+        }
+    }
+
+    return tail;
+}
+
+// Check maze is perfect (walkable cells form a tree)
+// NOTE: Walkable cells must be reached from cell (1, 1) and cell (width - 2, height - 2) must be walkable,
+// a tree has exactly one adjacency less than cells (no cycles)
+static bool BenchCheckPerfect(MazeGrid grid, int *distance, int *queue)
+{
+    int cells = 0;
+    int edges = 0;
+
+    for (int y = 0; y < grid.height; y++)
+    {
+        for (int x = 0; x < grid.width; x++)
+        {
+            if (IsMazeWall(grid, x, y)) continue;
+
+            cells++;
+            if (!IsMazeWall(grid, x + 1, y)) edges++;
+            if (!IsMazeWall(grid, x, y + 1)) edges++;
+        }
+    }
+
+    int reached = BenchScalarBFS(grid, (Point){ 1, 1 }, distance, queue);
+
+    return !IsMazeWall(grid, grid.width - 2, grid.height - 2) && (reached == cells) && (edges == cells - 1);
+}
@@ -0,0 +1,291 @@
+/**********************************************************************************************
+*
+*   maze_bot - Maze simulated players module
+*
+*   Bots (MazeBot) play a maze session through the gameplay simulation (maze_sim.h), one input
+*   per step as a player would, so sessions use the game movement, collision radius, speed and
+*   time limit: bot results measure how hard a maze is to solve in game
+*
+*   Bots move from cell center to cell center (2D view), a new cell is selected every time the
+*   player reaches the selected cell center:
+*       MAZE_BOT_SHORTEST   - Follows the flow field to exit (shortest path, knows the maze)
+*       MAZE_BOT_WALL_LEFT  - Keeps its left hand on the wall (wall follower)
+*       MAZE_BOT_WALL_RIGHT - Keeps its right hand on the wall (wall follower)
+*       MAZE_BOT_RANDOM     - Random walk with memory: moves to the least visited neighbour cell,
+*                             ties are broken with counter-based random values (seed)
+*
+*   NOTE: Player step (speed*MAZE_SIM_STEP) must be lower than 2*(0.5 - radius) cells, so the
+*   player is centered enough to move along corridors (game values: 0.083 < 0.1)
+*
+*   CONFIGURATION:
+*       #define MAZE_IMPLEMENTATION
+*           Generates the implementation of the module in the including file,
+*           only ONE file of the program should define it
+*
+*   DEPENDENCIES:
+*       maze.h      - MazeGrid, Point, GetMazeRandom(), memory allocators
+*       maze_path.h - FlowField, GetFlowFieldNext() (shortest path bot)
+*       maze_sim.h  - MazeSim, StepMazeSim()
+*
+**********************************************************************************************/
+
+#ifndef MAZE_BOT_H
+#define MAZE_BOT_H
+
+#include "maze.h"                       // Required for: MazeGrid, Point, GetMazeRandom()
+#include "maze_path.h"                  // Required for: FlowField, GetFlowFieldNext()
+#include "maze_sim.h"                   // Required for: MazeSim, MazeSimInput, StepMazeSim()
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Bot types
+typedef enum {
+    MAZE_BOT_SHORTEST = 0,      // Flow field to exit
+    MAZE_BOT_WALL_LEFT,         // Left hand wall follower
+    MAZE_BOT_WALL_RIGHT,        // Right hand wall follower
+    MAZE_BOT_RANDOM             // Random walk with memory (least visited neighbour)
+} MazeBotType;
+
+// Simulated player
+typedef struct MazeBot {
+    int type;                   // Bot type (MazeBotType)
+    unsigned int seed;          // Random choices seed (MAZE_BOT_RANDOM)
+    const FlowField *field;     // Distances to exit (MAZE_BOT_SHORTEST, not owned)
+
+    Point target;               // Cell moving to
+    int heading;                // Moving direction (0: up, 1: right, 2: down, 3: left)
+    int moves;                  // Cells moved
+    int deadEnds;               // Dead end cells entered
+    unsigned char *visits;      // Visits per cell, saturated (MAZE_BOT_RANDOM)
+    int width;                  // Visits width in cells
+    int height;                 // Visits height in cells
+} MazeBot;
+
+// Bot session result
+typedef struct MazeBotResult {
+    int state;                  // Final session state (MazeSimState), MAZE_SIM_RUNNING if bot got stuck
+    unsigned int steps;         // Session steps
+    int moves;                  // Cells moved
+    int deadEnds;               // Dead end cells entered
+} MazeBotResult;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+MazeBot LoadMazeBot(int type, int width, int height, unsigned int seed);    // Load bot for a maze size (visits only allocated for random bot)
+void UnloadMazeBot(MazeBot bot);                                    // Unload bot
+void ResetMazeBot(MazeBot *bot, MazeSim sim);                       // Reset bot at session player cell (visits cleared)
+MazeSimInput GetMazeBotInput(MazeBot *bot, MazeSim sim);            // Get bot input for next session step
+MazeBotResult RunMazeBot(MazeBot *bot, MazeSim *sim);               // Run full session from start (session must have a time limit)
+
+#if defined(__cplusplus)
+}
+#endif
+
+/***********************************************************************************
+*
+*   MAZE BOT IMPLEMENTATION
+*
+************************************************************************************/
+#if defined(MAZE_IMPLEMENTATION)
+
+#include <string.h>                     // Required for: memset()
+#include <math.h>                       // Required for: fabsf()
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static int GetBotExits(MazeGrid grid, Point cell);                  // Get walkable neighbours bits (bit per heading)
+static Point GetBotNextCell(MazeBot *bot, MazeSim sim);             // Select next cell from bot current cell (target)
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static const Point botHeadings[4] = { { 0, -1 }, { 1, 0 }, { 0, 1 }, { -1, 0 } };   // Up, right, down, left (clockwise)
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Load bot for a maze size (visits only allocated for random bot)
+MazeBot LoadMazeBot(int type, int width, int height, unsigned int seed)
+{
+    MazeBot bot = { 0 };
+
+    bot.type = type;
+    bot.seed = seed;
+    bot.width = width;
+    bot.height = height;
+
+    if ((type == MAZE_BOT_RANDOM) && (width > 0) && (height > 0)) bot.visits = (unsigned char *)MAZE_CALLOC((size_t)width*height, 1);
+
+    return bot;
+}
+
+// Unload bot
+void UnloadMazeBot(MazeBot bot)
+{
+    MAZE_FREE(bot.visits);
+}
+
+// Reset bot at session player cell (visits cleared)
+void ResetMazeBot(MazeBot *bot, MazeSim sim)
+{
+    bot->target = sim.cell;
+    bot->heading = 1;
+    bot->moves = 0;
+    bot->deadEnds = 0;
+
+    if (bot->visits != NULL)
+    {
+        memset(bot->visits, 0, (size_t)bot->width*bot->height);
+        if (((unsigned int)sim.cell.x < (unsigned int)bot->width) && ((unsigned int)sim.cell.y < (unsigned int)bot->height)) bot->visits[sim.cell.y*bot->width + sim.cell.x] = 1;
+    }
+}
+
+// Get bot input for next session step
+// NOTE: Player moves along one axis at a time, a cell is reached when the player is closer
+// than half step to its center, so it stays centered on the other axis
+MazeSimInput GetMazeBotInput(MazeBot *bot, MazeSim sim)
+{
+    MazeSimInput input = { 0 };
+    float tolerance = sim.config.speed*MAZE_SIM_STEP*0.5f;
+    float offsetX = bot->target.x + 0.5f - sim.x;
+    float offsetY = bot->target.y + 0.5f - sim.y;
+
+    if ((fabsf(offsetX) <= tolerance) && (fabsf(offsetY) <= tolerance))
+    {
+        bot->target = GetBotNextCell(bot, sim);
+        offsetX = bot->target.x + 0.5f - sim.x;
+        offsetY = bot->target.y + 0.5f - sim.y;
+    }
+
+    if (fabsf(offsetX) > tolerance) input.keys = (offsetX > 0.0f)? MAZE_SIM_INPUT_RIGHT : MAZE_SIM_INPUT_LEFT;
+    else if (fabsf(offsetY) > tolerance) input.keys = (offsetY > 0.0f)? MAZE_SIM_INPUT_DOWN : MAZE_SIM_INPUT_UP;
+
+    return input;
+}
+
+// Run full session from start (session must have a time limit)
+// NOTE: Session is reset to its start (2D view), bot is stuck if player does not move for one second
+MazeBotResult RunMazeBot(MazeBot *bot, MazeSim *sim)
+{
+    MazeBotResult result = { 0 };
+
+    sim->config.view = MAZE_SIM_VIEW_2D;
+    ResetMazeSim(sim);
+    ResetMazeBot(bot, *sim);
+
+    int stuck = 0;
+
+    while ((sim->state == MAZE_SIM_RUNNING) && (stuck < MAZE_SIM_RATE))
+    {
+        MazeSimInput input = GetMazeBotInput(bot, *sim);
+        float x = sim->x;
+        float y = sim->y;
+
+        StepMazeSim(sim, input);
+
+        if ((sim->x == x) && (sim->y == y)) stuck++;
+        else stuck = 0;
+    }
+
+    result.state = sim->state;
+    result.steps = sim->tick;
+    result.moves = bot->moves;
+    result.deadEnds = bot->deadEnds;
+
+    return result;
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+// Get walkable neighbours bits (bit per heading)
+static int GetBotExits(MazeGrid grid, Point cell)
+{
+    int exits = 0;
+
+    for (int i = 0; i < 4; i++) if (!IsMazeWall(grid, cell.x + botHeadings[i].x, cell.y + botHeadings[i].y)) exits |= (1 << i);
+
+    return exits;
+}
+
+// Select next cell from bot current cell (target)
+// NOTE: Cell arrival is counted here: moves, dead ends (one exit, not the session exit) and visits
+static Point GetBotNextCell(MazeBot *bot, MazeSim sim)
+{
+    Point cell = bot->target;
+    int exits = GetBotExits(sim.grid, cell);
+
+    if ((exits == 0) || ((cell.x == sim.config.end.x) && (cell.y == sim.config.end.y))) return cell;
+
+    int heading = -1;
+
+    switch (bot->type)
+    {
+        case MAZE_BOT_SHORTEST:
+        {
+            if (bot->field == NULL) return cell;
+
+            Point next = GetFlowFieldNext(*bot->field, cell.x, cell.y);
+            for (int i = 0; i < 4; i++) if ((next.x == cell.x + botHeadings[i].x) && (next.y == cell.y + botHeadings[i].y)) heading = i;
+        } break;
+        case MAZE_BOT_WALL_LEFT:
+        case MAZE_BOT_WALL_RIGHT:
+        {
+            // Left hand: left, straight, right, back (right hand: mirrored)
+            int turn = (bot->type == MAZE_BOT_WALL_LEFT)? 3 : 1;
+
+            for (int i = 0; (i < 4) && (heading < 0); i++)
+            {
+                int candidate = (bot->heading + turn + i*(4 - turn)) & 3;
+                if (exits & (1 << candidate)) heading = candidate;
+            }
+        } break;
+        case MAZE_BOT_RANDOM:
+        {
+            if (bot->visits == NULL) return cell;
+
+            // Least visited neighbour, random first candidate so ties are selected randomly
+            unsigned int random = GetMazeRandom(bot->seed, bot->moves, 0, MAZE_RANDOM_BOT);
+            int leastVisits = 256;
+
+            for (int i = 0; i < 4; i++)
+            {
+                int candidate = (int)((random + i) & 3);
+                if (!(exits & (1 << candidate))) continue;
+
+                int visits = bot->visits[(cell.y + botHeadings[candidate].y)*bot->width + cell.x + botHeadings[candidate].x];
+                if (visits < leastVisits)
+                {
+                    leastVisits = visits;
+                    heading = candidate;
+                }
+            }
+        } break;
+        default: break;
+    }
+
+    if (heading < 0) return cell;
+
+    Point next = { cell.x + botHeadings[heading].x, cell.y + botHeadings[heading].y };
+
+    bot->heading = heading;
+    bot->moves++;
+
+    int nextExits = GetBotExits(sim.grid, next);
+    if (((nextExits & (nextExits - 1)) == 0) && ((next.x != sim.config.end.x) || (next.y != sim.config.end.y))) bot->deadEnds++;
+
+    if ((bot->visits != NULL) && (bot->visits[next.y*bot->width + next.x] < 255)) bot->visits[next.y*bot->width + next.x]++;
+
+    return next;
+}
+
+#endif // MAZE_IMPLEMENTATION
+
+#endif // MAZE_BOT_H
@@ -0,0 +1,462 @@
+/**********************************************************************************************
+*
+*   maze_bundle - Background maze generation module
+*
+*   Generates everything a new maze requires (MazeBundle: grid, display image, 3D model chunk
+*   meshes and distances to exit) in a worker thread, into a back buffer not shared with the
+*   maze in use, so the current maze keeps being played and drawn while the new one is built
+*
+*   Generation phases (MazeBundlePhase) are reported with progress (GetMazeBundleProgress()),
+*   once generation is finished the calling thread only has to upload GPU resources
+*   (UploadMazeBundle(): texture and model) and swap bundle data with the maze in use,
+*   every phase is timed (MazeBundle.phaseTime)
+*
+*   CPU phases never call GPU functions (raylib GPU functions must be called on main thread)
+*
+*   Bundles can also be built from an existing grid (MazeBundleConfig.grid, i.e. a loaded level),
+*   grid phase is skipped and the other phases are generated from it
+*
+*   Generated grids can be repaired (MazeBundleConfig.repair): interior walls are removed to connect
+*   walkable regions to the start cell, so the new maze is solvable without generating it again
+*
+*   NOTE: Current maze and new bundle are both in memory until swapped
+*
+*   CONFIGURATION:
+*       #define MAZE_IMPLEMENTATION
+*           Generates the implementation of the module in the including file,
+*           only ONE file of the program should define it
+*
+*       #define MAZE_NO_THREADS
+*           Disables worker thread (C11 threads.h), bundle is generated by StartMazeBundle()
+*
+*   DEPENDENCIES:
+*       raylib.h    - Image, Texture2D, Mesh
+*       maze.h      - MazeGrid, GenMazeGridBand(), LoadImageFromMazeGrid(), memory allocators
+*       maze_gen.h  - GenMazeGridAlgorithm()
+*       maze_mesh.h - GenMeshMazeData()
+*       maze_path.h - FlowField, ComputeFlowField()
+*       maze_analysis.h - MazeAnalyzer, RepairMazeConnectivity()
+*       maze_render.h - MazeModel, LoadMazeModelFromMeshes()
+*       threads.h   - Bundle worker thread (C11), not required if MAZE_NO_THREADS is defined
+*
+**********************************************************************************************/
+
+#ifndef MAZE_BUNDLE_H
+#define MAZE_BUNDLE_H
+
+#include "raylib.h"                     // Required for: Image, Texture2D, Mesh
+#include "maze.h"                       // Required for: MazeGrid, Point
+#include "maze_gen.h"                   // Required for: GenMazeGridAlgorithm()
+#include "maze_mesh.h"                  // Required for: GenMeshMazeData()
+#include "maze_path.h"                  // Required for: FlowField
+#include "maze_analysis.h"              // Required for: RepairMazeConnectivity()
+#include "maze_render.h"                // Required for: MazeModel
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Bundle generation phases
+typedef enum {
+    MAZE_BUNDLE_GRID = 0,       // Generate maze grid (CPU)
+    MAZE_BUNDLE_REPAIR,         // Connect walkable regions to start cell (CPU)
+    MAZE_BUNDLE_IMAGE,          // Generate display image (CPU)
+    MAZE_BUNDLE_MESHES,         // Generate 3D model chunks meshes (CPU)
+    MAZE_BUNDLE_FLOW,           // Compute distances to exit (CPU)
+    MAZE_BUNDLE_UPLOAD,         // Upload texture and model (GPU, main thread)
+    MAZE_BUNDLE_PHASE_COUNT
+} MazeBundlePhase;
+
+// Bundle generation parameters
+typedef struct MazeBundleConfig {
+    int width;                  // Maze width in cells
+    int height;                 // Maze height in cells
+    int spacingRows;            // Grid algorithm rows spacing
+    int spacingCols;            // Grid algorithm columns spacing
+    float skipChance;           // Grid algorithm skip chance
+    unsigned int seed;          // Generation seed
+    int algorithm;              // Generation algorithm (MazeGenAlgorithm)
+    int modelChunk;             // 3D model chunk size in cells (up to MAZE_MESH_MAX_REGION)
+    int maxModelCells;          // Maximum maze cells to generate the 3D model (0: no model)
+    MazeGrid grid;              // Source grid (i.e. loaded level), taken by the bundle, NULL cells to generate it
+    Point endCell;              // Exit cell, (0, 0) for bottom-right corner cell
+    bool repair;                // Connect walkable regions to start cell (1, 1) removing interior walls, generated grids only
+} MazeBundleConfig;
+
+// Maze bundle, everything required to swap the maze in use
+typedef struct MazeBundle {
+    MazeBundleConfig config;    // Generation parameters
+    MazeGrid grid;              // Maze grid
+    Image image;                // Display image (WHITE=Wall, BLACK=Walkable)
+    Texture2D texture;          // Display texture, loaded by UploadMazeBundle()
+    Mesh *meshes;               // 3D model chunks meshes (CPU), NULL if no model
+    MazeModel model;            // 3D model, loaded by UploadMazeBundle() (takes meshes)
+    FlowField flowField;        // Distances to exit cell
+    Point endCell;              // Exit cell
+    double phaseTime[MAZE_BUNDLE_PHASE_COUNT];  // Time of every phase (seconds)
+} MazeBundle;
+
+// Background bundle generation
+typedef struct MazeBundleLoader {
+    struct MazeBundleWorker *worker;    // Bundle being generated (internal), NULL if idle
+} MazeBundleLoader;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+bool StartMazeBundle(MazeBundleLoader *loader, MazeBundleConfig config);   // Start bundle generation, false if a bundle is already being generated
+bool IsMazeBundleBusy(MazeBundleLoader loader);                     // Check if a bundle is being generated (or not taken yet)
+float GetMazeBundleProgress(MazeBundleLoader loader, int *phase);   // Get generation progress [0..1] and current phase (MazeBundlePhase)
+bool TakeMazeBundle(MazeBundleLoader *loader, MazeBundle *bundle);  // Take generated bundle if finished (CPU data only), loader gets idle
+void CancelMazeBundle(MazeBundleLoader *loader);                    // Stop bundle generation (waits for worker) and unload it
+bool UploadMazeBundle(MazeBundle *bundle);                          // Upload bundle texture and model to GPU (main thread), image is kept
+void UnloadMazeBundle(MazeBundle bundle);                           // Unload bundle data (not swapped)
+const char *GetMazeBundlePhaseName(int phase);                      // Get phase name (i.e. "meshes")
+
+#if defined(__cplusplus)
+}
+#endif
+
+/***********************************************************************************
+*
+*   MAZE BUNDLE IMPLEMENTATION
+*
+************************************************************************************/
+#if defined(MAZE_IMPLEMENTATION)
+
+#if !defined(MAZE_NO_THREADS)
+    #include <threads.h>                // Required for: thrd_create(), thrd_join()
+    #include <stdatomic.h>              // Required for: atomic_int, atomic_load(), atomic_store()
+#endif
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Bundle generation state, shared with worker thread
+// NOTE: Bundle (back buffer) is only accessed by the worker until it is finished
+typedef struct MazeBundleWorker {
+    MazeBundle bundle;          // Bundle being generated
+#if !defined(MAZE_NO_THREADS)
+    atomic_int phase;           // Current phase, MAZE_BUNDLE_UPLOAD when finished
+    atomic_int steps;           // Current phase steps done
+    atomic_int stepCount;       // Current phase steps
+    atomic_int cancel;          // Worker must stop
+    thrd_t thread;              // Worker thread
+    bool running;               // Worker thread started
+#else
+    int phase;                  // Current phase, MAZE_BUNDLE_UPLOAD when finished
+    int steps;                  // Current phase steps done
+    int stepCount;              // Current phase steps
+    int cancel;                 // Worker must stop
+#endif
+} MazeBundleWorker;
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static void BundleSetState(MazeBundleWorker *worker, int phase, int steps, int stepCount);  // Update worker phase and progress
+static int BundleGetState(MazeBundleWorker *worker, int *steps, int *stepCount);           // Get worker phase and progress
+static int BundleGenerate(void *arg);                               // Generate bundle phases (worker thread)
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Start bundle generation, false if a bundle is already being generated
+// NOTE: If worker thread can not be started, bundle is generated before returning
+// NOTE: Source grid (config.grid) is only taken if bundle generation is started
+bool StartMazeBundle(MazeBundleLoader *loader, MazeBundleConfig config)
+{
+    if (loader->worker != NULL) return false;
+
+    if (config.grid.cells != NULL)
+    {
+        config.width = config.grid.width;
+        config.height = config.grid.height;
+    }
+
+    if ((config.width <= 0) || (config.height <= 0)) return false;
+
+    MazeBundleWorker *worker = (MazeBundleWorker *)MAZE_CALLOC(1, sizeof(MazeBundleWorker));
+
+    if (worker == NULL) return false;
+
+    worker->bundle.config = config;
+    BundleSetState(worker, MAZE_BUNDLE_GRID, 0, 1);
+
+#if !defined(MAZE_NO_THREADS)
+    atomic_store(&worker->cancel, 0);
+    if (thrd_create(&worker->thread, BundleGenerate, worker) == thrd_success) worker->running = true;
+    else BundleGenerate(worker);
+#else
+    BundleGenerate(worker);
+#endif
+
+    loader->worker = worker;
+
+    return true;
+}
+
+// Check if a bundle is being generated (or not taken yet)
+bool IsMazeBundleBusy(MazeBundleLoader loader)
+{
+    return (loader.worker != NULL);
+}
+
+// Get generation progress [0..1] and current phase (MazeBundlePhase)
+// NOTE: Every CPU phase counts the same, progress is 1.0 when bundle can be taken
+float GetMazeBundleProgress(MazeBundleLoader loader, int *phase)
+{
+    int steps = 0;
+    int stepCount = 1;
+    int current = (loader.worker != NULL)? BundleGetState(loader.worker, &steps, &stepCount) : MAZE_BUNDLE_UPLOAD;
+
+    if (phase != NULL) *phase = current;
+    if (current >= MAZE_BUNDLE_UPLOAD) return 1.0f;
+
+    float phaseProgress = (stepCount > 0)? (float)steps/stepCount : 0.0f;
+
+    return (current + phaseProgress)/MAZE_BUNDLE_UPLOAD;
+}
+
+// Take generated bundle if finished (CPU data only), loader gets idle
+// NOTE: Bundle GPU resources must be loaded with UploadMazeBundle() before use
+bool TakeMazeBundle(MazeBundleLoader *loader, MazeBundle *bundle)
+{
+    MazeBundleWorker *worker = loader->worker;
+
+    if (worker == NULL) return false;
+    if (BundleGetState(worker, NULL, NULL) < MAZE_BUNDLE_UPLOAD) return false;
+
+#if !defined(MAZE_NO_THREADS)
+    if (worker->running) thrd_join(worker->thread, NULL);
+#endif
+
+    *bundle = worker->bundle;
+    MAZE_FREE(worker);
+    loader->worker = NULL;
+
+    return true;
+}
+
+// Stop bundle generation (waits for worker) and unload it
+void CancelMazeBundle(MazeBundleLoader *loader)
+{
+    MazeBundleWorker *worker = loader->worker;
+
+    if (worker == NULL) return;
+
+#if !defined(MAZE_NO_THREADS)
+    atomic_store(&worker->cancel, 1);
+    if (worker->running) thrd_join(worker->thread, NULL);
+#endif
+
+    UnloadMazeBundle(worker->bundle);
+    MAZE_FREE(worker);
+    loader->worker = NULL;
+}
+
+// Upload bundle texture and model to GPU (main thread), image is kept
+// NOTE: Model takes bundle meshes (meshes are set to NULL), upload time is MAZE_BUNDLE_UPLOAD phase time
+bool UploadMazeBundle(MazeBundle *bundle)
+{
+    if (bundle->grid.cells == NULL) return false;
+
+    double startTime = GetElapsedTime();
+
+    bundle->texture = LoadTextureFromImage(bundle->image);
+
+    if (bundle->meshes != NULL)
+    {
+        bundle->model = LoadMazeModelFromMeshes(bundle->meshes, bundle->grid.width, bundle->grid.height, bundle->config.modelChunk);
+        bundle->meshes = NULL;
+    }
+
+    bundle->phaseTime[MAZE_BUNDLE_UPLOAD] = GetElapsedTime() - startTime;
+
+    return (bundle->texture.id > 0);
+}
+
+// Unload bundle data (not swapped)
+void UnloadMazeBundle(MazeBundle bundle)
+{
+    if (bundle.meshes != NULL)
+    {
+        int chunkCount = ((bundle.grid.width + bundle.config.modelChunk - 1)/bundle.config.modelChunk)*
+                         ((bundle.grid.height + bundle.config.modelChunk - 1)/bundle.config.modelChunk);
+
+        for (int i = 0; i < chunkCount; i++) UnloadMesh(bundle.meshes[i]);
+        MAZE_FREE(bundle.meshes);
+    }
+
+    UnloadMazeModel(bundle.model);
+    UnloadTexture(bundle.texture);
+    UnloadImage(bundle.image);
+    UnloadFlowField(bundle.flowField);
+    UnloadMazeGrid(bundle.grid);
+}
+
+// Get phase name (i.e. "meshes")
+const char *GetMazeBundlePhaseName(int phase)
+{
+    switch (phase)
+    {
+        case MAZE_BUNDLE_GRID: return "grid";
+        case MAZE_BUNDLE_REPAIR: return "repair";
+        case MAZE_BUNDLE_IMAGE: return "image";
+        case MAZE_BUNDLE_MESHES: return "meshes";
+        case MAZE_BUNDLE_FLOW: return "flow";
+        case MAZE_BUNDLE_UPLOAD: return "upload";
+        default: return "unknown";
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+// Update worker phase and progress
+static void BundleSetState(MazeBundleWorker *worker, int phase, int steps, int stepCount)
+{
+#if !defined(MAZE_NO_THREADS)
+    // NOTE: Phase is stored last, a reader getting a new phase never gets a previous phase progress
+    atomic_store(&worker->stepCount, stepCount);
+    atomic_store(&worker->steps, steps);
+    atomic_store(&worker->phase, phase);
+#else
+    worker->stepCount = stepCount;
+    worker->steps = steps;
+    worker->phase = phase;
+#endif
+}
+
+// Get worker phase and progress
+static int BundleGetState(MazeBundleWorker *worker, int *steps, int *stepCount)
+{
+#if !defined(MAZE_NO_THREADS)
+    int phase = atomic_load(&worker->phase);
+    if (steps != NULL) *steps = atomic_load(&worker->steps);
+    if (stepCount != NULL) *stepCount = atomic_load(&worker->stepCount);
+#else
+    int phase = worker->phase;
+    if (steps != NULL) *steps = worker->steps;
+    if (stepCount != NULL) *stepCount = worker->stepCount;
+#endif
+
+    return phase;
+}
+
+// Generate bundle phases (worker thread)
+// NOTE: No GPU function is called, on failure or cancel generated data is kept (bundle.grid.cells NULL if grid failed)
+static int BundleGenerate(void *arg)
+{
+    MazeBundleWorker *worker = (MazeBundleWorker *)arg;
+    MazeBundle *bundle = &worker->bundle;
+    MazeBundleConfig config = bundle->config;
+
+#if !defined(MAZE_NO_THREADS)
+    #define BUNDLE_CANCELLED()  (atomic_load(&worker->cancel) != 0)
+#else
+    #define BUNDLE_CANCELLED()  (worker->cancel != 0)
+#endif
+
+    // Grid phase: grid algorithm is generated band by band (same result as GenMazeGridEx()) to report progress,
+    // a single thread is used to keep processors available for the maze in use
+    double startTime = GetElapsedTime();
+
+    bool generated = (config.grid.cells == NULL);
+
+    if (!generated)
+    {
+        bundle->grid = config.grid;
+        bundle->config.grid = (MazeGrid){ 0 };
+    }
+    else if (config.algorithm == MAZE_GEN_GRID)
+    {
+        int bandCount = (config.height + MAZE_BAND_ROWS - 1)/MAZE_BAND_ROWS;
+
+        bundle->grid = LoadMazeGrid(config.width, config.height);
+
+        for (int band = 0; (bundle->grid.cells != NULL) && (band < bandCount); band++)
+        {
+            if (BUNDLE_CANCELLED() || !GenMazeGridBand(&bundle->grid, band, config.spacingRows, config.spacingCols, config.skipChance, config.seed))
+            {
+                UnloadMazeGrid(bundle->grid);
+                bundle->grid = (MazeGrid){ 0 };
+            }
+            else BundleSetState(worker, MAZE_BUNDLE_GRID, band + 1, bandCount);
+        }
+    }
+    else bundle->grid = GenMazeGridAlgorithm(config.width, config.height, config.spacingRows, config.spacingCols, config.skipChance, config.seed, config.algorithm);
+
+    bundle->phaseTime[MAZE_BUNDLE_GRID] = GetElapsedTime() - startTime;
+
+    if ((bundle->grid.cells != NULL) && !BUNDLE_CANCELLED())
+    {
+        MazeGrid grid = bundle->grid;
+        bool validEnd = (config.endCell.x > 0) && (config.endCell.y > 0) && (config.endCell.x < grid.width) && (config.endCell.y < grid.height);
+        bundle->endCell = validEnd? config.endCell : (Point){ grid.width - 2, grid.height - 2 };
+
+        // Repair phase: loaded grids are kept as saved
+        if (config.repair && generated)
+        {
+            BundleSetState(worker, MAZE_BUNDLE_REPAIR, 0, 1);
+            startTime = GetElapsedTime();
+            MazeAnalyzer analyzer = LoadMazeAnalyzer(grid.width, grid.height);
+            RepairMazeConnectivity(&analyzer, &bundle->grid, (Point){ 1, 1 }, bundle->endCell);
+            UnloadMazeAnalyzer(analyzer);
+            bundle->phaseTime[MAZE_BUNDLE_REPAIR] = GetElapsedTime() - startTime;
+        }
+
+        // Image phase
+        BundleSetState(worker, MAZE_BUNDLE_IMAGE, 0, 1);
+        startTime = GetElapsedTime();
+        bundle->image = LoadImageFromMazeGrid(grid);
+        bundle->phaseTime[MAZE_BUNDLE_IMAGE] = GetElapsedTime() - startTime;
+
+        // Meshes phase: one mesh per model chunk, chunkY*chunkCountX + chunkX
+        startTime = GetElapsedTime();
+
+        if ((config.modelChunk > 0) && (config.modelChunk <= MAZE_MESH_MAX_REGION) && ((long long)grid.width*grid.height <= config.maxModelCells))
+        {
+            int chunkCountX = (grid.width + config.modelChunk - 1)/config.modelChunk;
+            int chunkCountY = (grid.height + config.modelChunk - 1)/config.modelChunk;
+
+            bundle->meshes = (Mesh *)MAZE_CALLOC(chunkCountX*chunkCountY, sizeof(Mesh));
+
+            for (int y = 0; (bundle->meshes != NULL) && (y < chunkCountY) && !BUNDLE_CANCELLED(); y++)
+            {
+                BundleSetState(worker, MAZE_BUNDLE_MESHES, y, chunkCountY);
+
+                for (int x = 0; x < chunkCountX; x++)
+                {
+                    Rectangle rec = { (float)(x*config.modelChunk), (float)(y*config.modelChunk), (float)config.modelChunk, (float)config.modelChunk };
+                    bundle->meshes[y*chunkCountX + x] = GenMeshMazeData(grid, rec);
+                }
+            }
+        }
+
+        bundle->phaseTime[MAZE_BUNDLE_MESHES] = GetElapsedTime() - startTime;
+
+        // Flow field phase
+        if (!BUNDLE_CANCELLED())
+        {
+            BundleSetState(worker, MAZE_BUNDLE_FLOW, 0, 1);
+            startTime = GetElapsedTime();
+            bundle->flowField = LoadFlowField(grid.width, grid.height);
+            ComputeFlowField(&bundle->flowField, grid, bundle->endCell, 1);
+            bundle->phaseTime[MAZE_BUNDLE_FLOW] = GetElapsedTime() - startTime;
+        }
+    }
+
+    #undef BUNDLE_CANCELLED
+
+    BundleSetState(worker, MAZE_BUNDLE_UPLOAD, 0, 1);
+
+    return 0;
+}
+
+#endif // MAZE_IMPLEMENTATION
+
+#endif // MAZE_BUNDLE_H
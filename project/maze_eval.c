@@ -0,0 +1,521 @@
+/*******************************************************************************************
+*
+*   raylib maze generator - headless maze difficulty evaluator
+*
+*   Scores how hard mazes are by playing them with simulated players (maze_bot.h) through the
+*   gameplay simulation (maze_sim.h, game speed, collision radius and time limit): a shortest
+*   path bot, left/right hand wall followers and several random walk with memory bots per maze,
+*   mazes are evaluated in parallel using all available cores, no window, OpenGL context or
+*   audio device is required
+*
+*   Mazes are the levels of a pack file (.mzl) or generated for a range of seeds (start cell
+*   (1, 1), exit cell (width - 2, height - 2), as the game), results are written as CSV, one row
+*   per maze: walkable cells, components, dead end cells, shortest path length (maze_analysis.h), bots time to solve (random
+*   bots solve rate, unsolved runs and solved runs time percentiles), dead ends entered and
+*   difficulty: random bots unsolved runs plus censored median time to solve (all runs, unsolved
+*   runs counted as time limit) in time limits, so a maze with less solved runs always scores
+*   harder and the median time ranks mazes with the same solved runs (checked on summary)
+*
+*   NOTE: Default time limit is the game one (120 s), random bots rarely solve big mazes in it
+*   (64x64 grid mazes: ~1% of runs), time limit (-l) should grow with maze area to rank them
+*
+*   USAGE:
+*       maze_eval [options] [pack.mzl]
+*           -n <count>      Number of mazes to generate, if no pack is provided (default: 1000)
+*           -s <seed>       First seed of the range, mazes use seeds [seed, seed + count) (default: 1)
+*           -w <width>      Maze width (default: 64)
+*           -h <height>     Maze height (default: 64)
+*           -r <rows>       Spacing rows (default: 3)
+*           -c <cols>       Spacing cols (default: 3)
+*           -k <chance>     Skip chance [0.0..1.0] (default: 0.75)
+*           -a <algorithm>  Generation algorithm: grid, kruskal, backtracker, wilson, eller (default: grid)
+*           -b <count>      Random walk bots per maze (default: 16)
+*           -l <seconds>    Session time limit (default: 120)
+*           -t <threads>    Worker threads (default: number of logical processors)
+*           -o <file>       Results CSV file (default: maze_eval.csv)
+*           -x              Do not write results, only summary
+*
+*   BUILD (Linux):
+*       gcc maze_eval.c -o maze_eval -O2 -lm -lpthread
+*
+********************************************************************************************/
+
+#define MAZE_IMPLEMENTATION
+#include "maze.h"                       // Required for: MazeGrid, IsMazeWall(), GetElapsedTime()
+#include "maze_gen.h"                   // Required for: GenMazeGridAlgorithm()
+#include "maze_path.h"                  // Required for: FlowField (maze_analysis.h, maze_bot.h)
+#include "maze_analysis.h"              // Required for: MazeAnalyzer, AnalyzeMaze()
+#include "maze_stream.h"                // Required for: MazeStream (maze_sim.h)
+#include "maze_items.h"                 // Required for: MazeItems (maze_sim.h)
+#include "maze_file.h"                  // Required for: MazePack, GetMazePackLevel()
+#include "maze_sim.h"                   // Required for: MazeSim, InitMazeSim()
+#include "maze_bot.h"                   // Required for: MazeBot, RunMazeBot()
+
+#include <stdio.h>                      // Required for: printf(), fprintf()
+#include <stdlib.h>                     // Required for: atoi(), atof(), calloc(), free(), qsort()
+#include <string.h>                     // Required for: strcmp()
+#include <threads.h>                    // Required for: thrd_create(), thrd_join()
+#include <stdatomic.h>                  // Required for: atomic_int, atomic_fetch_add()
+
+#define MAX_EVAL_THREADS        256
+#define MAX_EVAL_BOTS           256     // Random walk bots per maze
+#define EVAL_HISTOGRAM_BUCKETS  12      // Random bots time to solve histogram buckets (time limit split)
+
+#define EVAL_PLAYER_SPEED       5.0f    // Player speed (cells per second), as the game (playerSpeed)
+#define EVAL_COLLISION_RADIUS   0.45f   // Player collision radius, as the game (collisionRadius)
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Maze evaluation result, times in seconds (-1: not solved)
+typedef struct EvalResult {
+    unsigned int seed;
+    int width;
+    int height;
+    int walkable;                       // Walkable cells
+    int components;                     // Walkable connected components
+    int deadEnds;                       // Dead end cells (one walkable neighbour)
+    int pathLength;                     // Shortest path steps from start to exit (-1: exit not reachable)
+    float shortestTime;                 // Shortest path bot time to solve
+    float wallLeftTime;                 // Left hand wall follower time to solve
+    float wallRightTime;                // Right hand wall follower time to solve
+    int randomSolved;                   // Random bots sessions solved
+    float randomTimes[4];               // Random bots solved sessions time: p10, p50, p90, max
+    float randomDeadEnds;               // Random bots dead ends entered, mean per session
+    float difficulty;                   // Random bots unsolved runs + censored median time / time limit (-1: not evaluated)
+    bool evaluated;                     // Maze could be generated or loaded
+} EvalResult;
+
+// Evaluation configuration and shared work counters
+typedef struct EvalConfig {
+    int count;
+    unsigned int firstSeed;
+    int width;
+    int height;
+    int spacingRows;
+    int spacingCols;
+    float skipChance;
+    int algorithm;
+    int bots;
+    int timeLimit;
+    MazePack pack;                      // Levels pack (levels evaluated instead of generated mazes)
+    EvalResult *results;
+
+    atomic_int nextIndex;               // Next maze index to be taken by a worker
+    atomic_int evaluated;               // Mazes evaluated
+    atomic_llong steps;                 // Simulation steps run
+    atomic_int histogram[EVAL_HISTOGRAM_BUCKETS + 1];   // Random bots sessions per time to solve bucket, last: not solved
+} EvalConfig;
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static int EvalWorker(void *arg);       // Worker thread: take maze indices until the range is done
+static void EvalMaze(EvalConfig *config, MazeAnalyzer *analyzer, MazeGrid grid, Point start, Point end, EvalResult *result, int *histogram);  // Evaluate maze with all bots
+static int CompareSteps(const void *a, const void *b);     // Compare session steps (qsort)
+static int CompareValues(const void *a, const void *b);    // Compare float values (qsort)
+static float GetPercentile(float *values, int count, float percentile);  // Get percentile of sorted values
+
+//----------------------------------------------------------------------------------
+// Main entry point
+//----------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    static EvalConfig config = { 0 };
+    config.count = 1000;
+    config.firstSeed = 1;
+    config.width = 64;
+    config.height = 64;
+    config.spacingRows = 3;
+    config.spacingCols = 3;
+    config.skipChance = 0.75f;
+    config.algorithm = MAZE_GEN_GRID;
+    config.bots = 16;
+    config.timeLimit = 120;
+
+    const char *packFileName = NULL;
+    const char *outputFileName = "maze_eval.csv";
+    bool writeResults = true;
+    int threadCount = GetProcessorCount();
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = (i + 1 < argc);
+
+        if ((strcmp(argv[i], "-n") == 0) && hasValue) config.count = atoi(argv[++i]);
+        else if ((strcmp(argv[i], "-s") == 0) && hasValue) config.firstSeed = (unsigned int)strtoul(argv[++i], NULL, 10);
+        else if ((strcmp(argv[i], "-w") == 0) && hasValue) config.width = atoi(argv[++i]);
+        else if ((strcmp(argv[i], "-h") == 0) && hasValue) config.height = atoi(argv[++i]);
+        else if ((strcmp(argv[i], "-r") == 0) && hasValue) config.spacingRows = atoi(argv[++i]);
+        else if ((strcmp(argv[i], "-c") == 0) && hasValue) config.spacingCols = atoi(argv[++i]);
+        else if ((strcmp(argv[i], "-k") == 0) && hasValue) config.skipChance = (float)atof(argv[++i]);
+        else if ((strcmp(argv[i], "-a") == 0) && hasValue)
+        {
+            const char *name = argv[++i];
+            config.algorithm = -1;
+            for (int a = MAZE_GEN_GRID; a <= MAZE_GEN_ELLER; a++) if (strcmp(name, GetMazeGenAlgorithmName(a)) == 0) config.algorithm = a;
+        }
+        else if ((strcmp(argv[i], "-b") == 0) && hasValue) config.bots = atoi(argv[++i]);
+        else if ((strcmp(argv[i], "-l") == 0) && hasValue) config.timeLimit = atoi(argv[++i]);
+        else if ((strcmp(argv[i], "-t") == 0) && hasValue) threadCount = atoi(argv[++i]);
+        else if ((strcmp(argv[i], "-o") == 0) && hasValue) outputFileName = argv[++i];
+        else if (strcmp(argv[i], "-x") == 0) writeResults = false;
+        else if ((argv[i][0] != '-') && (packFileName == NULL)) packFileName = argv[i];
+        else
+        {
+            printf("USAGE: %s [-n count] [-s seed] [-w width] [-h height] [-r rows] [-c cols] [-k skipChance] [-a algorithm] [-b bots] [-l seconds] [-t threads] [-o file] [-x] [pack.mzl]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (packFileName != NULL)
+    {
+        config.pack = LoadMazePack(packFileName);
+
+        if (config.pack.data == NULL)
+        {
+            printf("ERROR: Failed to load levels pack %s\n", packFileName);
+            return 1;
+        }
+
+        config.count = config.pack.levelCount;
+    }
+
+    if ((config.count <= 0) || (config.width < 3) || (config.height < 3) || (config.spacingRows < 1) || (config.spacingCols < 1) ||
+        (config.algorithm < 0) || (config.bots < 0) || (config.bots > MAX_EVAL_BOTS) || (config.timeLimit < 1))
+    {
+        printf("ERROR: Invalid evaluation parameters\n");
+        UnloadMazePack(config.pack);
+        return 1;
+    }
+
+    if (threadCount < 1) threadCount = 1;
+    if (threadCount > MAX_EVAL_THREADS) threadCount = MAX_EVAL_THREADS;
+    if (threadCount > config.count) threadCount = config.count;
+
+    config.results = (EvalResult *)calloc((size_t)config.count, sizeof(EvalResult));
+
+    if (config.results == NULL)
+    {
+        printf("ERROR: Failed to allocate results\n");
+        UnloadMazePack(config.pack);
+        return 1;
+    }
+
+    if (packFileName != NULL) printf("Evaluating %i levels of %s using %i threads\n", config.count, packFileName, threadCount);
+    else printf("Evaluating %i mazes (%ix%i, %s) for seeds [%u, %u] using %i threads\n", config.count, config.width, config.height,
+        GetMazeGenAlgorithmName(config.algorithm), config.firstSeed, config.firstSeed + (unsigned int)config.count - 1, threadCount);
+    printf("Bots per maze: shortest path, left/right hand wall followers, %i random walk with memory (%i s time limit)\n", config.bots, config.timeLimit);
+
+    double startTime = GetElapsedTime();
+
+    thrd_t threads[MAX_EVAL_THREADS] = { 0 };
+    for (int i = 0; i < threadCount; i++) thrd_create(&threads[i], EvalWorker, &config);
+    for (int i = 0; i < threadCount; i++) thrd_join(threads[i], NULL);
+
+    double elapsed = GetElapsedTime() - startTime;
+    int evaluated = atomic_load(&config.evaluated);
+    long long steps = atomic_load(&config.steps);
+
+    printf("Evaluated %i mazes in %.3f s: %.1f mazes/sec, %.0f steps/sec (%.0fx real time)\n", evaluated, elapsed,
+        (elapsed > 0.0)? evaluated/elapsed : 0.0, (elapsed > 0.0)? steps/elapsed : 0.0, (elapsed > 0.0)? steps/(elapsed*MAZE_SIM_RATE) : 0.0);
+
+    // Summary over all mazes
+    int unsolvable = 0;
+    int wallSolved = 0;
+    int randomSolved = 0;
+    int difficultyCount = 0;
+    float *difficulty = (float *)calloc((size_t)config.count, sizeof(float));
+    float orderMin[MAX_EVAL_BOTS + 1] = { 0 };      // Difficulty range per solved runs count
+    float orderMax[MAX_EVAL_BOTS + 1] = { 0 };
+    int orderCount[MAX_EVAL_BOTS + 1] = { 0 };
+
+    for (int i = 0; i < config.count; i++)
+    {
+        EvalResult *result = &config.results[i];
+
+        if (!result->evaluated) continue;
+        if (result->pathLength < 0) { unsolvable++; continue; }
+
+        if ((result->wallLeftTime >= 0.0f) || (result->wallRightTime >= 0.0f)) wallSolved++;
+        randomSolved += result->randomSolved;
+        if (result->difficulty < 0.0f) continue;
+        if (difficulty != NULL) difficulty[difficultyCount++] = result->difficulty;
+
+        int solved = result->randomSolved;
+        if ((orderCount[solved] == 0) || (result->difficulty < orderMin[solved])) orderMin[solved] = result->difficulty;
+        if ((orderCount[solved] == 0) || (result->difficulty > orderMax[solved])) orderMax[solved] = result->difficulty;
+        orderCount[solved]++;
+    }
+
+    // Difficulty order check: mazes with less solved runs must always score harder
+    int orderErrors = 0;
+    float harderMin = 0.0f;
+    bool harderFound = false;
+
+    for (int solved = 0; solved <= config.bots; solved++)
+    {
+        if (orderCount[solved] == 0) continue;
+        if (harderFound && (orderMax[solved] >= harderMin)) orderErrors++;
+        if (!harderFound || (orderMin[solved] < harderMin)) harderMin = orderMin[solved];
+        harderFound = true;
+    }
+
+    int solvable = evaluated - unsolvable;
+
+    printf("Exit not reachable: %i mazes\n", unsolvable);
+    if (solvable > 0)
+    {
+        printf("Solved by a wall follower: %.1f%% of mazes\n", 100.0f*wallSolved/solvable);
+        if (config.bots > 0) printf("Solved by random bots: %.1f%% of sessions\n", 100.0f*randomSolved/((float)solvable*config.bots));
+    }
+
+    if (difficultyCount > 0)
+    {
+        qsort(difficulty, (size_t)difficultyCount, sizeof(float), CompareValues);
+        printf("Difficulty (random bots unsolved runs + censored median time in time limits, %i mazes): p10 %.2f, p50 %.2f, p90 %.2f, max %.2f\n", difficultyCount,
+            GetPercentile(difficulty, difficultyCount, 0.1f), GetPercentile(difficulty, difficultyCount, 0.5f),
+            GetPercentile(difficulty, difficultyCount, 0.9f), difficulty[difficultyCount - 1]);
+    }
+
+    free(difficulty);
+
+    if (orderErrors > 0) printf("ERROR: %i solved runs counts score easier than mazes with less solved runs\n", orderErrors);
+
+    if (config.bots > 0)
+    {
+        printf("Random bots time to solve (sessions):\n");
+        for (int i = 0; i <= EVAL_HISTOGRAM_BUCKETS; i++)
+        {
+            int sessions = atomic_load(&config.histogram[i]);
+            if (i < EVAL_HISTOGRAM_BUCKETS) printf("    [%6.1f, %6.1f) s: %i\n", (float)config.timeLimit*i/EVAL_HISTOGRAM_BUCKETS, (float)config.timeLimit*(i + 1)/EVAL_HISTOGRAM_BUCKETS, sessions);
+            else printf("    not solved:         %i\n", sessions);
+        }
+    }
+
+    bool success = (orderErrors == 0);
+
+    if (writeResults)
+    {
+        FILE *file = fopen(outputFileName, "wt");
+
+        if (file != NULL)
+        {
+            fprintf(file, "index,seed,width,height,walkable,components,dead_ends,path_length,shortest_s,wall_left_s,wall_right_s,"
+                "random_solved,random_runs,random_solve_rate,random_unsolved,random_p10_s,random_p50_s,random_p90_s,random_max_s,random_dead_ends,difficulty\n");
+
+            for (int i = 0; i < config.count; i++)
+            {
+                EvalResult *result = &config.results[i];
+                if (!result->evaluated) continue;
+
+                fprintf(file, "%i,%u,%i,%i,%i,%i,%i,%i,%.3f,%.3f,%.3f,%i,%i,%.3f,%i,%.3f,%.3f,%.3f,%.3f,%.2f,%.3f\n", i, result->seed, result->width,
+                    result->height, result->walkable, result->components, result->deadEnds, result->pathLength, result->shortestTime, result->wallLeftTime,
+                    result->wallRightTime, result->randomSolved, config.bots,
+                    (config.bots > 0)? (float)result->randomSolved/config.bots : 0.0f, config.bots - result->randomSolved, result->randomTimes[0], result->randomTimes[1],
+                    result->randomTimes[2], result->randomTimes[3], result->randomDeadEnds, result->difficulty);
+            }
+
+            fclose(file);
+            printf("Results written to %s\n", outputFileName);
+        }
+        else
+        {
+            printf("ERROR: Failed to write %s\n", outputFileName);
+            success = false;
+        }
+    }
+
+    if (evaluated < config.count)
+    {
+        printf("WARNING: %i mazes could not be generated or loaded\n", config.count - evaluated);
+        success = false;
+    }
+
+    free(config.results);
+    UnloadMazePack(config.pack);
+
+    return success? 0 : 1;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Worker thread: take maze indices until the range is done
+static int EvalWorker(void *arg)
+{
+    EvalConfig *config = (EvalConfig *)arg;
+    MazeAnalyzer analyzer = { 0 };
+    int histogram[EVAL_HISTOGRAM_BUCKETS + 1] = { 0 };
+
+    for (int index = atomic_fetch_add(&config->nextIndex, 1); index < config->count; index = atomic_fetch_add(&config->nextIndex, 1))
+    {
+        EvalResult *result = &config->results[index];
+
+        if (config->pack.data != NULL)
+        {
+            MazeLevel level = GetMazePackLevel(config->pack, index);
+
+            if (level.grid.cells == NULL) continue;
+
+            result->seed = level.seed;
+            EvalMaze(config, &analyzer, level.grid, level.start, level.end, result, histogram);
+            UnloadMazeLevel(level);
+        }
+        else
+        {
+            unsigned int seed = config->firstSeed + (unsigned int)index;
+            MazeGrid grid = GenMazeGridAlgorithm(config->width, config->height, config->spacingRows, config->spacingCols, config->skipChance, seed, config->algorithm);
+
+            if (grid.cells == NULL) continue;
+
+            result->seed = seed;
+            EvalMaze(config, &analyzer, grid, (Point){ 1, 1 }, (Point){ grid.width - 2, grid.height - 2 }, result, histogram);
+            UnloadMazeGrid(grid);
+        }
+
+        atomic_fetch_add(&config->evaluated, 1);
+    }
+
+    for (int i = 0; i <= EVAL_HISTOGRAM_BUCKETS; i++) atomic_fetch_add(&config->histogram[i], histogram[i]);
+
+    UnloadMazeAnalyzer(analyzer);
+
+    return 0;
+}
+
+// Evaluate maze with all bots
+// NOTE: Bots only play mazes with a reachable exit, random bot seeds are derived from maze seed,
+// shortest path bot follows the analysis flow field (distances to exit)
+static void EvalMaze(EvalConfig *config, MazeAnalyzer *analyzer, MazeGrid grid, Point start, Point end, EvalResult *result, int *histogram)
+{
+    result->width = grid.width;
+    result->height = grid.height;
+    result->pathLength = -1;
+    result->shortestTime = -1.0f;
+    result->wallLeftTime = -1.0f;
+    result->wallRightTime = -1.0f;
+    for (int i = 0; i < 4; i++) result->randomTimes[i] = -1.0f;
+    result->difficulty = -1.0f;
+    result->evaluated = true;
+
+    MazeAnalysis analysis = AnalyzeMaze(analyzer, grid, start, end);
+
+    result->walkable = analysis.walkable;
+    result->components = analysis.components;
+    result->deadEnds = analysis.deadEnds;
+    result->pathLength = analysis.solutionLength;
+
+    if (result->pathLength >= 0)
+    {
+        MazeSimConfig simConfig = { MAZE_SIM_VIEW_2D, start, end, EVAL_PLAYER_SPEED, EVAL_COLLISION_RADIUS, config->timeLimit };
+        MazeSim sim = InitMazeSim(grid, NULL, simConfig);
+        long long steps = 0;
+
+        // Shortest path and wall followers
+        float *times[3] = { &result->shortestTime, &result->wallLeftTime, &result->wallRightTime };
+
+        for (int type = MAZE_BOT_SHORTEST; type <= MAZE_BOT_WALL_RIGHT; type++)
+        {
+            MazeBot bot = LoadMazeBot(type, grid.width, grid.height, 0);
+            bot.field = &analyzer->field;
+
+            MazeBotResult run = RunMazeBot(&bot, &sim);
+            if (run.state == MAZE_SIM_WON) *times[type] = (float)run.steps/MAZE_SIM_RATE;
+            steps += run.steps;
+
+            UnloadMazeBot(bot);
+        }
+
+        // Random walk with memory bots
+        if (config->bots > 0)
+        {
+            unsigned int solvedSteps[MAX_EVAL_BOTS] = { 0 };
+            unsigned int limitSteps = (unsigned int)config->timeLimit*MAZE_SIM_RATE;
+            unsigned int allSteps[MAX_EVAL_BOTS] = { 0 };
+            int deadEnds = 0;
+
+            MazeBot bot = LoadMazeBot(MAZE_BOT_RANDOM, grid.width, grid.height, 0);
+
+            for (int i = 0; i < config->bots; i++)
+            {
+                bot.seed = result->seed*(unsigned int)MAX_EVAL_BOTS + (unsigned int)i;
+
+                MazeBotResult run = RunMazeBot(&bot, &sim);
+                steps += run.steps;
+                deadEnds += run.deadEnds;
+
+                if (run.state == MAZE_SIM_WON)
+                {
+                    solvedSteps[result->randomSolved++] = run.steps;
+                    allSteps[i] = run.steps;
+
+                    int bucket = (int)((unsigned long long)run.steps*EVAL_HISTOGRAM_BUCKETS/limitSteps);
+                    histogram[(bucket < EVAL_HISTOGRAM_BUCKETS)? bucket : EVAL_HISTOGRAM_BUCKETS - 1]++;
+                }
+                else
+                {
+                    allSteps[i] = limitSteps;
+                    histogram[EVAL_HISTOGRAM_BUCKETS]++;
+                }
+            }
+
+            UnloadMazeBot(bot);
+
+            if (result->randomSolved > 0)
+            {
+                float seconds[MAX_EVAL_BOTS] = { 0 };
+
+                qsort(solvedSteps, (size_t)result->randomSolved, sizeof(unsigned int), CompareSteps);
+                for (int i = 0; i < result->randomSolved; i++) seconds[i] = (float)solvedSteps[i]/MAZE_SIM_RATE;
+
+                result->randomTimes[0] = GetPercentile(seconds, result->randomSolved, 0.1f);
+                result->randomTimes[1] = GetPercentile(seconds, result->randomSolved, 0.5f);
+                result->randomTimes[2] = GetPercentile(seconds, result->randomSolved, 0.9f);
+                result->randomTimes[3] = seconds[result->randomSolved - 1];
+            }
+
+            result->randomDeadEnds = (float)deadEnds/config->bots;
+
+            // Censored median: unsolved runs are only known to take the time limit or more, median of all runs
+            // is bounded by the time limit (0, 1], unsolved runs count added on top keeps solve rate order
+            float limits[MAX_EVAL_BOTS] = { 0 };
+
+            qsort(allSteps, (size_t)config->bots, sizeof(unsigned int), CompareSteps);
+            for (int i = 0; i < config->bots; i++) limits[i] = (float)allSteps[i]/limitSteps;
+
+            result->difficulty = (float)(config->bots - result->randomSolved) + GetPercentile(limits, config->bots, 0.5f);
+        }
+
+        atomic_fetch_add(&config->steps, steps);
+    }
+}
+
+// Compare session steps (qsort)
+static int CompareSteps(const void *a, const void *b)
+{
+    unsigned int stepsA = *(const unsigned int *)a;
+    unsigned int stepsB = *(const unsigned int *)b;
+
+    return (stepsA > stepsB) - (stepsA < stepsB);
+}
+
+// Compare float values (qsort)
+static int CompareValues(const void *a, const void *b)
+{
+    float valueA = *(const float *)a;
+    float valueB = *(const float *)b;
+
+    return (valueA > valueB) - (valueA < valueB);
+}
+
+// Get percentile of sorted values (nearest rank)
+static float GetPercentile(float *values, int count, float percentile)
+{
+    int index = (int)(percentile*count + 0.5f) - 1;
+
+    if (index < 0) index = 0;
+    if (index > count - 1) index = count - 1;
+
+    return values[index];
+}
@@ -0,0 +1,584 @@
+/**********************************************************************************************
+*
+*   maze_export - Maze 3D mesh streaming export module
+*
+*   Exports the 3D mesh of a MazeGrid (greedy meshing, maze_mesh) as Wavefront OBJ or binary
+*   glTF (GLB) without building the full mesh: the maze is meshed in chunks of MAZE_EXPORT_CHUNK
+*   cells and every chunk is written to the file and unloaded before the next one is generated,
+*   so memory used does not depend on maze size (one chunk mesh and file buffer)
+*
+*   Exports can run in a worker thread (StartMazeExport(), grid is copied so it can be edited
+*   while exporting), progress is reported in chunks written (GetMazeExportProgress()),
+*   ExportMazeMesh() exports on calling thread (headless tools)
+*
+*   Vertex positions are in cells: cell (x, y) is centered at (x, 0.5, y), texture coordinates
+*   are in cells like the maze model (atlas tile repeated by the maze mesh shader), the atlas
+*   tile origin of every face is exported as second texture coordinates (GLB TEXCOORD_1)
+*
+*   NOTE: GLB triangles are not indexed (vertex data written as generated), size limit is 4 GB
+*   NOTE: Partially written files are removed on failure or cancel
+*
+*   CONFIGURATION:
+*       #define MAZE_IMPLEMENTATION
+*           Generates the implementation of the module in the including file,
+*           only ONE file of the program should define it
+*
+*       #define MAZE_NO_THREADS
+*           Disables worker thread (C11 threads.h), export is done by StartMazeExport()
+*
+*   DEPENDENCIES:
+*       raylib.h    - Mesh
+*       maze.h      - MazeGrid, LoadMazeGrid(), memory allocators
+*       maze_mesh.h - GenMeshMazeData()
+*       threads.h   - Export worker thread (C11), not required if MAZE_NO_THREADS is defined
+*
+**********************************************************************************************/
+
+#ifndef MAZE_EXPORT_H
+#define MAZE_EXPORT_H
+
+#include "raylib.h"                     // Required for: Mesh, Rectangle
+#include "maze.h"                       // Required for: MazeGrid
+#include "maze_mesh.h"                  // Required for: GenMeshMazeData()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define MAZE_EXPORT_CHUNK       32              // Chunk size in cells (up to MAZE_MESH_MAX_REGION)
+#define MAZE_EXPORT_BUFFER      (1024*1024)     // File buffer size in bytes
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Export file formats
+typedef enum {
+    MAZE_EXPORT_OBJ = 0,        // Wavefront OBJ (text)
+    MAZE_EXPORT_GLB             // Binary glTF 2.0
+} MazeExportFormat;
+
+// Export result
+typedef struct MazeExportResult {
+    bool success;               // File written (false on failure or cancel)
+    long long vertexCount;      // Vertices written
+    long long triangleCount;    // Triangles written
+    long long fileSize;         // File size in bytes
+    double time;                // Export time (seconds)
+} MazeExportResult;
+
+// Background mesh export
+typedef struct MazeExporter {
+    struct MazeExportWorker *worker;    // Export in progress (internal), NULL if idle
+} MazeExporter;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+bool StartMazeExport(MazeExporter *exporter, MazeGrid grid, const char *fileName, int format);  // Start mesh export (grid is copied), false if an export is in progress
+bool IsMazeExportBusy(MazeExporter exporter);                       // Check if an export is in progress (or result not taken yet)
+float GetMazeExportProgress(MazeExporter exporter);                 // Get export progress [0..1] (chunks written)
+bool TakeMazeExport(MazeExporter *exporter, MazeExportResult *result);     // Take export result if finished, exporter gets idle
+void CancelMazeExport(MazeExporter *exporter);                      // Stop export (waits for worker), partial file is removed
+MazeExportResult ExportMazeMesh(MazeGrid grid, const char *fileName, int format);   // Export mesh on calling thread
+
+#if defined(__cplusplus)
+}
+#endif
+
+/***********************************************************************************
+*
+*   MAZE EXPORT IMPLEMENTATION
+*
+************************************************************************************/
+#if defined(MAZE_IMPLEMENTATION)
+
+#include <stdio.h>                      // Required for: FILE, fopen(), fprintf(), fwrite(), snprintf(), remove()
+#include <string.h>                     // Required for: memcpy(), memset(), strlen()
+#include <float.h>                      // Required for: FLT_MAX
+#include <math.h>                       // Required for: llroundf()
+
+#if !defined(MAZE_NO_THREADS)
+    #include <threads.h>                // Required for: thrd_create(), thrd_join()
+    #include <stdatomic.h>              // Required for: atomic_int, atomic_load(), atomic_store()
+#endif
+
+#define MAZE_EXPORT_GLB_JSON    1024    // GLB JSON chunk size (reserved, written once mesh is exported)
+#define MAZE_EXPORT_GLB_VERTEX  40      // GLB vertex size: position, normal, texcoord, texcoord2
+#define MAZE_EXPORT_OBJ_VERTEX  160     // OBJ text maximum size per vertex (v, vt and vn lines)
+#define MAZE_EXPORT_OBJ_FACE    192     // OBJ text maximum size per triangle (f line)
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Export state, shared with worker thread
+typedef struct MazeExportWorker {
+    MazeGrid grid;              // Grid to export (copy if exported by worker thread)
+    char *fileName;             // Output file name
+    int format;                 // Output format (MazeExportFormat)
+    MazeExportResult result;    // Export result, valid when finished
+#if !defined(MAZE_NO_THREADS)
+    atomic_int chunksDone;      // Chunks written
+    atomic_int chunkCount;      // Chunks to write
+    atomic_int finished;        // Export finished (result valid)
+    atomic_int cancel;          // Worker must stop
+    thrd_t thread;              // Worker thread
+    bool running;               // Worker thread started
+#else
+    int chunksDone;             // Chunks written
+    int chunkCount;             // Chunks to write
+    int finished;               // Export finished (result valid)
+    int cancel;                 // Worker must stop
+#endif
+} MazeExportWorker;
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static MazeExportResult ExportMazeChunks(MazeExportWorker *worker);    // Export grid chunks to file, checks cancel and reports progress
+static bool WriteMazeChunkOBJ(FILE *file, Mesh mesh, float offsetX, float offsetZ, const char *name, long long firstVertex);  // Write chunk mesh as OBJ object
+static bool WriteMazeChunkGLB(FILE *file, Mesh mesh, float offsetX, float offsetZ, float *min, float *max);  // Write chunk mesh vertex data (not indexed), updates bounds
+static bool WriteMazeHeaderGLB(FILE *file, long long vertexCount, const float *min, const float *max);      // Write GLB header and JSON chunk (reserved size)
+static char *FormatMazeFloat(char *text, float value, char separator);      // Format value (up to 4 decimals) and separator, returns text end
+static char *FormatMazeInteger(char *text, long long value, char prefix, char separator);  // Format prefix, value and separator (0: none), returns text end
+static char *FormatMazeText(char *text, const char *string, char separator);   // Copy string and separator (0: none), returns text end
+static void UnloadMazeChunkMesh(Mesh mesh);                         // Unload chunk mesh data (CPU only, no GPU resources)
+static int ExportMazeWorker(void *arg);                             // Export grid and set finished (worker thread)
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Start mesh export (grid is copied), false if an export is in progress
+// NOTE: If worker thread can not be started, mesh is exported before returning
+bool StartMazeExport(MazeExporter *exporter, MazeGrid grid, const char *fileName, int format)
+{
+    if ((exporter->worker != NULL) || (grid.cells == NULL) || (fileName == NULL)) return false;
+
+    MazeExportWorker *worker = (MazeExportWorker *)MAZE_CALLOC(1, sizeof(MazeExportWorker));
+
+    if (worker == NULL) return false;
+
+    size_t nameSize = strlen(fileName) + 1;
+    worker->grid = LoadMazeGrid(grid.width, grid.height);
+    worker->fileName = (char *)MAZE_MALLOC(nameSize);
+    worker->format = format;
+
+    if ((worker->grid.cells == NULL) || (worker->fileName == NULL))
+    {
+        UnloadMazeGrid(worker->grid);
+        MAZE_FREE(worker->fileName);
+        MAZE_FREE(worker);
+        return false;
+    }
+
+    memcpy(worker->grid.cells, grid.cells, (size_t)grid.stride*grid.height*sizeof(uint64_t));
+    memcpy(worker->fileName, fileName, nameSize);
+
+#if !defined(MAZE_NO_THREADS)
+    atomic_store(&worker->cancel, 0);
+    if (thrd_create(&worker->thread, ExportMazeWorker, worker) == thrd_success) worker->running = true;
+    else ExportMazeWorker(worker);
+#else
+    ExportMazeWorker(worker);
+#endif
+
+    exporter->worker = worker;
+
+    return true;
+}
+
+// Check if an export is in progress (or result not taken yet)
+bool IsMazeExportBusy(MazeExporter exporter)
+{
+    return (exporter.worker != NULL);
+}
+
+// Get export progress [0..1] (chunks written)
+float GetMazeExportProgress(MazeExporter exporter)
+{
+    MazeExportWorker *worker = exporter.worker;
+
+    if (worker == NULL) return 1.0f;
+
+#if !defined(MAZE_NO_THREADS)
+    int chunksDone = atomic_load(&worker->chunksDone);
+    int chunkCount = atomic_load(&worker->chunkCount);
+#else
+    int chunksDone = worker->chunksDone;
+    int chunkCount = worker->chunkCount;
+#endif
+
+    return (chunkCount > 0)? (float)chunksDone/chunkCount : 0.0f;
+}
+
+// Take export result if finished, exporter gets idle
+bool TakeMazeExport(MazeExporter *exporter, MazeExportResult *result)
+{
+    MazeExportWorker *worker = exporter->worker;
+
+    if (worker == NULL) return false;
+
+#if !defined(MAZE_NO_THREADS)
+    if (atomic_load(&worker->finished) == 0) return false;
+    if (worker->running) thrd_join(worker->thread, NULL);
+#else
+    if (worker->finished == 0) return false;
+#endif
+
+    if (result != NULL) *result = worker->result;
+
+    UnloadMazeGrid(worker->grid);
+    MAZE_FREE(worker->fileName);
+    MAZE_FREE(worker);
+    exporter->worker = NULL;
+
+    return true;
+}
+
+// Stop export (waits for worker), partial file is removed
+void CancelMazeExport(MazeExporter *exporter)
+{
+    MazeExportWorker *worker = exporter->worker;
+
+    if (worker == NULL) return;
+
+#if !defined(MAZE_NO_THREADS)
+    atomic_store(&worker->cancel, 1);
+    if (worker->running) thrd_join(worker->thread, NULL);
+#endif
+
+    UnloadMazeGrid(worker->grid);
+    MAZE_FREE(worker->fileName);
+    MAZE_FREE(worker);
+    exporter->worker = NULL;
+}
+
+// Export mesh on calling thread
+MazeExportResult ExportMazeMesh(MazeGrid grid, const char *fileName, int format)
+{
+    MazeExportWorker worker = { 0 };
+    worker.grid = grid;
+    worker.fileName = (char *)fileName;
+    worker.format = format;
+
+    return ExportMazeChunks(&worker);
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+// Export grid chunks to file, checks cancel and reports progress
+// NOTE: GLB header and JSON chunk require mesh size and bounds, they are written at the end (reserved space)
+static MazeExportResult ExportMazeChunks(MazeExportWorker *worker)
+{
+    MazeExportResult result = { 0 };
+    MazeGrid grid = worker->grid;
+    double startTime = GetElapsedTime();
+
+    if ((grid.cells == NULL) || ((worker->format != MAZE_EXPORT_OBJ) && (worker->format != MAZE_EXPORT_GLB))) return result;
+
+    FILE *file = fopen(worker->fileName, "wb");
+    if (file == NULL) return result;
+
+    setvbuf(file, NULL, _IOFBF, MAZE_EXPORT_BUFFER);
+
+    int chunkCountX = (grid.width + MAZE_EXPORT_CHUNK - 1)/MAZE_EXPORT_CHUNK;
+    int chunkCountY = (grid.height + MAZE_EXPORT_CHUNK - 1)/MAZE_EXPORT_CHUNK;
+    float min[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+    float max[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+    bool success = true;
+    bool cancelled = false;
+
+#if !defined(MAZE_NO_THREADS)
+    atomic_store(&worker->chunkCount, chunkCountX*chunkCountY);
+#else
+    worker->chunkCount = chunkCountX*chunkCountY;
+#endif
+
+    if (worker->format == MAZE_EXPORT_OBJ)
+    {
+        success = (fprintf(file, "# Maze mesh: %ix%i cells, %ix%i chunks\n# NOTE: Texture coordinates are in cells (atlas tile repeated)\n",
+            grid.width, grid.height, chunkCountX, chunkCountY) > 0);
+    }
+    else success = WriteMazeHeaderGLB(file, 0, min, max);
+
+    for (int y = 0; success && !cancelled && (y < chunkCountY); y++)
+    {
+        for (int x = 0; success && (x < chunkCountX); x++)
+        {
+#if !defined(MAZE_NO_THREADS)
+            cancelled = (atomic_load(&worker->cancel) != 0);
+#else
+            cancelled = (worker->cancel != 0);
+#endif
+            if (cancelled) break;
+
+            Rectangle rec = { (float)(x*MAZE_EXPORT_CHUNK), (float)(y*MAZE_EXPORT_CHUNK), (float)MAZE_EXPORT_CHUNK, (float)MAZE_EXPORT_CHUNK };
+            Mesh mesh = GenMeshMazeData(grid, rec);
+
+            if (worker->format == MAZE_EXPORT_OBJ)
+            {
+                char name[32] = { 0 };
+                snprintf(name, sizeof(name), "chunk_%i_%i", x, y);
+                success = WriteMazeChunkOBJ(file, mesh, rec.x, rec.y, name, result.vertexCount);
+                result.vertexCount += mesh.vertexCount;
+            }
+            else
+            {
+                success = WriteMazeChunkGLB(file, mesh, rec.x, rec.y, min, max);
+                result.vertexCount += (long long)mesh.triangleCount*3;
+            }
+
+            result.triangleCount += mesh.triangleCount;
+            UnloadMazeChunkMesh(mesh);
+
+#if !defined(MAZE_NO_THREADS)
+            atomic_fetch_add(&worker->chunksDone, 1);
+#else
+            worker->chunksDone++;
+#endif
+        }
+    }
+
+    if (success && !cancelled && (worker->format == MAZE_EXPORT_GLB))
+    {
+        success = (fseek(file, 0, SEEK_SET) == 0) && WriteMazeHeaderGLB(file, result.vertexCount, min, max) && (fseek(file, 0, SEEK_END) == 0);
+    }
+
+    if (success && !cancelled)
+    {
+        long size = ftell(file);
+        result.fileSize = (size > 0)? size : 0;
+    }
+
+    success = (fclose(file) == 0) && success && !cancelled;
+
+    if (!success)
+    {
+        remove(worker->fileName);
+        result = (MazeExportResult){ 0 };
+    }
+
+    result.success = success;
+    result.time = GetElapsedTime() - startTime;
+
+    return result;
+}
+
+// Write chunk mesh as OBJ object
+// NOTE: OBJ indices are 1-based and global, chunk vertices follow previous chunks vertices (firstVertex)
+// NOTE: Chunk text is formatted into a buffer (4 decimals, no printf()), written at once
+static bool WriteMazeChunkOBJ(FILE *file, Mesh mesh, float offsetX, float offsetZ, const char *name, long long firstVertex)
+{
+    if (mesh.vertexCount == 0) return true;
+
+    char *text = (char *)MAZE_MALLOC((size_t)mesh.vertexCount*MAZE_EXPORT_OBJ_VERTEX + (size_t)mesh.triangleCount*MAZE_EXPORT_OBJ_FACE + 64);
+    if (text == NULL) return false;
+
+    char *line = text + snprintf(text, 64, "o %s\n", name);
+
+    for (int i = 0; i < mesh.vertexCount; i++)
+    {
+        line = FormatMazeText(line, "v ", 0);
+        line = FormatMazeFloat(line, mesh.vertices[i*3] + offsetX, ' ');
+        line = FormatMazeFloat(line, mesh.vertices[i*3 + 1], ' ');
+        line = FormatMazeFloat(line, mesh.vertices[i*3 + 2] + offsetZ, '\n');
+    }
+
+    for (int i = 0; i < mesh.vertexCount; i++)
+    {
+        line = FormatMazeText(line, "vt ", 0);
+        line = FormatMazeFloat(line, mesh.texcoords[i*2], ' ');
+        line = FormatMazeFloat(line, mesh.texcoords[i*2 + 1], '\n');
+    }
+
+    for (int i = 0; i < mesh.vertexCount; i++)
+    {
+        line = FormatMazeText(line, "vn ", 0);
+        line = FormatMazeFloat(line, mesh.normals[i*3], ' ');
+        line = FormatMazeFloat(line, mesh.normals[i*3 + 1], ' ');
+        line = FormatMazeFloat(line, mesh.normals[i*3 + 2], '\n');
+    }
+
+    for (int i = 0; i < mesh.triangleCount; i++)
+    {
+        line = FormatMazeText(line, "f", 0);
+
+        for (int k = 0; k < 3; k++)
+        {
+            long long index = firstVertex + mesh.indices[i*3 + k] + 1;
+            line = FormatMazeInteger(line, index, ' ', '/');
+            line = FormatMazeInteger(line, index, 0, '/');
+            line = FormatMazeInteger(line, index, 0, (k == 2)? '\n' : 0);
+        }
+    }
+
+    size_t size = (size_t)(line - text);
+    bool success = (fwrite(text, 1, size, file) == size);
+    MAZE_FREE(text);
+
+    return success;
+}
+
+// Write chunk mesh vertex data (not indexed), updates bounds
+// NOTE: Vertex layout (MAZE_EXPORT_GLB_VERTEX bytes): position (3 floats), normal (3 floats), texcoord (2 floats), texcoord2 (2 floats)
+static bool WriteMazeChunkGLB(FILE *file, Mesh mesh, float offsetX, float offsetZ, float *min, float *max)
+{
+    if (mesh.triangleCount == 0) return true;
+
+    int vertexCount = mesh.triangleCount*3;
+    float *data = (float *)MAZE_MALLOC((size_t)vertexCount*MAZE_EXPORT_GLB_VERTEX);
+
+    if (data == NULL) return false;
+
+    for (int i = 0; i < vertexCount; i++)
+    {
+        int index = mesh.indices[i];
+        float *vertex = data + i*(MAZE_EXPORT_GLB_VERTEX/sizeof(float));
+        float position[3] = { mesh.vertices[index*3] + offsetX, mesh.vertices[index*3 + 1], mesh.vertices[index*3 + 2] + offsetZ };
+
+        memcpy(vertex, position, 3*sizeof(float));
+        memcpy(vertex + 3, mesh.normals + index*3, 3*sizeof(float));
+        memcpy(vertex + 6, mesh.texcoords + index*2, 2*sizeof(float));
+        memcpy(vertex + 8, mesh.texcoords2 + index*2, 2*sizeof(float));
+
+        for (int k = 0; k < 3; k++)
+        {
+            if (position[k] < min[k]) min[k] = position[k];
+            if (position[k] > max[k]) max[k] = position[k];
+        }
+    }
+
+    bool success = (fwrite(data, MAZE_EXPORT_GLB_VERTEX, vertexCount, file) == (size_t)vertexCount);
+    MAZE_FREE(data);
+
+    return success;
+}
+
+// Write GLB header and JSON chunk (reserved size)
+// NOTE: JSON is padded with spaces to MAZE_EXPORT_GLB_JSON bytes, binary chunk always starts at same offset
+static bool WriteMazeHeaderGLB(FILE *file, long long vertexCount, const float *min, const float *max)
+{
+    char json[MAZE_EXPORT_GLB_JSON + 1] = { 0 };
+    long long binSize = vertexCount*MAZE_EXPORT_GLB_VERTEX;
+    long long fileSize = 12 + 8 + MAZE_EXPORT_GLB_JSON + 8 + binSize;
+
+    if (fileSize > 0xffffffffLL) return false;
+
+    int length = snprintf(json, sizeof(json),
+        "{\"asset\":{\"version\":\"2.0\",\"generator\":\"maze_export\"},\"scene\":0,\"scenes\":[{\"nodes\":[0]}],\"nodes\":[{\"mesh\":0}],"
+        "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0,\"NORMAL\":1,\"TEXCOORD_0\":2,\"TEXCOORD_1\":3},\"mode\":4}]}],"
+        "\"buffers\":[{\"byteLength\":%lld}],\"bufferViews\":[{\"buffer\":0,\"byteOffset\":0,\"byteLength\":%lld,\"byteStride\":%i,\"target\":34962}],"
+        "\"accessors\":[{\"bufferView\":0,\"byteOffset\":0,\"componentType\":5126,\"count\":%lld,\"type\":\"VEC3\",\"min\":[%g,%g,%g],\"max\":[%g,%g,%g]},"
+        "{\"bufferView\":0,\"byteOffset\":12,\"componentType\":5126,\"count\":%lld,\"type\":\"VEC3\"},"
+        "{\"bufferView\":0,\"byteOffset\":24,\"componentType\":5126,\"count\":%lld,\"type\":\"VEC2\"},"
+        "{\"bufferView\":0,\"byteOffset\":32,\"componentType\":5126,\"count\":%lld,\"type\":\"VEC2\"}]}",
+        binSize, binSize, MAZE_EXPORT_GLB_VERTEX, vertexCount, min[0], min[1], min[2], max[0], max[1], max[2], vertexCount, vertexCount, vertexCount);
+
+    if ((length < 0) || (length > MAZE_EXPORT_GLB_JSON)) return false;
+
+    memset(json + length, ' ', MAZE_EXPORT_GLB_JSON - length);
+
+    uint32_t header[5] = { 0x46546c67, 2, (uint32_t)fileSize, MAZE_EXPORT_GLB_JSON, 0x4e4f534a };   // "glTF", version, length, JSON chunk
+    uint32_t binHeader[2] = { (uint32_t)binSize, 0x004e4942 };      // BIN chunk
+
+    return (fwrite(header, sizeof(header), 1, file) == 1) && (fwrite(json, MAZE_EXPORT_GLB_JSON, 1, file) == 1) &&
+           (fwrite(binHeader, sizeof(binHeader), 1, file) == 1);
+}
+
+// Format value (up to 4 decimals) and separator, returns text end
+// NOTE: Trailing zeros are removed, mesh values are small (cells), out of range values are clamped
+static char *FormatMazeFloat(char *text, float value, char separator)
+{
+    if (value > 1e9f) value = 1e9f;
+    else if (value < -1e9f) value = -1e9f;
+
+    long long scaled = llroundf(value*10000.0f);
+
+    if (scaled < 0)
+    {
+        *text++ = '-';
+        scaled = -scaled;
+    }
+
+    text = FormatMazeInteger(text, scaled/10000, 0, 0);
+
+    int fraction = (int)(scaled%10000);
+
+    if (fraction != 0)
+    {
+        int digits = 4;
+        while (fraction%10 == 0) { fraction /= 10; digits--; }
+
+        *text++ = '.';
+        for (int i = digits - 1; i >= 0; i--) { text[i] = (char)('0' + fraction%10); fraction /= 10; }
+        text += digits;
+    }
+
+    if (separator != 0) *text++ = separator;
+
+    return text;
+}
+
+// Format prefix, value and separator (0: none), returns text end
+static char *FormatMazeInteger(char *text, long long value, char prefix, char separator)
+{
+    char digits[24] = { 0 };
+    int count = 0;
+
+    if (prefix != 0) *text++ = prefix;
+    if (value < 0)
+    {
+        *text++ = '-';
+        value = -value;
+    }
+
+    do { digits[count++] = (char)('0' + value%10); value /= 10; } while (value > 0);
+    while (count > 0) *text++ = digits[--count];
+
+    if (separator != 0) *text++ = separator;
+
+    return text;
+}
+
+// Copy string and separator (0: none), returns text end
+static char *FormatMazeText(char *text, const char *string, char separator)
+{
+    while (*string != '\0') *text++ = *string++;
+    if (separator != 0) *text++ = separator;
+
+    return text;
+}
+
+// Unload chunk mesh data (CPU only, no GPU resources)
+// NOTE: UnloadMesh() also releases GPU buffers, it must not be called from worker thread
+static void UnloadMazeChunkMesh(Mesh mesh)
+{
+    RL_FREE(mesh.vertices);
+    RL_FREE(mesh.texcoords);
+    RL_FREE(mesh.texcoords2);
+    RL_FREE(mesh.normals);
+    RL_FREE(mesh.indices);
+}
+
+// Export grid and set finished (worker thread)
+static int ExportMazeWorker(void *arg)
+{
+    MazeExportWorker *worker = (MazeExportWorker *)arg;
+
+    worker->result = ExportMazeChunks(worker);
+
+#if !defined(MAZE_NO_THREADS)
+    atomic_store(&worker->finished, 1);
+#else
+    worker->finished = 1;
+#endif
+
+    return 0;
+}
+
+#endif // MAZE_IMPLEMENTATION
+
+#endif // MAZE_EXPORT_H
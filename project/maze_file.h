@@ -0,0 +1,523 @@
+/**********************************************************************************************
+*
+*   maze_file - Binary maze levels file format module
+*
+*   Levels (MazeLevel: grid, start/end cells, items, biome and generation parameters) are stored
+*   in versioned binary packs, a single level file is a pack with one level:
+*
+*       Pack header     16 bytes: magic "MZPK", version, levels count, reserved
+*       Levels index    16 bytes per level: level offset and size (random access to any level)
+*       Levels          Level header (72 bytes), items (x, y pairs), grid words (raw or RLE)
+*
+*   Levels are aligned to 8 bytes and grid words are stored as they are in memory (MazeGrid
+*   bit-packed rows), so uncompressed grids are used directly from the loaded pack data:
+*   packs are memory-mapped (LoadMazePack()), loading does not read or copy the grid,
+*   pages are only read from disk when cells are accessed
+*
+*   Grids can be compressed with run-length encoding (PackBits over grid bytes, long runs of
+*   walls/walkable cells), compressed grids are decoded on GetMazePackLevel(); grids that RLE
+*   does not reduce (i.e. perfect mazes) are always stored uncompressed
+*
+*   NOTE: Values are stored in native byte order (little-endian on all supported platforms)
+*   NOTE: Mapped packs are private (copy-on-write), editing a mapped grid never changes the file
+*
+*   CONFIGURATION:
+*       #define MAZE_IMPLEMENTATION
+*           Generates the implementation of the module in the including file,
+*           only ONE file of the program should define it
+*
+*   DEPENDENCIES:
+*       maze.h      - MazeGrid, Point, LoadMazeGrid(), memory allocators
+*       sys/mman.h  - Memory-mapped packs (POSIX), packs are read into memory on Windows
+*
+**********************************************************************************************/
+
+#ifndef MAZE_FILE_H
+#define MAZE_FILE_H
+
+#include "maze.h"                       // Required for: MazeGrid, Point
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define MAZE_FILE_VERSION       1       // Pack format version, packs with other versions are not loaded
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Level grid compression
+typedef enum {
+    MAZE_FILE_RAW = 0,          // Grid words as they are in memory (zero-copy loading)
+    MAZE_FILE_RLE               // Grid bytes run-length encoded (PackBits)
+} MazeFileCompression;
+
+// Maze level, everything required to play a maze
+typedef struct MazeLevel {
+    MazeGrid grid;              // Maze grid
+    Point start;                // Start cell
+    Point end;                  // Exit cell
+    Point *items;               // Items cells
+    int itemCount;              // Items count
+    int biome;                  // Biome index
+    unsigned int seed;          // Generation seed
+    int algorithm;              // Generation algorithm (MazeGenAlgorithm)
+    int spacingRows;            // Grid algorithm rows spacing
+    int spacingCols;            // Grid algorithm columns spacing
+    float skipChance;           // Grid algorithm skip chance
+    bool mapped;                // Grid and items point to pack data (valid while pack is loaded)
+} MazeLevel;
+
+// Maze levels pack, loaded file data
+typedef struct MazePack {
+    unsigned char *data;        // File data (memory-mapped or read)
+    size_t size;                // File size in bytes
+    int levelCount;             // Levels in pack
+    bool mapped;                // Data is memory-mapped
+} MazePack;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+bool ExportMazeLevel(MazeLevel level, const char *fileName, int compression);   // Export level as single level pack
+bool ExportMazePack(const MazeLevel *levels, int levelCount, const char *fileName, int compression);  // Export levels pack
+MazePack LoadMazePack(const char *fileName);                        // Load levels pack (memory-mapped), levels data is not read
+void UnloadMazePack(MazePack pack);                                 // Unload levels pack (levels got from pack are not valid anymore)
+MazeLevel GetMazePackLevel(MazePack pack, int index);               // Get pack level, uncompressed levels point to pack data (zero-copy)
+MazeLevel LoadMazeLevel(const char *fileName, int index);           // Load pack level (level data is copied, pack is unloaded)
+void UnloadMazeLevel(MazeLevel level);                              // Unload level data (only if not pointing to pack data)
+
+#if defined(__cplusplus)
+}
+#endif
+
+/***********************************************************************************
+*
+*   MAZE FILE IMPLEMENTATION
+*
+************************************************************************************/
+#if defined(MAZE_IMPLEMENTATION)
+
+#include <stdio.h>                      // Required for: FILE, fopen(), fwrite(), fread(), fseek()
+#include <string.h>                     // Required for: memcpy(), memcmp(), memset()
+
+#if !defined(_WIN32)
+    #include <sys/mman.h>               // Required for: mmap(), munmap()
+    #include <sys/stat.h>               // Required for: fstat()
+    #include <fcntl.h>                  // Required for: open()
+    #include <unistd.h>                 // Required for: close()
+#endif
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Pack file header
+typedef struct MazeFileHeader {
+    char magic[4];              // "MZPK"
+    uint32_t version;           // MAZE_FILE_VERSION
+    uint32_t levelCount;        // Levels in pack
+    uint32_t reserved;          // Reserved (0)
+} MazeFileHeader;
+
+// Pack index entry
+typedef struct MazeFileEntry {
+    uint64_t offset;            // Level offset from file start (8 bytes aligned)
+    uint64_t size;              // Level size in bytes
+} MazeFileEntry;
+
+// Level header, followed by items and grid data
+typedef struct MazeFileLevel {
+    int32_t width;              // Maze width in cells
+    int32_t height;             // Maze height in cells
+    int32_t stride;             // Grid words per row
+    uint32_t seed;              // Generation seed
+    int32_t algorithm;          // Generation algorithm
+    int32_t spacingRows;        // Grid algorithm rows spacing
+    int32_t spacingCols;        // Grid algorithm columns spacing
+    float skipChance;           // Grid algorithm skip chance
+    int32_t biome;              // Biome index
+    int32_t startX;             // Start cell
+    int32_t startY;
+    int32_t endX;               // Exit cell
+    int32_t endY;
+    int32_t itemCount;          // Items count, items are stored as int32 x, y pairs
+    uint32_t compression;       // Grid compression (MazeFileCompression)
+    uint32_t reserved;          // Reserved (0)
+    uint64_t gridSize;          // Grid data size in bytes
+} MazeFileLevel;
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static size_t EncodeMazeRLE(const unsigned char *data, size_t size, unsigned char *output);     // Encode data (PackBits), output must hold size + size/128 + 1 bytes
+static bool DecodeMazeRLE(const unsigned char *data, size_t size, unsigned char *output, size_t outputSize);  // Decode data (PackBits), fails if output size does not match
+static bool WriteMazeFileLevel(FILE *file, MazeLevel level, int compression, uint64_t *size);  // Write level, returns written size (padded)
+static const MazeFileLevel *GetMazeFileLevel(MazePack pack, int index);  // Get level header, NULL if level data is not valid
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Export level as single level pack
+bool ExportMazeLevel(MazeLevel level, const char *fileName, int compression)
+{
+    return ExportMazePack(&level, 1, fileName, compression);
+}
+
+// Export levels pack
+// NOTE: Levels are written one by one, index is written once all levels sizes are known
+bool ExportMazePack(const MazeLevel *levels, int levelCount, const char *fileName, int compression)
+{
+    if ((levels == NULL) || (levelCount <= 0)) return false;
+
+    MazeFileEntry *entries = (MazeFileEntry *)MAZE_CALLOC(levelCount, sizeof(MazeFileEntry));
+    FILE *file = fopen(fileName, "wb");
+    bool success = (entries != NULL) && (file != NULL);
+
+    if (success)
+    {
+        MazeFileHeader header = { { 'M', 'Z', 'P', 'K' }, MAZE_FILE_VERSION, (uint32_t)levelCount, 0 };
+        uint64_t offset = sizeof(MazeFileHeader) + (uint64_t)levelCount*sizeof(MazeFileEntry);
+
+        success = (fwrite(&header, sizeof(MazeFileHeader), 1, file) == 1) &&
+                  (fwrite(entries, sizeof(MazeFileEntry), levelCount, file) == (size_t)levelCount);
+
+        for (int i = 0; success && (i < levelCount); i++)
+        {
+            entries[i].offset = offset;
+            success = WriteMazeFileLevel(file, levels[i], compression, &entries[i].size);
+            offset += entries[i].size;
+        }
+
+        success = success && (fseek(file, sizeof(MazeFileHeader), SEEK_SET) == 0) &&
+                  (fwrite(entries, sizeof(MazeFileEntry), levelCount, file) == (size_t)levelCount);
+    }
+
+    if ((file != NULL) && (fclose(file) != 0)) success = false;
+    MAZE_FREE(entries);
+
+    return success;
+}
+
+// Load levels pack (memory-mapped), levels data is not read
+// NOTE: Mapping is private and writable (copy-on-write), on Windows file is read into memory
+MazePack LoadMazePack(const char *fileName)
+{
+    MazePack pack = { 0 };
+
+#if !defined(_WIN32)
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0) return pack;
+
+    struct stat info = { 0 };
+
+    if ((fstat(fd, &info) == 0) && (info.st_size >= (off_t)sizeof(MazeFileHeader)))
+    {
+        void *data = mmap(NULL, (size_t)info.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+
+        if (data != MAP_FAILED)
+        {
+            pack.data = (unsigned char *)data;
+            pack.size = (size_t)info.st_size;
+            pack.mapped = true;
+        }
+    }
+
+    close(fd);
+#else
+    FILE *file = fopen(fileName, "rb");
+    if (file == NULL) return pack;
+
+    long size = ((fseek(file, 0, SEEK_END) == 0)? ftell(file) : -1);
+
+    if ((size >= (long)sizeof(MazeFileHeader)) && (fseek(file, 0, SEEK_SET) == 0))
+    {
+        pack.data = (unsigned char *)MAZE_MALLOC(size);
+
+        if ((pack.data != NULL) && (fread(pack.data, 1, size, file) == (size_t)size)) pack.size = (size_t)size;
+        else
+        {
+            MAZE_FREE(pack.data);
+            pack.data = NULL;
+        }
+    }
+
+    fclose(file);
+#endif
+
+    if (pack.data == NULL) return pack;
+
+    // Check header and index, levels are checked when requested
+    const MazeFileHeader *header = (const MazeFileHeader *)pack.data;
+    bool valid = (memcmp(header->magic, "MZPK", 4) == 0) && (header->version == MAZE_FILE_VERSION) && (header->levelCount <= 0x7fffffff) &&
+                 ((pack.size - sizeof(MazeFileHeader))/sizeof(MazeFileEntry) >= header->levelCount);
+
+    if (!valid)
+    {
+        UnloadMazePack(pack);
+        return (MazePack){ 0 };
+    }
+
+    pack.levelCount = (int)header->levelCount;
+
+    return pack;
+}
+
+// Unload levels pack (levels got from pack are not valid anymore)
+void UnloadMazePack(MazePack pack)
+{
+    if (pack.data == NULL) return;
+
+#if !defined(_WIN32)
+    if (pack.mapped) munmap(pack.data, pack.size);
+    else MAZE_FREE(pack.data);
+#else
+    MAZE_FREE(pack.data);
+#endif
+}
+
+// Get pack level, uncompressed levels point to pack data (zero-copy)
+// NOTE: Compressed levels are decoded into a new grid (level.mapped is false, must be unloaded)
+MazeLevel GetMazePackLevel(MazePack pack, int index)
+{
+    MazeLevel level = { 0 };
+    const MazeFileLevel *header = GetMazeFileLevel(pack, index);
+
+    if (header == NULL) return level;
+
+    unsigned char *items = (unsigned char *)header + sizeof(MazeFileLevel);
+    unsigned char *gridData = items + (size_t)header->itemCount*sizeof(Point);
+
+    level.start = (Point){ header->startX, header->startY };
+    level.end = (Point){ header->endX, header->endY };
+    level.itemCount = header->itemCount;
+    level.biome = header->biome;
+    level.seed = header->seed;
+    level.algorithm = header->algorithm;
+    level.spacingRows = header->spacingRows;
+    level.spacingCols = header->spacingCols;
+    level.skipChance = header->skipChance;
+
+    if (header->compression == MAZE_FILE_RAW)
+    {
+        level.grid = (MazeGrid){ header->width, header->height, header->stride, (uint64_t *)gridData };
+        level.items = (header->itemCount > 0)? (Point *)items : NULL;
+        level.mapped = true;
+    }
+    else
+    {
+        level.grid = LoadMazeGrid(header->width, header->height);
+        level.items = (header->itemCount > 0)? (Point *)MAZE_MALLOC((size_t)header->itemCount*sizeof(Point)) : NULL;
+
+        bool success = (level.grid.cells != NULL) && ((header->itemCount == 0) || (level.items != NULL)) &&
+                       DecodeMazeRLE(gridData, (size_t)header->gridSize, (unsigned char *)level.grid.cells, (size_t)level.grid.stride*level.grid.height*sizeof(uint64_t));
+
+        if (success && (level.items != NULL)) memcpy(level.items, items, (size_t)header->itemCount*sizeof(Point));
+        else if (!success)
+        {
+            UnloadMazeLevel(level);
+            level = (MazeLevel){ 0 };
+        }
+    }
+
+    return level;
+}
+
+// Load pack level (level data is copied, pack is unloaded)
+MazeLevel LoadMazeLevel(const char *fileName, int index)
+{
+    MazePack pack = LoadMazePack(fileName);
+    MazeLevel level = GetMazePackLevel(pack, index);
+
+    if (level.mapped)
+    {
+        MazeLevel copy = level;
+
+        copy.grid = LoadMazeGrid(level.grid.width, level.grid.height);
+        copy.items = (level.itemCount > 0)? (Point *)MAZE_MALLOC((size_t)level.itemCount*sizeof(Point)) : NULL;
+        copy.mapped = false;
+
+        if ((copy.grid.cells != NULL) && ((level.itemCount == 0) || (copy.items != NULL)))
+        {
+            memcpy(copy.grid.cells, level.grid.cells, (size_t)level.grid.stride*level.grid.height*sizeof(uint64_t));
+            if (copy.items != NULL) memcpy(copy.items, level.items, (size_t)level.itemCount*sizeof(Point));
+            level = copy;
+        }
+        else
+        {
+            UnloadMazeLevel(copy);
+            level = (MazeLevel){ 0 };
+        }
+    }
+
+    UnloadMazePack(pack);
+
+    return level;
+}
+
+// Unload level data (only if not pointing to pack data)
+void UnloadMazeLevel(MazeLevel level)
+{
+    if (level.mapped) return;
+
+    UnloadMazeGrid(level.grid);
+    MAZE_FREE(level.items);
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+// Encode data (PackBits), output must hold size + size/128 + 1 bytes
+// NOTE: Control byte n: [0..127] n + 1 literal bytes follow, [129..255] next byte is repeated 257 - n times
+static size_t EncodeMazeRLE(const unsigned char *data, size_t size, unsigned char *output)
+{
+    size_t outputSize = 0;
+    size_t i = 0;
+
+    while (i < size)
+    {
+        size_t run = 1;
+        while ((i + run < size) && (run < 128) && (data[i + run] == data[i])) run++;
+
+        if (run > 1)
+        {
+            output[outputSize++] = (unsigned char)(257 - run);
+            output[outputSize++] = data[i];
+            i += run;
+        }
+        else
+        {
+            // Literals until next run of 3 or more bytes (shorter runs would not reduce size)
+            size_t count = 1;
+            while ((i + count < size) && (count < 128) &&
+                   !((i + count + 2 < size) && (data[i + count] == data[i + count + 1]) && (data[i + count] == data[i + count + 2]))) count++;
+
+            output[outputSize++] = (unsigned char)(count - 1);
+            memcpy(output + outputSize, data + i, count);
+            outputSize += count;
+            i += count;
+        }
+    }
+
+    return outputSize;
+}
+
+// Decode data (PackBits), fails if output size does not match
+static bool DecodeMazeRLE(const unsigned char *data, size_t size, unsigned char *output, size_t outputSize)
+{
+    size_t i = 0;
+    size_t written = 0;
+
+    while (i < size)
+    {
+        unsigned char control = data[i++];
+
+        if (control < 128)
+        {
+            size_t count = (size_t)control + 1;
+            if ((i + count > size) || (written + count > outputSize)) return false;
+
+            memcpy(output + written, data + i, count);
+            i += count;
+            written += count;
+        }
+        else if (control > 128)
+        {
+            size_t count = 257 - (size_t)control;
+            if ((i >= size) || (written + count > outputSize)) return false;
+
+            memset(output + written, data[i++], count);
+            written += count;
+        }
+    }
+
+    return (written == outputSize);
+}
+
+// Write level, returns written size (padded)
+// NOTE: Grid is written uncompressed if RLE does not reduce its size (i.e. perfect mazes, no long runs)
+// NOTE: Level size is padded to 8 bytes, next level grid words keep aligned
+static bool WriteMazeFileLevel(FILE *file, MazeLevel level, int compression, uint64_t *size)
+{
+    if ((level.grid.cells == NULL) || (level.itemCount < 0) || ((level.itemCount > 0) && (level.items == NULL))) return false;
+
+    const unsigned char *gridData = (const unsigned char *)level.grid.cells;
+    size_t gridSize = (size_t)level.grid.stride*level.grid.height*sizeof(uint64_t);
+    unsigned char *encoded = NULL;
+
+    if (compression == MAZE_FILE_RLE)
+    {
+        encoded = (unsigned char *)MAZE_MALLOC(gridSize + gridSize/128 + 1);
+        if (encoded == NULL) return false;
+
+        size_t encodedSize = EncodeMazeRLE(gridData, gridSize, encoded);
+
+        if (encodedSize < gridSize)
+        {
+            gridSize = encodedSize;
+            gridData = encoded;
+        }
+        else compression = MAZE_FILE_RAW;
+    }
+    else compression = MAZE_FILE_RAW;
+
+    MazeFileLevel header = { 0 };
+    header.width = level.grid.width;
+    header.height = level.grid.height;
+    header.stride = level.grid.stride;
+    header.seed = level.seed;
+    header.algorithm = level.algorithm;
+    header.spacingRows = level.spacingRows;
+    header.spacingCols = level.spacingCols;
+    header.skipChance = level.skipChance;
+    header.biome = level.biome;
+    header.startX = level.start.x;
+    header.startY = level.start.y;
+    header.endX = level.end.x;
+    header.endY = level.end.y;
+    header.itemCount = level.itemCount;
+    header.compression = (uint32_t)compression;
+    header.gridSize = gridSize;
+
+    static const unsigned char padding[8] = { 0 };
+    size_t levelSize = sizeof(MazeFileLevel) + (size_t)level.itemCount*sizeof(Point) + gridSize;
+    size_t paddingSize = (8 - levelSize%8)%8;
+
+    bool success = (fwrite(&header, sizeof(MazeFileLevel), 1, file) == 1) &&
+                   ((level.itemCount == 0) || (fwrite(level.items, sizeof(Point), level.itemCount, file) == (size_t)level.itemCount)) &&
+                   (fwrite(gridData, 1, gridSize, file) == gridSize) &&
+                   ((paddingSize == 0) || (fwrite(padding, 1, paddingSize, file) == paddingSize));
+
+    MAZE_FREE(encoded);
+    *size = levelSize + paddingSize;
+
+    return success;
+}
+
+// Get level header, NULL if level data is not valid
+// NOTE: Level bounds, alignment and grid size are checked, level data is not read
+static const MazeFileLevel *GetMazeFileLevel(MazePack pack, int index)
+{
+    if ((pack.data == NULL) || (index < 0) || (index >= pack.levelCount)) return NULL;
+
+    const MazeFileEntry *entry = (const MazeFileEntry *)(pack.data + sizeof(MazeFileHeader)) + index;
+
+    if ((entry->offset%8 != 0) || (entry->offset > pack.size) || (entry->size > pack.size - entry->offset) ||
+        (entry->size < sizeof(MazeFileLevel))) return NULL;
+
+    const MazeFileLevel *header = (const MazeFileLevel *)(pack.data + entry->offset);
+    uint64_t gridSize = (uint64_t)header->stride*(uint64_t)header->height*sizeof(uint64_t);
+
+    if ((header->width <= 0) || (header->height <= 0) || (header->stride != (header->width + 63)/64) || (header->itemCount < 0)) return NULL;
+    if ((header->compression == MAZE_FILE_RAW) && (header->gridSize != gridSize)) return NULL;
+    if ((header->compression != MAZE_FILE_RAW) && (header->compression != MAZE_FILE_RLE)) return NULL;
+    if ((header->gridSize > entry->size) || ((uint64_t)header->itemCount*sizeof(Point) + header->gridSize > entry->size - sizeof(MazeFileLevel))) return NULL;
+
+    return header;
+}
+
+#endif // MAZE_IMPLEMENTATION
+
+#endif // MAZE_FILE_H
@@ -16,11 +16,34 @@
 #include "raygui.h"                     // Required for immediate-mode UI elements
 #include <stdlib.h>                     // Required for: malloc(), free()
 #include "raymath.h"
-
-#define MAZE_WIDTH          64
-#define MAZE_HEIGHT         64
-#define MAZE_DRAW_SCALE     8.0f
+#define MAZE_IMPLEMENTATION
+#include "maze.h"                       // Required for: Point, MazeGrid, GenMazeGridEx(), IsMazeWall()
+#include "maze_path.h"                  // Required for: PathFinder, FindPath(), PathPlanner, FlowField
+#include "maze_analysis.h"              // Required for: MazeAnalyzer, RepairMazeConnectivity()
+#include "maze_gen.h"                   // Required for: GenMazeGridAlgorithm()
+#include "maze_stream.h"                // Required for: MazeStream, IsMazeStreamWall()
+#include "maze_render.h"                // Required for: MazeRenderer, MazeModel, MazeStreamModel
+#include "maze_bundle.h"                // Required for: MazeBundleLoader, StartMazeBundle()
+#include "maze_file.h"                  // Required for: MazeLevel, ExportMazeLevel(), LoadMazeLevel()
+#include "maze_export.h"                // Required for: MazeExporter, StartMazeExport()
+#include "maze_items.h"                 // Required for: MazeItems, PickMazeItem(), GenMazeItems()
+#include "maze_sim.h"                   // Required for: MazeSim, StepMazeSim(), MazeSimRecording
+#include "maze_prof.h"                  // Required for: MazeProfiler, DrawMazeProfiler()
+
+#define MAZE_DEFAULT_SIZE   64          // Default maze width and height
+#define MIN_MAZE_SIZE       5
+#define MAX_MAZE_SIZE       16384
+#define MAX_MODEL_CELLS     (512*512)   // Maximum maze cells to generate the 3D model (cubicmap)
+#define MAZE_EDITOR_VIEW    512.0f      // Editor maze viewport size (screen pixels)
+#define MAZE_DRAW_SCALE     8.0f        // Editor maximum initial scale (screen pixels per cell)
 #define MAZE_2D_DRAW_SCALE  64.0f
+#define MAZE_CHUNK_SIZE     16          // 2D renderer chunk size in cells (chunk texture: 16*64 pixels)
+#define MAZE_CHUNK_CACHE    16          // 2D renderer baked chunks kept in VRAM
+#define MAZE_MODEL_CHUNK    32          // 3D model chunk size in cells (rebuilt when a cell changes)
+#define MAZE_PREVIEW_RATE   30.0f       // Editor 3D preview maximum redraws per second
+#define MAZE_PREVIEW_FULLRES_CELLS  (256*256)   // Maximum maze cells for full resolution editor 3D preview
+#define MAZE_STREAM_WINDOW  8           // Endless mode chunks kept around player (per side, 64 cells per chunk)
+#define MAZE_STREAM_BUILDS  2           // Endless mode chunk 3D models generated per frame
 #define MAZE_SPACING_ROWS   3
 #define MAZE_SPACING_COLS   3
 
@@ -29,21 +52,11 @@
 #define MODE_GAME3D     1
 #define MODE_EDITOR     2
 
-#define MAX_MAZE_ITEMS      16
+#define MAX_MAZE_ITEMS      65536   // Maximum items per maze
+#define MAZE_ITEMS_BULK     1024    // Items placed per editor bulk placement (B key)
+#define MAZE_ITEMS_VIEW_DISTANCE    96.0f   // 3D mode items draw distance (cells)
 #define MAX_TIME			120
-
-// Declare new data type: Point
-typedef struct Point {
-int x;
-int y;
-} Point;
-
-// Generate procedural maze image, using grid-based algorithm
-// NOTE: Functions defined as static are internal to the module
-static Image GenImageMaze(int width, int height, int spacingRows, int spacingCols, float skipChance);
-
-// Get shorter path between two points, implements pathfinding algorithm: A*
-static Point *LoadPathAStar(Image map, Point start, Point end, int *pointCount);
+#define MAX_SIM_FRAME_TIME  0.25f   // Maximum frame time simulated (longer frames slow down the game instead of skipping)
 
 //----------------------------------------------------------------------------------
 // Main entry point
@@ -73,23 +86,38 @@ int currentMode = 2;    // 0-Game2D, 1-Game3D, 2-Editor
 // always the same if using the same seed
 SetRandomSeed(67218);
 
-// Generate maze image using the grid-based generator
+// Maze seed, the generator does not use the global random state,
+// the same seed always generates the same maze
+unsigned int mazeSeed = 67218;
+
+// Generate maze grid using the grid-based generator
 // DONE: [1p] Improve function to support extra configuration parameters 
-Image imMaze = GenImageMaze(MAZE_WIDTH, MAZE_HEIGHT,MAZE_SPACING_ROWS,MAZE_SPACING_COLS, 0.75f);
+// NOTE: gridMaze is the authoritative maze data (1 bit per cell), imMaze is only used for display
+MazeGrid gridMaze = GenMazeGrid(MAZE_DEFAULT_SIZE, MAZE_DEFAULT_SIZE,MAZE_SPACING_ROWS,MAZE_SPACING_COLS, 0.75f, mazeSeed);
+
+// Connect walkable regions to start cell through the nearest interior walls (greedy, not a global minimum), maze is always solvable
+// NOTE: Border walls are kept, generated mazes have no region only reachable through them
+MazeAnalyzer mazeAnalyzer = LoadMazeAnalyzer(gridMaze.width, gridMaze.height);
+RepairMazeConnectivity(&mazeAnalyzer, &gridMaze, (Point){ 1, 1 }, (Point){ gridMaze.width - 2, gridMaze.height - 2 });
+UnloadMazeAnalyzer(mazeAnalyzer);
+
+Image imMaze = LoadImageFromMazeGrid(gridMaze);
 
 // Load a texture to be drawn on screen from our image data
-// WARNING: If imMaze pixel data is modified, texMaze needs to be re-loaded
+// WARNING: If gridMaze is modified, imMaze, texMaze and mdlMaze need to be updated (only changed region)
 Texture texMaze = LoadTextureFromImage(imMaze);
     
 
-// Generate 3D mesh from image and load a 3D model from mesh 
-Mesh meshMaze = GenMeshCubicmap(imMaze, (Vector3){ 1.0f, 1.0f, 1.0f });
-Model mdlMaze = LoadModelFromMesh(meshMaze);
+// Generate 3D meshes from maze grid and load a 3D model (one model per chunk)
+// NOTE: Coplanar faces are merged (greedy meshing), press M in editor to compare it with GenMeshCubicmap()
+// NOTE: Model memory and draw calls grow with maze size, big mazes have no 3D model (3D mode disabled)
+MazeModel mdlMaze = { 0 };
+if (gridMaze.width*gridMaze.height <= MAX_MODEL_CELLS) mdlMaze = LoadMazeModel(gridMaze, MAZE_MODEL_CHUNK);
 Vector3 mdlPosition = { 0.0f, 0.0f, 0.0f };  // Set model position
 
 // Start and end cell positions (user defined)
 Point startCell = { 1, 1 };
-Point endCell = { imMaze.width - 2, imMaze.height -2 };
+Point endCell = { gridMaze.width - 2, gridMaze.height -2 };
 
 // Player current position on image-coordinates
 // WARNING: It could require conversion to world coordinates!
@@ -110,25 +138,37 @@ Camera2D camera2d = { (Vector2) {screenWidth/2,screenHeight/2 },(Vector2) { play
 Camera3D cameraFP = { (Vector3) { playerX, 0.5f, playerY}, (Vector3) { 2.0f,0.5f,1.0f}, (Vector3) { 0.0f,1.0f,0.0f }, 90.0f,CAMERA_PERSPECTIVE};
 
 
-//OrbitalCam
-Camera3D cameraOrbit = { (Vector3) { 70.0f, 40.0f, 70.0f }, (Vector3) { MAZE_WIDTH/2, 0, MAZE_HEIGHT/2}, (Vector3) { 0.0f, 2.0f, 0.0f }, 45.0f, CAMERA_PERSPECTIVE };
+//OrbitalCam, looking at maze center from a distance proportional to maze size
+float mazeSize = (float)((gridMaze.width > gridMaze.height)? gridMaze.width : gridMaze.height);
+Camera3D cameraOrbit = { (Vector3) { gridMaze.width/2 + mazeSize*0.6f, mazeSize*0.6f, gridMaze.height/2 + mazeSize*0.6f }, (Vector3) { gridMaze.width/2, 0, gridMaze.height/2}, (Vector3) { 0.0f, 2.0f, 0.0f }, 45.0f, CAMERA_PERSPECTIVE };
 
 
 
 // Mouse selected cell for maze editing
 Point selectedCell = { 0 };
+Rectangle dirtyRec = { 0 };     // Maze cells changed by the editor this frame, pending upload to texMaze and mdlMaze
 
-// Maze items position and state
-Point mazeItems[MAX_MAZE_ITEMS] = { 0 };
-bool mazeItemPicked[MAX_MAZE_ITEMS] = { 0 };
-for(int i = 0; i < MAX_MAZE_ITEMS; i++) mazeItemPicked[i] = true;
-int mazeItemsCounter = 0;
+// Maze items position and state, indexed by cell (pickup, placement and removal do not scan items)
+MazeItems mazeItems = LoadMazeItems(gridMaze.width, gridMaze.height, 16);
 Texture texItem = LoadTexture("resources/item_atlas01.png");
+MazeItemsRenderer itemsRenderer = LoadMazeItemsRenderer();     // Items drawn culled by view, instanced in 3D
     
 // Player points and time
 int playerPoints = 0;
 float gameTime = MAX_TIME;
 
+// Player simulation, fixed steps (MAZE_SIM_RATE per second) from inputs, authoritative in game modes
+// NOTE: playerX, playerY, playerCell, playerPoints and gameTime are updated from simulation every frame
+MazeSimConfig simConfig = { MAZE_SIM_VIEW_2D, startCell, endCell, playerSpeed, collisionRadius, MAX_TIME };
+MazeSim sim = InitMazeSim(gridMaze, &mazeItems, simConfig);
+MazeSimInput simInput = { 0 };  // Input of next step, view switch and look movement are kept until a step uses them
+float simAccumulator = 0.0f;    // Frame time not simulated yet
+
+// Sessions recording (toggled with KEY_V), recorded sessions are exported when they end
+MazeSimRecording simRecording = { 0 };
+bool recordSessions = false;
+bool sessionRecording = false;  // Current session is being recorded
+
 // Define textures to be used as our "biomes"
 // DONE: Load additional textures for different biomes
 Texture texBiomes[4] = { 0 };
@@ -144,30 +184,107 @@ double centerY = GetScreenHeight() / 2;
 
 double posMaze2Dx = centerX / 2;
 double posMaze2Dy = centerY;
-Vector2 mazeOffset2D = {posMaze2Dx - texMaze.width / 2 * MAZE_DRAW_SCALE,
-                        posMaze2Dy - texMaze.height / 2 * MAZE_DRAW_SCALE};
+Vector2 mazeOffset2D = {posMaze2Dx - MAZE_EDITOR_VIEW / 2,
+                        posMaze2Dy - MAZE_EDITOR_VIEW / 2};
 
 double posMaze3Dx = GetScreenWidth() - posMaze2Dx;
 double posMaze3Dy = posMaze2Dy;
-Vector2 mazeOffset3D = {posMaze3Dx - texMaze.width / 2 * MAZE_DRAW_SCALE,
-                        posMaze3Dy - texMaze.height / 2 * MAZE_DRAW_SCALE};
+Vector2 mazeOffset3D = {posMaze3Dx - MAZE_EDITOR_VIEW / 2,
+                        posMaze3Dy - MAZE_EDITOR_VIEW / 2};
 
+// Editor maze viewport, maze is drawn using editorCamera (world units are cells)
+// NOTE: Mouse wheel zooms at mouse position, middle button drag pans the view,
+// initial zoom fits the whole maze in the viewport (up to MAZE_DRAW_SCALE pixels per cell)
+Rectangle editorView = { mazeOffset2D.x, mazeOffset2D.y, MAZE_EDITOR_VIEW, MAZE_EDITOR_VIEW };
+Camera2D editorCamera = { mazeOffset2D, (Vector2){ 0.0f, 0.0f }, 0.0f, fminf(MAZE_DRAW_SCALE, MAZE_EDITOR_VIEW/mazeSize) };
 
-//orbit target texture
-RenderTexture2D targetTexture = LoadRenderTexture(MAZE_WIDTH * MAZE_DRAW_SCALE, MAZE_HEIGHT * MAZE_DRAW_SCALE);
+// Editor 3D preview (orbit camera), only redrawn when model, biome, camera or cells change
+// NOTE: Huge mazes are previewed at half resolution, orbit rotation toggled with KEY_R
+MazePreview mazePreview = LoadMazePreview(MAZE_EDITOR_VIEW, MAZE_EDITOR_VIEW, (gridMaze.width*gridMaze.height > MAZE_PREVIEW_FULLRES_CELLS)? 0.5f : 1.0f, MAZE_PREVIEW_RATE);
+bool orbitPreview = true;
 
 // TODO: Define all variables required for UI editor (raygui)
 
 //TEXT BOX TO SET THE WIDTH OF THE MAZE
 static char xSpacing[4] = "3"; // Increase array size to allow larger numbers
 static char ySpacing[4] = "3"; // Increase array size to allow larger numbers
+static char mazeWidthText[6] = "64";    // Maze width used on reload [MIN_MAZE_SIZE..MAX_MAZE_SIZE]
+static char mazeHeightText[6] = "64";   // Maze height used on reload [MIN_MAZE_SIZE..MAX_MAZE_SIZE]
 
 bool activeXSpacing = false; // Flag for xSpacing textbox activity
 bool activeYSpacing = false; // Flag for ySpacing textbox activity
+bool activeWidth = false;    // Flag for mazeWidthText textbox activity
+bool activeHeight = false;   // Flag for mazeHeightText textbox activity
 
 // variables for pathfinding
+// NOTE: Path points are owned by pathFinder, search data is reused between queries
+PathFinder pathFinder = LoadPathFinder(gridMaze.width, gridMaze.height);
+int pathAlgorithm = PATH_ASTAR;     // Selected in editor: PATH_ASTAR or PATH_JPS
+int mazeAlgorithm = MAZE_GEN_GRID;  // Selected in editor, used on Reload Maze (MazeGenAlgorithm)
 int pointCount = 0;
-Point* path = NULL;
+const Point* path = NULL;
+
+// variables for live path to exit (toggled with KEY_P)
+// NOTE: Planner keeps its search between frames, it is only repaired when playerCell
+// moves or the editor changes a cell, path points are owned by pathPlanner
+// NOTE: Planner memory grows with maze size, it is only loaded while the live path is shown
+PathPlanner pathPlanner = { 0 };
+bool showLivePath = false;
+int livePointCount = 0;
+const Point* livePath = NULL;
+
+// variables for distance to exit (flow field from endCell)
+// NOTE: Distances are computed once per maze, editor changes only recompute affected cells
+FlowField flowField = LoadFlowField(gridMaze.width, gridMaze.height);
+ComputeFlowField(&flowField, gridMaze, endCell, 1);
+
+// 2D maze renderer, maze chunks visible by camera2d are baked into render textures and cached
+// NOTE: Editor changes must be notified to re-bake the changed chunks
+MazeRenderer mazeRenderer = LoadMazeRenderer(gridMaze.width, gridMaze.height, MAZE_CHUNK_SIZE, MAZE_2D_DRAW_SCALE, MAZE_CHUNK_CACHE);
+
+// Endless mode (toggled with KEY_E in game modes), maze chunks generated around playerCell
+// NOTE: Only a window of chunks is kept in memory, chunks are generated by a worker thread
+// and 3D chunk models are generated a few per frame, cost does not depend on distance travelled
+bool endlessMode = false;
+MazeStream mazeStream = { 0 };
+MazeStreamModel mdlStream = { 0 };
+
+// Reload Maze background generation, new maze is swapped in when generated
+// NOTE: Maze in use is kept (played, edited and drawn) until the new maze is ready
+MazeBundleLoader mazeLoader = { 0 };
+
+// Current maze generation parameters, saved with the level (Save Maze)
+MazeBundleConfig mazeConfig = { .width = MAZE_DEFAULT_SIZE, .height = MAZE_DEFAULT_SIZE, .spacingRows = MAZE_SPACING_ROWS, .spacingCols = MAZE_SPACING_COLS,
+    .skipChance = 0.75f, .seed = mazeSeed, .algorithm = MAZE_GEN_GRID, .modelChunk = MAZE_MODEL_CHUNK, .maxModelCells = MAX_MODEL_CELLS, .repair = true };
+
+// Level file dropped on window (.mzl), its grid is swapped in by mazeLoader,
+// start cell, items and biome are applied when swapped
+MazeLevel droppedLevel = { 0 };
+bool levelDropped = false;
+
+// Save Maze 3D mesh export, chunks meshes are streamed to file by a worker thread
+// NOTE: Memory used does not depend on maze size, editing continues while exporting (grid copied)
+MazeExporter mazeExporter = { 0 };
+int exportFormat = MAZE_EXPORT_OBJ;     // Selected in editor: MAZE_EXPORT_OBJ or MAZE_EXPORT_GLB
+
+// Frame phases profiler, overlay toggled with KEY_O, statistics exported with KEY_L
+// NOTE: Drawing phases only measure CPU time (commands submission)
+MazeProfiler profiler = { 0 };
+int profFrame = AddMazeProfilerZone(&profiler, "frame");
+int profUpdate = AddMazeProfilerZone(&profiler, "update");
+int profSim = AddMazeProfilerZone(&profiler, "simulation");
+int profCollision = AddMazeProfilerZone(&profiler, "collision");
+int profItems = AddMazeProfilerZone(&profiler, "items");
+int profPath = AddMazeProfilerZone(&profiler, "path");
+int profMesh = AddMazeProfilerZone(&profiler, "mesh");
+int profDraw2D = AddMazeProfilerZone(&profiler, "draw 2D");
+int profOrbit = AddMazeProfilerZone(&profiler, "orbit view");
+bool showProfiler = false;
+
+// Simulation steps time collision and items pickup zones (one sample per step)
+sim.profiler = &profiler;
+sim.profCollision = profCollision;
+sim.profItems = profItems;
 
 
 SetTargetFPS(60);       // Set our game to run at 60 frames-per-second
@@ -176,106 +293,268 @@ SetTargetFPS(60);       // Set our game to run at 60 frames-per-second
 // Main game loop
 while (!WindowShouldClose())    // Detect window close button or ESC key
 {
+    BeginMazeProfilerZone(&profiler, profFrame);
+
     // Update
     //----------------------------------------------------------------------------------
+    BeginMazeProfilerZone(&profiler, profUpdate);
+
     // Select current mode as desired
 
     
     UpdateMusicStream(music);
-    if (IsKeyPressed(KEY_Z) && currentMode != 0)
+
+    // Reload Maze: swap maze in use when the new maze bundle is generated
+    // NOTE: Generation runs on a worker thread, only GPU upload and swap are done here
+    MazeBundle mazeBundle = { 0 };
+    if (TakeMazeBundle(&mazeLoader, &mazeBundle))
+    {
+        BeginMazeProfilerZone(&profiler, profMesh);
+        bool uploaded = UploadMazeBundle(&mazeBundle);
+        EndMazeProfilerZone(&profiler, profMesh);
+
+        if (!uploaded)
+        {
+            TraceLog(LOG_WARNING, "MAZE: Maze generation failed, current maze kept");
+            UnloadMazeBundle(mazeBundle);
+            UnloadMazeLevel(droppedLevel);
+            droppedLevel = (MazeLevel){ 0 };
+            levelDropped = false;
+        }
+        else
+        {
+            UnloadMazeGrid(gridMaze);
+            UnloadImage(imMaze);
+            UnloadTexture(texMaze);
+            UnloadMazeModel(mdlMaze);
+            UnloadFlowField(flowField);
+            gridMaze = mazeBundle.grid;
+            imMaze = mazeBundle.image;
+            texMaze = mazeBundle.texture;
+            mdlMaze = mazeBundle.model;
+            flowField = mazeBundle.flowField;
+            endCell = mazeBundle.endCell;
+            mazeSeed = mazeBundle.config.seed;
+            mazeConfig = mazeBundle.config;
+            dirtyRec = (Rectangle){ 0 };
+
+            // Maze size could change: editor view and orbit camera depend on it
+            mazeSize = (float)((gridMaze.width > gridMaze.height)? gridMaze.width : gridMaze.height);
+            editorCamera = (Camera2D){ mazeOffset2D, (Vector2){ 0.0f, 0.0f }, 0.0f, fminf(MAZE_DRAW_SCALE, MAZE_EDITOR_VIEW/mazeSize) };
+            cameraOrbit.target = (Vector3){ gridMaze.width/2, 0, gridMaze.height/2 };
+            cameraOrbit.position = (Vector3){ gridMaze.width/2 + mazeSize*0.6f, mazeSize*0.6f, gridMaze.height/2 + mazeSize*0.6f };
+            startCell = (Point){ 1, 1 };
+            if (levelDropped && (droppedLevel.start.x > 0) && (droppedLevel.start.y > 0) &&
+                (droppedLevel.start.x < gridMaze.width) && (droppedLevel.start.y < gridMaze.height)) startCell = droppedLevel.start;
+            playerCell = startCell;
+            playerX = playerCell.x;
+            playerY = playerCell.y;
+            UnloadMazeItems(mazeItems);
+            mazeItems = LoadMazeItems(gridMaze.width, gridMaze.height, 16);
+            if (levelDropped)
+            {
+                // Dropped level items and biome
+                for (int i = 0; (i < droppedLevel.itemCount) && (mazeItems.count < MAX_MAZE_ITEMS); i++)
+                    AddMazeItem(&mazeItems, droppedLevel.items[i].x, droppedLevel.items[i].y);
+                if ((droppedLevel.biome >= 0) && (droppedLevel.biome < 4)) currentBiome = droppedLevel.biome;
+                UnloadMazeLevel(droppedLevel);
+                droppedLevel = (MazeLevel){ 0 };
+                levelDropped = false;
+            }
+
+            // Player session restarts on the new maze, its recording is discarded
+            sim.grid = gridMaze;
+            sim.config.view = sim.view;
+            sim.config.start = startCell;
+            sim.config.end = endCell;
+            ResetMazeSim(&sim);
+            sessionRecording = false;
+            path = NULL;
+            pointCount = 0;
+            UnloadPathPlanner(pathPlanner);
+            pathPlanner = (PathPlanner){ 0 };
+            if (showLivePath)
+            {
+                pathPlanner = LoadPathPlanner(gridMaze.width, gridMaze.height);
+                ResetPathPlanner(&pathPlanner, playerCell, endCell);
+            }
+            UnloadMazeRenderer(mazeRenderer);
+            mazeRenderer = LoadMazeRenderer(gridMaze.width, gridMaze.height, MAZE_CHUNK_SIZE, MAZE_2D_DRAW_SCALE, MAZE_CHUNK_CACHE);
+            SetMazePreviewResolution(&mazePreview, (gridMaze.width*gridMaze.height > MAZE_PREVIEW_FULLRES_CELLS)? 0.5f : 1.0f);
+            SetMazePreviewDirty(&mazePreview);
+
+            TraceLog(LOG_INFO, "MAZE: Maze %ix%i (%s) generated: grid %.2f ms, repair %.2f ms, image %.2f ms, meshes %.2f ms, flow %.2f ms, upload %.2f ms",
+                gridMaze.width, gridMaze.height, GetMazeGenAlgorithmName(mazeBundle.config.algorithm),
+                mazeBundle.phaseTime[MAZE_BUNDLE_GRID]*1000.0, mazeBundle.phaseTime[MAZE_BUNDLE_REPAIR]*1000.0, mazeBundle.phaseTime[MAZE_BUNDLE_IMAGE]*1000.0,
+                mazeBundle.phaseTime[MAZE_BUNDLE_MESHES]*1000.0, mazeBundle.phaseTime[MAZE_BUNDLE_FLOW]*1000.0,
+                mazeBundle.phaseTime[MAZE_BUNDLE_UPLOAD]*1000.0);
+        }
+    }
+
+    // Save Maze: 3D mesh export finished
+    MazeExportResult exportResult = { 0 };
+    if (TakeMazeExport(&mazeExporter, &exportResult))
     {
-        currentMode = 0;   // Game 2D mode
-        playerPoints = 0;
-        playerX = playerCell.x + 0.5f;   // correct player X position
-        playerY = playerCell.y + 0.5f;	 // correct player Y position
+        if (exportResult.success) TraceLog(LOG_INFO, "MAZE: 3D mesh exported: %lld vertices, %lld triangles, %lld bytes, %.2f ms",
+            exportResult.vertexCount, exportResult.triangleCount, exportResult.fileSize, exportResult.time*1000.0);
+        else TraceLog(LOG_WARNING, "MAZE: Failed to export 3D mesh");
     }
-    else if (IsKeyPressed(KEY_X) && currentMode != 1)
+
+    // Game modes entered from editor start a new player session at start cell (points, items and time reset),
+    // switching between game modes keeps the session (view switched by the next simulation step)
+    int sessionView = -1;
+    bool sessionLeft = false;
+    if (IsKeyPressed(KEY_Z) && currentMode != MODE_GAME2D)
     {
-        playerX = playerCell.x;  // correct player X position
-        playerY = playerCell.y;	 // correct player Y position
-        currentMode = 1 ;  // Game 3D mode
+        if (currentMode == MODE_EDITOR) sessionView = MAZE_SIM_VIEW_2D;
+        else simInput.keys |= MAZE_SIM_INPUT_SWITCH;
+        currentMode = MODE_GAME2D;
     }
-    else if (IsKeyPressed(KEY_C) && currentMode != 2)
+    else if (IsKeyPressed(KEY_X) && currentMode != MODE_GAME3D && (mdlMaze.chunks != NULL || endlessMode))
     {
-        playerCell = startCell;
-        playerX = playerCell.x;
-        playerY = playerCell.y;
-        currentMode = 2;  // Editor mode
+        if (currentMode == MODE_EDITOR) sessionView = MAZE_SIM_VIEW_3D;
+        else simInput.keys |= MAZE_SIM_INPUT_SWITCH;
+        currentMode = MODE_GAME3D;
     }
-    if(currentMode == 0 || currentMode == 1)
+    else if (IsKeyPressed(KEY_C) && currentMode != MODE_EDITOR)
     {
-        gameTime -= GetFrameTime();
-        if(gameTime <= 0)
+        sessionLeft = true;
+        currentMode = MODE_EDITOR;
+    }
+
+    if (sessionView >= 0)
+    {
+        sim.grid = gridMaze;
+        sim.config.view = sessionView;
+        sim.config.start = startCell;
+        sim.config.end = endCell;
+        ResetMazeSim(&sim);
+        simInput = (MazeSimInput){ 0 };
+        simAccumulator = 0.0f;
+
+        sessionRecording = recordSessions;
+        if (sessionRecording) BeginMazeSimRecording(&simRecording, sim);
+    }
+
+    if (IsKeyPressed(KEY_V))
+    {
+        recordSessions = !recordSessions;
+        TraceLog(LOG_INFO, "MAZE: Sessions recording %s", recordSessions? "enabled (from next session)" : "disabled");
+    }
+
+    // Endless mode: start from first cell of the world, back to the edited maze when leaving game modes
+    // NOTE: Endless mode sessions are not recorded, world chunks are generated asynchronously
+    if (IsKeyPressed(KEY_E) && (currentMode == MODE_GAME2D || currentMode == MODE_GAME3D) && !endlessMode)
+    {
+        endlessMode = true;
+        mazeStream = LoadMazeStream(mazeSeed, MAZE_STREAM_WINDOW);
+        mdlStream = LoadMazeStreamModel(mazeStream);
+        sim.stream = &mazeStream;
+        SetMazeSimPosition(&sim, 1.0f + ((sim.view == MAZE_SIM_VIEW_2D)? 0.5f : 0.0f), 1.0f + ((sim.view == MAZE_SIM_VIEW_2D)? 0.5f : 0.0f));
+        sessionRecording = false;
+    }
+    else if (endlessMode && (IsKeyPressed(KEY_E) || currentMode == MODE_EDITOR))
+    {
+        endlessMode = false;
+        UnloadMazeStream(mazeStream);
+        UnloadMazeStreamModel(mdlStream);
+        mazeStream = (MazeStream){ 0 };
+        mdlStream = (MazeStreamModel){ 0 };
+        sim.stream = NULL;
+        SetMazeSimPosition(&sim, startCell.x + ((sim.view == MAZE_SIM_VIEW_2D)? 0.5f : 0.0f), startCell.y + ((sim.view == MAZE_SIM_VIEW_2D)? 0.5f : 0.0f));
+    }
+
+    // DONE: [2p] Player 2D movement from predefined start point (A) to end point (B)
+    // DONE: [1p] Camera 3D system and 3D maze mode
+    // Player movement, collisions (gridMaze cells or endless mode world), items pickup, time limit
+    // and exit detection are advanced by the simulation in fixed steps, from frame input
+    if (currentMode == MODE_GAME2D || currentMode == MODE_GAME3D)
+    {
+        unsigned char keys = 0;
+        if (IsKeyDown(KEY_W) || IsKeyDown(KEY_UP)) keys |= MAZE_SIM_INPUT_UP;
+        if (IsKeyDown(KEY_S) || IsKeyDown(KEY_DOWN)) keys |= MAZE_SIM_INPUT_DOWN;
+        if (IsKeyDown(KEY_A) || IsKeyDown(KEY_LEFT)) keys |= MAZE_SIM_INPUT_LEFT;
+        if (IsKeyDown(KEY_D) || IsKeyDown(KEY_RIGHT)) keys |= MAZE_SIM_INPUT_RIGHT;
+        simInput.keys = (simInput.keys & MAZE_SIM_INPUT_SWITCH) | keys;
+
+        if (currentMode == MODE_GAME3D)
         {
-            currentMode = 2;
-            playerCell = startCell;
-            playerX = playerCell.x;
-            playerY = playerCell.y;
-            gameTime = MAX_TIME;
+            Vector2 mouseDelta = GetMouseDelta();
+            simInput.lookX = (short)Clamp(simInput.lookX + mouseDelta.x, -32767.0f, 32767.0f);
+            simInput.lookY = (short)Clamp(simInput.lookY + mouseDelta.y, -32767.0f, 32767.0f);
         }
+
+        simAccumulator += fminf(GetFrameTime(), MAX_SIM_FRAME_TIME);
+
+        BeginMazeProfilerZone(&profiler, profSim);
+        sim.grid = gridMaze;
+        while ((simAccumulator >= MAZE_SIM_STEP) && (sim.state == MAZE_SIM_RUNNING))
+        {
+            StepMazeSim(&sim, simInput);
+            if (sessionRecording) AddMazeSimRecordingInput(&simRecording, simInput);
+
+            simInput.keys &= ~MAZE_SIM_INPUT_SWITCH;
+            simInput.lookX = 0;
+            simInput.lookY = 0;
+            simAccumulator -= MAZE_SIM_STEP;
+        }
+        EndMazeProfilerZone(&profiler, profSim);
+
+        // Player drawn between last two steps positions (frame time not simulated yet)
+        float alpha = simAccumulator/MAZE_SIM_STEP;
+        playerX = sim.previousX + (sim.x - sim.previousX)*alpha;
+        playerY = sim.previousY + (sim.y - sim.previousY)*alpha;
+        playerCell = sim.cell;
+        playerPoints = sim.points;
+        gameTime = GetMazeSimTime(sim);
     }
-    else
+    else gameTime = MAX_TIME;
+
+    // Session ended: exit reached, time limit reached or editor mode selected
+    if ((sim.state != MAZE_SIM_RUNNING) || sessionLeft)
     {
+        if (sessionRecording)
+        {
+            EndMazeSimRecording(&simRecording, sim);
+
+            // Replay requires the session level: current grid, start/exit cells and items
+            MazeLevel level = { 0 };
+            level.grid = gridMaze;
+            level.start = sim.config.start;
+            level.end = sim.config.end;
+            level.items = (Point *)malloc(mazeItems.count*sizeof(Point));
+            level.itemCount = (level.items != NULL)? mazeItems.count : 0;
+            for (int i = 0; i < level.itemCount; i++) level.items[i] = (Point){ mazeItems.x[i], mazeItems.y[i] };
+            level.biome = currentBiome;
+            level.seed = mazeConfig.seed;
+            level.algorithm = mazeConfig.algorithm;
+            level.spacingRows = mazeConfig.spacingRows;
+            level.spacingCols = mazeConfig.spacingCols;
+            level.skipChance = mazeConfig.skipChance;
+
+            if (ExportMazeLevel(level, "maze_session.mzl", MAZE_FILE_RAW) && ExportMazeSimRecording(simRecording, "maze_session.mzr"))
+                TraceLog(LOG_INFO, "MAZE: Session recorded: %i steps, %i points (maze_session.mzl, maze_session.mzr)", simRecording.inputCount, simRecording.points);
+            else TraceLog(LOG_WARNING, "MAZE: Failed to export recorded session");
+
+            free(level.items);
+            sessionRecording = false;
+        }
+
+        currentMode = MODE_EDITOR;
+        sim.state = MAZE_SIM_RUNNING;
+        playerCell = startCell;
+        playerX = playerCell.x;
+        playerY = playerCell.y;
         gameTime = MAX_TIME;
     }
 
+    // Request chunks around player, generated chunks are copied into the stream window
+    if (endlessMode) UpdateMazeStream(&mazeStream, playerCell);
+
     switch (currentMode)
     {
     case MODE_GAME2D:     // Game 2D mode
         {
-            // DONE: [2p] Player 2D movement from predefined start point (A) to end point (B)
-            // Implement maze 2D player movement logic (cursors || WASD)
-            // Use imMaze pixel information to check collisions
-            // Detect if current playerCell == endCell to finish game
-            float change = playerSpeed * GetFrameTime();
-            Point checkCell[2];
-            int direction[4][2] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}}; // Up, Down, Left, Right
-            int keys[4] = {KEY_W, KEY_S, KEY_A, KEY_D};
-            for (int i = 0; i < 4; i++) { //Itera per cada direccio
-                if (IsKeyDown(keys[i])) { //Si la tecla esta d'aquella direcció
-                    
-                    float newPlayerX = playerX + change * direction[i][0]; //Calcula la nova posició del jugador
-                    float newPlayerY = playerY + change * direction[i][1]; 
-
-                    if (direction[i][0] != 0) { // Moving horizontally
-                        //Calcula les dues cel·les que tocarà el jugador
-                        checkCell[0] = (Point){(int)(newPlayerX + direction[i][0] * collisionRadius), (int)(newPlayerY - collisionRadius)}; 
-                        checkCell[1] = (Point){(int)(newPlayerX + direction[i][0] * collisionRadius), (int)(newPlayerY + collisionRadius)};
-                    } else { // Moving vertically
-                        checkCell[0] = (Point){(int)(newPlayerX - collisionRadius), (int)(newPlayerY + direction[i][1] * collisionRadius)};
-                        checkCell[1] = (Point){(int)(newPlayerX + collisionRadius), (int)(newPlayerY + direction[i][1] * collisionRadius)};
-                    }
-                    
-                    
-                    for (int j = 0; j < 2; j++) {
-                        //Comprova si alguna de les dues cel·les toca una paret
-                        if (ColorIsEqual(GetImageColor(imMaze, checkCell[j].x, checkCell[j].y), WHITE)) {
-                            if (direction[i][0] != 0) { // Moving horizontally
-                                newPlayerX = roundf(playerX*10)/10; //Arrodoneix la posició del jugador (SNAP)
-                            } 
-                            else { // Moving vertically
-                                newPlayerY = roundf(playerY*10)/10;
-                            }
-                            break;
-                        }
-                    }
-    
-                    playerX = newPlayerX;
-                    playerY = newPlayerY;
-                }
-            }
-
-            playerCell.x = (int)round(playerX - 0.5f) ;
-            playerCell.y = (int)round(playerY - 0.5f);
-
-            if (playerCell.x == endCell.x && playerCell.y == endCell.y) {
-                currentMode = MODE_EDITOR;
-                playerCell = startCell;
-                playerX = playerCell.x;
-                playerY = playerCell.y;
-                
-            }
-
             // DONE: [2p] Camera 2D system following player movement around the map
             // Update Camera2D parameters as required to follow player and zoom control
 
@@ -287,60 +566,22 @@ while (!WindowShouldClose())    // Detect window close button or ESC key
                 camera2d.zoom = Clamp(camera2d.zoom, 1.0f, 4.0f);
             }
 
-            // TODO: Maze items pickup logic
-
-            for (int i = 0; i < MAX_MAZE_ITEMS; i++)
-            {
-                if (playerCell.x == mazeItems[i].x && playerCell.y == mazeItems[i].y)
-                {
-                    if (!mazeItemPicked[i]) playerPoints += 50;
-                    mazeItemPicked[i] = true;
-                    
-                }
-            }
-
         } break;
     case MODE_GAME3D:     // Game 3D mode
         {
-            // DONE: [1p] Camera 3D system and �3D maze mode�
-            // Implement maze 3d first-person mode -> TIP: UpdateCamera()
-            // Use the imMaze map to implement collision detection, similar to 2D
-
-            cameraFP.position.x = playerX;
-            cameraFP.position.z = playerY;
-            Vector3 previousPosition = cameraFP.position;
-            UpdateCamera(&cameraFP, CAMERA_FIRST_PERSON);
-            Vector3 direction = { cameraFP.position.x - previousPosition.x, cameraFP.position.y - previousPosition.y, cameraFP.position.z - previousPosition.z };
-            bool collisionDirX = ColorIsEqual(GetImageColor(imMaze, (int)round(cameraFP.position.x+direction.x), (int)round(cameraFP.position.z)), WHITE);
-            bool collisionDirZ = ColorIsEqual(GetImageColor(imMaze, (int)round(cameraFP.position.x), (int)round(cameraFP.position.z+direction.z)), WHITE);
-            if(collisionDirX || collisionDirZ)
-            {
-                cameraFP.position = previousPosition;
-            }
-            else
-            {
-                playerX = cameraFP.position.x;
-                playerY = cameraFP.position.z;
-                playerCell = (Point){ (int)round(playerX), (int)round(playerY) };
-                if(playerCell.x == endCell.x && playerCell.y == endCell.y)
-                {
-                    currentMode = MODE_EDITOR;
-                    playerCell = startCell;
-                    playerX = playerCell.x;
-                    playerY = playerCell.y;
-                }
-            }
+            // First-person camera placed at player position, looking in simulation view direction
+            cameraFP.position = (Vector3){ playerX, 0.5f, playerY };
+            cameraFP.target = (Vector3){ playerX + cosf(sim.yaw)*cosf(sim.pitch), 0.5f + sinf(sim.pitch), playerY + sinf(sim.yaw)*cosf(sim.pitch) };
 
-            mdlMaze.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = texBiomes[currentBiome];
+            SetMazeModelTexture(&mdlMaze, texBiomes[currentBiome]);
 
-            // DONE: Maze items pickup logic
-            for (int i = 0; i < MAX_MAZE_ITEMS; i++)
+            // Endless mode: generate models of new chunks, limited per frame
+            if (endlessMode)
             {
-                if (playerCell.x == mazeItems[i].x && playerCell.y == mazeItems[i].y)
-                {
-                    if (!mazeItemPicked[i]) playerPoints += 50;
-                    mazeItemPicked[i] = true;
-                }
+                SetMazeStreamModelTexture(&mdlStream, texBiomes[currentBiome]);
+                BeginMazeProfilerZone(&profiler, profMesh);
+                UpdateMazeStreamModel(&mdlStream, mazeStream, MAZE_STREAM_BUILDS);
+                EndMazeProfilerZone(&profiler, profMesh);
             }
 
         } break;
@@ -352,35 +593,49 @@ while (!WindowShouldClose())    // Detect window close button or ESC key
             // transformed into image coordinates
             // Once the cell is selected, if mouse button pressed add/remove image pixels
 
-            // WARNING: Remember that when imMaze changes, texMaze and mdlMaze must be also updated!
+            // WARNING: Remember that when gridMaze changes, imMaze, texMaze and mdlMaze must be also updated!
             
             // get the mouse position in screen coordinates
             Vector2 mousePos = GetMousePosition();
-            
+            bool isInView = CheckCollisionPointRec(mousePos, editorView);
+
+            // Editor view zoom (at mouse position) and pan (middle mouse button)
+            if (isInView)
+            {
+                float wheel = GetMouseWheelMove();
+                if (wheel != 0)
+                {
+                    editorCamera.target = GetScreenToWorld2D(mousePos, editorCamera);
+                    editorCamera.offset = mousePos;
+                    editorCamera.zoom = Clamp(editorCamera.zoom*(1.0f + 0.1f*wheel), MAZE_EDITOR_VIEW/MAX_MAZE_SIZE, 64.0f);
+                }
+
+                if (IsMouseButtonDown(MOUSE_MIDDLE_BUTTON))
+                {
+                    editorCamera.target = Vector2Subtract(editorCamera.target, Vector2Scale(GetMouseDelta(), 1.0f/editorCamera.zoom));
+                }
+            }
+
             // transform the mouse position to image coordinates
-            selectedCell = (Point){ (int)((mousePos.x - mazeOffset2D.x) / MAZE_DRAW_SCALE), (int)((mousePos.y - mazeOffset2D.y) / MAZE_DRAW_SCALE) };
-            bool isInBounds = selectedCell.x >= 0 && selectedCell.x < imMaze.width && selectedCell.y >= 0 && selectedCell.y < imMaze.height;
+            Vector2 mouseCell = GetScreenToWorld2D(mousePos, editorCamera);
+            selectedCell = (Point){ (int)floorf(mouseCell.x), (int)floorf(mouseCell.y) };
+            bool isInBounds = isInView && selectedCell.x >= 0 && selectedCell.x < gridMaze.width && selectedCell.y >= 0 && selectedCell.y < gridMaze.height;
             bool isPlayerCell = playerCell.x == selectedCell.x && playerCell.y == selectedCell.y;
             
             if (isInBounds && !isPlayerCell)
             {
                 bool shouldUpdate = false;
-                bool isWall = ColorIsEqual(GetImageColor(imMaze, selectedCell.x, selectedCell.y), WHITE);
-                int isItem = -1;
-                
-                for (int i = 0; i < mazeItemsCounter; i++)
-                {
-                    if (mazeItems[i].x == selectedCell.x && mazeItems[i].y == selectedCell.y)
-                    {
-                        isItem = i;
-                        break;
-                    }
-                }
+                bool isWall = IsMazeWall(gridMaze, selectedCell.x, selectedCell.y);
+                int isItem = GetMazeItem(mazeItems, selectedCell.x, selectedCell.y);
 
                 if (IsMouseButtonDown(MOUSE_LEFT_BUTTON))
                 {
                     if (isWall)
                     {
+                        SetMazeWall(&gridMaze, selectedCell.x, selectedCell.y, false);
+                        SetMazeRendererCellDirty(&mazeRenderer, selectedCell.x, selectedCell.y);
+                        UpdatePathPlannerCell(&pathPlanner, gridMaze, selectedCell.x, selectedCell.y);
+                        UpdateFlowFieldCell(&flowField, gridMaze, selectedCell.x, selectedCell.y);
                         ImageDrawPixel(&imMaze, selectedCell.x, selectedCell.y, BLACK);
                         shouldUpdate = true;
                     }
@@ -390,6 +645,10 @@ while (!WindowShouldClose())    // Detect window close button or ESC key
                 {
                     if (!isWall && isItem == -1)
                     {
+                        SetMazeWall(&gridMaze, selectedCell.x, selectedCell.y, true);
+                        SetMazeRendererCellDirty(&mazeRenderer, selectedCell.x, selectedCell.y);
+                        UpdatePathPlannerCell(&pathPlanner, gridMaze, selectedCell.x, selectedCell.y);
+                        UpdateFlowFieldCell(&flowField, gridMaze, selectedCell.x, selectedCell.y);
                         ImageDrawPixel(&imMaze, selectedCell.x, selectedCell.y, WHITE);
                         shouldUpdate = true;
                     }
@@ -397,36 +656,69 @@ while (!WindowShouldClose())    // Detect window close button or ESC key
 
                 if (IsKeyPressed(KEY_I))
                 {
-                    if (isItem != -1)
-                    {
-                        mazeItemsCounter--;
-                        if (isItem < mazeItemsCounter)
-                            mazeItems[isItem] = mazeItems[mazeItemsCounter];
-
-                        mazeItemPicked[mazeItemsCounter] = true;
-                        break;
-                    }
-                    else if (mazeItemsCounter < MAX_MAZE_ITEMS && !isWall)
-                    {
-                        mazeItems[mazeItemsCounter] = selectedCell;
-                        mazeItemPicked[mazeItemsCounter] = false;
-                        mazeItemsCounter++;
-                    }
+                    if (isItem != -1) RemoveMazeItem(&mazeItems, selectedCell.x, selectedCell.y);
+                    else if (mazeItems.count < MAX_MAZE_ITEMS && !isWall) AddMazeItem(&mazeItems, selectedCell.x, selectedCell.y);
                 }
 
+                // Accumulate changed cells in dirty rectangle, uploaded once per frame
                 if (shouldUpdate)
                 {
-                    UnloadTexture(texMaze);
-                    texMaze = LoadTextureFromImage(imMaze);
-                    UnloadModel(mdlMaze);
-                    meshMaze = GenMeshCubicmap(imMaze, (Vector3) { 1.0f, 1.0f, 1.0f });
-                    mdlMaze = LoadModelFromMesh(meshMaze);
+                    if ((dirtyRec.width == 0) || (dirtyRec.height == 0)) dirtyRec = (Rectangle){ selectedCell.x, selectedCell.y, 1, 1 };
+                    else
+                    {
+                        float right = fmaxf(dirtyRec.x + dirtyRec.width, selectedCell.x + 1);
+                        float bottom = fmaxf(dirtyRec.y + dirtyRec.height, selectedCell.y + 1);
+                        dirtyRec.x = fminf(dirtyRec.x, selectedCell.x);
+                        dirtyRec.y = fminf(dirtyRec.y, selectedCell.y);
+                        dirtyRec.width = right - dirtyRec.x;
+                        dirtyRec.height = bottom - dirtyRec.y;
+                    }
                 }
             }
 
+            // Upload maze changes of this frame: only changed texture region and model chunks
+            if ((dirtyRec.width > 0) && (dirtyRec.height > 0))
+            {
+                Image imDirty = ImageFromImage(imMaze, dirtyRec);
+                UpdateTextureRec(texMaze, dirtyRec, imDirty.data);
+                UnloadImage(imDirty);
+
+                BeginMazeProfilerZone(&profiler, profMesh);
+                UpdateMazeModelRec(&mdlMaze, gridMaze, dirtyRec);
+                EndMazeProfilerZone(&profiler, profMesh);
+                SetMazePreviewDirty(&mazePreview);
+                dirtyRec = (Rectangle){ 0 };
+            }
+
+            // Mesh report: maze model (greedy meshing, chunked) against GenMeshCubicmap() on same maze
+            if (IsKeyPressed(KEY_M) && (mdlMaze.chunks != NULL))
+            {
+                MazeModel mdlReport = LoadMazeModel(gridMaze, MAZE_MODEL_CHUNK);
+                double startTime = GetElapsedTime();
+                Mesh meshCubicmap = GenMeshCubicmap(imMaze, (Vector3){ 1.0f, 1.0f, 1.0f });
+                double cubicmapTime = GetElapsedTime() - startTime;
+
+                TraceLog(LOG_INFO, "MESH: Cubicmap: %i vertices, %i triangles, %.3f ms", meshCubicmap.vertexCount, meshCubicmap.triangleCount, cubicmapTime*1000.0);
+                TraceLog(LOG_INFO, "MESH: Greedy (%i chunks): %i vertices, %i triangles, %.3f ms", mdlReport.chunksRebuilt, mdlReport.vertexCount, mdlReport.triangleCount, mdlReport.buildTime*1000.0);
+                TraceLog(LOG_INFO, "MESH: Triangles reduced %.1fx, vertices reduced %.1fx", (float)meshCubicmap.triangleCount/mdlReport.triangleCount, (float)meshCubicmap.vertexCount/mdlReport.vertexCount);
+
+                UnloadMesh(meshCubicmap);
+                UnloadMazeModel(mdlReport);
+            }
+
+
+            if (IsKeyPressed(KEY_R)) orbitPreview = !orbitPreview;
 
-            UpdateCamera(&cameraOrbit, CAMERA_ORBITAL);
-            mdlMaze.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = texBiomes[currentBiome];
+            // Bulk items placement on random cells reachable from exit
+            if (IsKeyPressed(KEY_B) && (mazeItems.count < MAX_MAZE_ITEMS))
+            {
+                int requested = (MAX_MAZE_ITEMS - mazeItems.count < MAZE_ITEMS_BULK)? MAX_MAZE_ITEMS - mazeItems.count : MAZE_ITEMS_BULK;
+                int placed = GenMazeItems(&mazeItems, gridMaze, flowField, requested, (unsigned int)GetRandomValue(0, 0x7fffffff));
+
+                TraceLog(LOG_INFO, "MAZE: Items placed: %i/%i (total: %i)", placed, requested, mazeItems.count);
+            }
+            if (orbitPreview) UpdateCamera(&cameraOrbit, CAMERA_ORBITAL);
+            SetMazeModelTexture(&mdlMaze, texBiomes[currentBiome]);
 
             // DONE: [2p] Collectible map items: player score
             // Using same mechanism than map editor, implement an items editor, registering
@@ -455,11 +747,86 @@ while (!WindowShouldClose())    // Detect window close button or ESC key
 
     if (IsKeyPressed(KEY_F))
     {
-        path = NULL;
-        pointCount = 0;
-        path = LoadPathAStar(imMaze, startCell, endCell, &pointCount);
+        BeginMazeProfilerZone(&profiler, profPath);
+        path = FindPath(&pathFinder, gridMaze, startCell, endCell, pathAlgorithm, &pointCount);
+        EndMazeProfilerZone(&profiler, profPath);
+        if (path == NULL) TraceLog(LOG_INFO, "PATH: Path not found [%i, %i] -> [%i, %i]", startCell.x, startCell.y, endCell.x, endCell.y);
+        else TraceLog(LOG_INFO, "PATH: Path found, %i points, %i nodes expanded", pointCount, pathFinder.expanded);
     }
 
+    // Live path to exit, repaired every frame from current playerCell
+    if (IsKeyPressed(KEY_P))
+    {
+        showLivePath = !showLivePath;
+
+        if (showLivePath)
+        {
+            pathPlanner = LoadPathPlanner(gridMaze.width, gridMaze.height);
+            ResetPathPlanner(&pathPlanner, playerCell, endCell);
+        }
+        else
+        {
+            UnloadPathPlanner(pathPlanner);
+            pathPlanner = (PathPlanner){ 0 };
+        }
+    }
+
+    livePath = NULL;
+    livePointCount = 0;
+    if (showLivePath && !endlessMode)
+    {
+        BeginMazeProfilerZone(&profiler, profPath);
+        SetPathPlannerStart(&pathPlanner, playerCell);
+        livePath = UpdatePathPlanner(&pathPlanner, gridMaze, &livePointCount);
+        EndMazeProfilerZone(&profiler, profPath);
+    }
+
+    // Profiler overlay and statistics export
+    if (IsKeyPressed(KEY_O)) showProfiler = !showProfiler;
+    if (IsKeyPressed(KEY_L))
+    {
+        if (ExportMazeProfilerCSV(&profiler, "maze_profile.csv") && ExportMazeProfilerJSON(&profiler, "maze_profile.json"))
+            TraceLog(LOG_INFO, "PROF: Frame phases statistics exported (maze_profile.csv, maze_profile.json)");
+        else TraceLog(LOG_WARNING, "PROF: Failed to export frame phases statistics");
+    }
+
+    // Level file dropped on window (.mzl): level grid is swapped in as a new maze bundle
+    // NOTE: Level is loaded at once (grid copied), image, model and distances are generated in background
+    if (IsFileDropped())
+    {
+        FilePathList droppedFiles = LoadDroppedFiles();
+
+        if ((droppedFiles.count > 0) && IsFileExtension(droppedFiles.paths[0], ".mzl") && !IsMazeBundleBusy(mazeLoader))
+        {
+            MazeLevel level = LoadMazeLevel(droppedFiles.paths[0], 0);
+            MazeBundleConfig config = mazeConfig;
+            config.grid = level.grid;
+            config.endCell = level.end;
+            config.seed = level.seed;
+            config.algorithm = level.algorithm;
+            config.spacingRows = level.spacingRows;
+            config.spacingCols = level.spacingCols;
+            config.skipChance = level.skipChance;
+
+            if ((level.grid.cells != NULL) && StartMazeBundle(&mazeLoader, config))
+            {
+                droppedLevel = level;
+                droppedLevel.grid = (MazeGrid){ 0 };    // Taken by bundle
+                levelDropped = true;
+                TraceLog(LOG_INFO, "MAZE: Level loaded (%s): %ix%i, %i items", GetFileName(droppedFiles.paths[0]), level.grid.width, level.grid.height, level.itemCount);
+            }
+            else
+            {
+                TraceLog(LOG_WARNING, "MAZE: Level could not be loaded (%s)", GetFileName(droppedFiles.paths[0]));
+                UnloadMazeLevel(level);
+            }
+        }
+
+        UnloadDroppedFiles(droppedFiles);
+    }
+
+    EndMazeProfilerZone(&profiler, profUpdate);
+
     //----------------------------------------------------------------------------------
 
     // Draw
@@ -472,6 +839,10 @@ while (!WindowShouldClose())    // Detect window close button or ESC key
         {
             case MODE_GAME2D:     // Game 2D mode
             {
+                // Bake maze chunks visible by camera2d (only chunks not cached or changed)
+                BeginMazeProfilerZone(&profiler, profDraw2D);
+                if (!endlessMode) UpdateMazeRenderer(&mazeRenderer, gridMaze, texBiomes[currentBiome], camera2d);
+
                 // Draw maze using camera2d (for automatic positioning and scale)
                 BeginMode2D(camera2d);
                 if (!IsCursorHidden())
@@ -480,48 +851,37 @@ while (!WindowShouldClose())    // Detect window close button or ESC key
                     DisableCursor();
                 }
 
-                    
-                    //draw texture for reference
-                    DrawTexture(texBiomes[currentBiome], 0, 0, WHITE);
                     // DONE: Draw maze walls and floor using current texture biome 
-                    for(int i = 0; i < imMaze.width; i++)
-					{
-						for(int j = 0; j < imMaze.height; j++)
-						{
-							if(ColorIsEqual(GetImageColor(imMaze,i,j),WHITE))
-							{
-								DrawTexturePro(texBiomes[currentBiome], (Rectangle){ 0, texBiomes[currentBiome].height / 2, texBiomes[currentBiome].width/2, texBiomes[currentBiome].height/2 }, (Rectangle){ i* MAZE_2D_DRAW_SCALE, j* MAZE_2D_DRAW_SCALE, MAZE_2D_DRAW_SCALE, MAZE_2D_DRAW_SCALE
-                                }, (Vector2){ 0, 0 }, 0, WHITE);
-							}
-                            else{
-								DrawTexturePro(texBiomes[currentBiome], (Rectangle){ texBiomes[currentBiome].width / 2, texBiomes[currentBiome].height / 2, texBiomes[currentBiome].width / 2, texBiomes[currentBiome].height/2}, (Rectangle){ i* MAZE_2D_DRAW_SCALE, j* MAZE_2D_DRAW_SCALE, MAZE_2D_DRAW_SCALE, MAZE_2D_DRAW_SCALE
-                                }, (Vector2){ 0, 0 }, 0, WHITE);
-							}
-						}
-					}
+                    // NOTE: Only chunks visible on screen are drawn (one texture per chunk),
+                    // endless mode draws visible cells of the stream window
+                    if (endlessMode) DrawMazeStream(mazeStream, texBiomes[currentBiome], camera2d, MAZE_2D_DRAW_SCALE);
+                    else DrawMazeRenderer(&mazeRenderer);
+
                     // DONE: Draw player rectangle or sprite at player position
                     DrawRectangle(playerX* MAZE_2D_DRAW_SCALE - MAZE_2D_DRAW_SCALE/2, playerY* MAZE_2D_DRAW_SCALE - MAZE_2D_DRAW_SCALE/2,  MAZE_2D_DRAW_SCALE, MAZE_2D_DRAW_SCALE, BLUE);
                     
-                    // DONE: Draw maze items 2d (using sprite texture?)
-                    for (int i = 0; i < MAX_MAZE_ITEMS; i++)
+                    // Items, paths, start and end cells belong to the edited maze
+                    if (!endlessMode)
                     {
-                        if(!mazeItemPicked[i])
-                            DrawTexturePro(texItem, (Rectangle) { 0, 0, texItem.width / 2, texItem.height }, (Rectangle) { mazeItems[i].x* MAZE_2D_DRAW_SCALE, mazeItems[i].y* MAZE_2D_DRAW_SCALE, MAZE_2D_DRAW_SCALE, MAZE_2D_DRAW_SCALE }, (Vector2) {0,0 }, 0.0f, WHITE);
-                    }
-                    
-                    // TODO: EXTRA: Draw pathfinding result, shorter path from start to end
-                   if(path != NULL && pointCount > 0)
-                        for (int i = 0; i < pointCount; i++)
-                        {
-							DrawRectangle(path[i].x* MAZE_2D_DRAW_SCALE, path[i].y* MAZE_2D_DRAW_SCALE, MAZE_2D_DRAW_SCALE, MAZE_2D_DRAW_SCALE, YELLOW);
-						}
-					// Draw start and end cells
-					DrawRectangle(startCell.x* MAZE_2D_DRAW_SCALE, startCell.y* MAZE_2D_DRAW_SCALE, MAZE_2D_DRAW_SCALE, MAZE_2D_DRAW_SCALE, GREEN);
-					DrawRectangle(endCell.x* MAZE_2D_DRAW_SCALE, endCell.y* MAZE_2D_DRAW_SCALE, MAZE_2D_DRAW_SCALE, MAZE_2D_DRAW_SCALE, RED);
-
+                        // DONE: Draw maze items 2d (using sprite texture?)
+                        DrawMazeItems2D(&itemsRenderer, mazeItems, texItem, camera2d, MAZE_2D_DRAW_SCALE, false);
                     
+                        // TODO: EXTRA: Draw pathfinding result, shorter path from start to end
+                       if(path != NULL && pointCount > 0)
+                            for (int i = 0; i < pointCount; i++)
+                            {
+								DrawRectangle(path[i].x* MAZE_2D_DRAW_SCALE, path[i].y* MAZE_2D_DRAW_SCALE, MAZE_2D_DRAW_SCALE, MAZE_2D_DRAW_SCALE, YELLOW);
+							}
+                        // Draw live path to exit (player cell excluded)
+                        for (int i = 1; i < livePointCount; i++)
+                            DrawRectangle(livePath[i].x* MAZE_2D_DRAW_SCALE, livePath[i].y* MAZE_2D_DRAW_SCALE, MAZE_2D_DRAW_SCALE, MAZE_2D_DRAW_SCALE, Fade(SKYBLUE, 0.6f));
+						// Draw start and end cells
+						DrawRectangle(startCell.x* MAZE_2D_DRAW_SCALE, startCell.y* MAZE_2D_DRAW_SCALE, MAZE_2D_DRAW_SCALE, MAZE_2D_DRAW_SCALE, GREEN);
+						DrawRectangle(endCell.x* MAZE_2D_DRAW_SCALE, endCell.y* MAZE_2D_DRAW_SCALE, MAZE_2D_DRAW_SCALE, MAZE_2D_DRAW_SCALE, RED);
+                    }
 
                 EndMode2D();
+                EndMazeProfilerZone(&profiler, profDraw2D);
 
                 // TODO: Draw game UI (score, time...) using custom sprites/fonts
                 // NOTE: Game UI does not receive the camera2d transformations,
@@ -539,17 +899,12 @@ while (!WindowShouldClose())    // Detect window close button or ESC key
                 }
                 
                 // DONE: Draw maze generated 3d model
-                DrawModel(mdlMaze, mdlPosition, 1.0f, WHITE);
+                if (endlessMode) DrawMazeStreamModel(mdlStream, mazeStream, WHITE);
+                else DrawMazeModel(mdlMaze, mdlPosition, WHITE);
 
                 // TODO: Maze items 3d draw (using 3d shape/model?) on required positions
 
-                for (int i = 0; i < mazeItemsCounter; i++)
-				{
-					if (!mazeItemPicked[i])
-					{
-                        DrawBillboardRec(cameraFP, texItem, (Rectangle) { 0, 0, texItem.width / 2, texItem.height }, (Vector3) { mazeItems[i].x, 0.5f, mazeItems[i].y }, (Vector2) {0.5f,0.5f}, WHITE);
-					}
-				}
+                if (!endlessMode) DrawMazeItems3D(&itemsRenderer, mazeItems, texItem, cameraFP, MAZE_ITEMS_VIEW_DISTANCE);
                 EndMode3D();
 
                 // TODO: Draw game UI (score, time...) using custom sprites/fonts
@@ -565,67 +920,95 @@ while (!WindowShouldClose())    // Detect window close button or ESC key
                     EnableCursor();
                 }
 
-                // Draw generated maze texture to fill the 64*8 screen space
-                DrawTextureEx(texMaze, mazeOffset2D, 0, MAZE_DRAW_SCALE, WHITE);
-                // Draw lines rectangle over texture, scaled and centered on screen 
-                DrawRectangleLines(mazeOffset2D.x, mazeOffset2D.y, MAZE_WIDTH*MAZE_DRAW_SCALE, MAZE_HEIGHT*MAZE_DRAW_SCALE, RED);
+                // Draw generated maze texture in the editor viewport (zoom/pan using editorCamera)
+                // NOTE: editorCamera world units are cells, one texture pixel per cell
+                BeginScissorMode(editorView.x, editorView.y, editorView.width, editorView.height);
+                BeginMode2D(editorCamera);
+
+                DrawTextureEx(texMaze, (Vector2){ 0, 0 }, 0, 1.0f, WHITE);
 
                 // DONE: Draw player using a rectangle, consider maze screen coordinates!
-                DrawRectangle(playerCell.x * MAZE_DRAW_SCALE + mazeOffset2D.x, playerCell.y * MAZE_DRAW_SCALE + mazeOffset2D.y, MAZE_DRAW_SCALE, MAZE_DRAW_SCALE, BLUE);
+                DrawRectangle(playerCell.x, playerCell.y, 1, 1, BLUE);
 
                 //draw current mouse position only if it is inside the bounds of the maze
-                if (selectedCell.x >= 0 && selectedCell.x < MAZE_WIDTH && selectedCell.y >= 0 && selectedCell.y < MAZE_HEIGHT)
-                    DrawRectangle(selectedCell.x * MAZE_DRAW_SCALE + mazeOffset2D.x, selectedCell.y * MAZE_DRAW_SCALE + mazeOffset2D.y, MAZE_DRAW_SCALE, MAZE_DRAW_SCALE, GREEN);
+                if (selectedCell.x >= 0 && selectedCell.x < gridMaze.width && selectedCell.y >= 0 && selectedCell.y < gridMaze.height)
+                    DrawRectangle(selectedCell.x, selectedCell.y, 1, 1, GREEN);
 
                 //Draw path if calculated
                 if (path != NULL && pointCount > 0)
 				{
 					for (int i = 0; i < pointCount; i++)
 					{
-						DrawRectangle(path[i].x * MAZE_DRAW_SCALE + mazeOffset2D.x, path[i].y * MAZE_DRAW_SCALE + mazeOffset2D.y, MAZE_DRAW_SCALE, MAZE_DRAW_SCALE, YELLOW);
+						DrawRectangle(path[i].x, path[i].y, 1, 1, YELLOW);
 					}
 				}  
+
+                // Draw live path to exit if enabled (player cell excluded)
+                for (int i = 1; i < livePointCount; i++)
+                    DrawRectangle(livePath[i].x, livePath[i].y, 1, 1, Fade(SKYBLUE, 0.6f));
                     
                 // Draw all placed items
-                for (int i = 0; i < mazeItemsCounter; i++)
-                {
-                    if (!mazeItemPicked[i])
-                        DrawTexturePro(texItem, (Rectangle) { 0, 0, texItem.width / 2, texItem.height }, (Rectangle) { mazeItems[i].x * MAZE_DRAW_SCALE + mazeOffset2D.x, mazeItems[i].y * MAZE_DRAW_SCALE + mazeOffset2D.y, MAZE_DRAW_SCALE, MAZE_DRAW_SCALE}, (Vector2) { 0, 0 }, 0.0f, WHITE);
-                    else
-                        DrawTexturePro(texItem, (Rectangle) { texItem.width / 2, 0, texItem.width / 2, texItem.height }, (Rectangle) { mazeItems[i].x * MAZE_DRAW_SCALE + mazeOffset2D.x, mazeItems[i].y * MAZE_DRAW_SCALE + mazeOffset2D.y, MAZE_DRAW_SCALE, MAZE_DRAW_SCALE}, (Vector2) { 0, 0 }, 0.0f, WHITE);
-                }
+                DrawMazeItems2D(&itemsRenderer, mazeItems, texItem, editorCamera, 1.0f, true);
+
+                EndMode2D();
+                EndScissorMode();
+
+                // Draw lines rectangle around editor viewport
+                DrawRectangleLines(editorView.x, editorView.y, editorView.width, editorView.height, RED);
                 
                 // TODO: Draw editor UI required elements -> TIP: raygui immediate mode UI
                 // NOTE: In immediate-mode UI, logic and drawing is defined together
                 // REFERENCE: https://github.com/raysan5/raygui
 
 
-                BeginTextureMode(targetTexture);
-                ClearBackground(LIGHTGRAY);
-                BeginMode3D(cameraOrbit);
-                DrawModel(mdlMaze, mdlPosition, 1.0f, WHITE);
-                EndMode3D();
-                EndTextureMode();
-                DrawTexturePro(
-                    targetTexture.texture,
-                    (Rectangle){0, 0, targetTexture.texture.width, -targetTexture.texture.height},
-                    (Rectangle){mazeOffset3D.x, mazeOffset3D.y, MAZE_WIDTH * MAZE_DRAW_SCALE,
-                                MAZE_HEIGHT * MAZE_DRAW_SCALE},
-                    (Vector2){0, 0}, 0, WHITE);
+                // Editor 3D preview, redraw skipped if nothing changed (limited to MAZE_PREVIEW_RATE)
+                BeginMazeProfilerZone(&profiler, profOrbit);
+                UpdateMazePreview(&mazePreview, mdlMaze, mdlPosition, cameraOrbit, LIGHTGRAY);
+                EndMazeProfilerZone(&profiler, profOrbit);
+                DrawMazePreview(mazePreview, (Rectangle){ mazeOffset3D.x, mazeOffset3D.y, MAZE_EDITOR_VIEW, MAZE_EDITOR_VIEW });
+                if (mdlMaze.chunks == NULL) DrawText("3D model not available for this maze size", mazeOffset3D.x + 10, mazeOffset3D.y + 10, 20, DARKGRAY);
 
 
-                    if (GuiButton((Rectangle){mazeOffset2D.x, mazeOffset2D.y-40, 100, 40}, "Save Maze"))
+                    if (IsMazeExportBusy(mazeExporter))
+                    {
+                        // 3D mesh being exported, editing continues
+                        float exportProgress = GetMazeExportProgress(mazeExporter);
+                        GuiProgressBar((Rectangle){mazeOffset2D.x, mazeOffset2D.y-40, 100, 40}, NULL, NULL, &exportProgress, 0.0f, 1.0f);
+                        DrawText("export", mazeOffset2D.x + 8, mazeOffset2D.y-29, 18, BLACK);
+                    }
+                    else if (GuiButton((Rectangle){mazeOffset2D.x, mazeOffset2D.y-40, 100, 40}, "Save Maze"))
                     {
-                        Image imMaze = GenImageMaze(MAZE_WIDTH, MAZE_HEIGHT, MAZE_SPACING_ROWS, MAZE_SPACING_COLS, 0.75f);
+                        // Level file: current (edited) grid, start/end cells, items, biome and generation parameters
+                        MazeLevel level = { 0 };
+                        level.grid = gridMaze;
+                        level.start = startCell;
+                        level.end = endCell;
+                        level.items = (Point *)malloc(mazeItems.count*sizeof(Point));
+                        level.itemCount = (level.items != NULL)? mazeItems.count : 0;
+                        for (int i = 0; i < level.itemCount; i++) level.items[i] = (Point){ mazeItems.x[i], mazeItems.y[i] };
+                        level.biome = currentBiome;
+                        level.seed = mazeConfig.seed;
+                        level.algorithm = mazeConfig.algorithm;
+                        level.spacingRows = mazeConfig.spacingRows;
+                        level.spacingCols = mazeConfig.spacingCols;
+                        level.skipChance = mazeConfig.skipChance;
+
+                        if (ExportMazeLevel(level, "maze.mzl", MAZE_FILE_RLE)) TraceLog(LOG_INFO, "MAZE: Level saved (maze.mzl)");
+                        else TraceLog(LOG_WARNING, "MAZE: Failed to save level (maze.mzl)");
+                        free(level.items);
+
                         ExportImage(imMaze, "maze.png");
-                        UnloadImage(imMaze);
 
-                        //export maze 3D
-                        Mesh mesh = GenMeshCubicmap(imMaze, (Vector3){1.0f, 1.0f, 1.0f});
-                        ExportMesh(mesh, "maze.obj");
-                        UnloadMesh(mesh);
+                        //export maze 3D (current maze, streamed in background, any maze size)
+                        StartMazeExport(&mazeExporter, gridMaze, (exportFormat == MAZE_EXPORT_GLB)? "maze.glb" : "maze.obj", exportFormat);
                     }
                     
+                    // Pathfinding algorithm used on KEY_F
+                    GuiToggleGroup((Rectangle){mazeOffset2D.x + 220, mazeOffset2D.y-40, 50, 40}, "A*;JPS", &pathAlgorithm);
+
+                    // Generation algorithm used on Reload Maze
+                    GuiComboBox((Rectangle){mazeOffset2D.x + 330, mazeOffset2D.y-40, 140, 40}, "Grid;Kruskal;Backtracker;Wilson;Eller", &mazeAlgorithm);
+
                     DrawText("X Spacing", centerX-44, centerY-200, 18, BLACK);
 
                     //edit mode if clicked
@@ -633,6 +1016,8 @@ while (!WindowShouldClose())    // Detect window close button or ESC key
                     {
                         activeXSpacing = true;
                         activeYSpacing = false;
+                        activeWidth = false;
+                        activeHeight = false;
                         
                     }
                     int xSpace = atoi(xSpacing);
@@ -643,27 +1028,63 @@ while (!WindowShouldClose())    // Detect window close button or ESC key
                     {
                         activeYSpacing = true;
                         activeXSpacing = false;
+                        activeWidth = false;
+                        activeHeight = false;
                     }
                     int ySpace = atoi(ySpacing);
                     DrawText("Skip Chance", centerX-56, centerY, 20, BLACK);
                     float skipChance;
                     
                     GuiSlider((Rectangle){centerX-40, centerY+30, 80, 20}, " ", NULL, &skipChance, 0.5f, 1.0f);
+
+                    DrawText("Width", centerX-28, centerY+70, 18, BLACK);
+
+                    if (GuiTextBox((Rectangle){centerX-40, centerY+95, 80, 40}, mazeWidthText, sizeof(mazeWidthText), activeWidth))
+                    {
+                        activeWidth = true;
+                        activeHeight = false;
+                        activeXSpacing = false;
+                        activeYSpacing = false;
+                    }
+                    int newMazeWidth = Clamp(atoi(mazeWidthText), MIN_MAZE_SIZE, MAX_MAZE_SIZE);
+
+                    DrawText("Height", centerX-30, centerY+145, 18, BLACK);
+
+                    if (GuiTextBox((Rectangle){centerX-40, centerY+170, 80, 40}, mazeHeightText, sizeof(mazeHeightText), activeHeight))
+                    {
+                        activeHeight = true;
+                        activeWidth = false;
+                        activeXSpacing = false;
+                        activeYSpacing = false;
+                    }
+                    int newMazeHeight = Clamp(atoi(mazeHeightText), MIN_MAZE_SIZE, MAX_MAZE_SIZE);
+
+                    // 3D mesh file format used on Save Maze
+                    DrawText("3D Export", centerX-40, centerY+220, 18, BLACK);
+                    GuiToggleGroup((Rectangle){centerX-40, centerY+245, 40, 30}, "OBJ;GLB", &exportFormat);
                     
-                    if (GuiButton((Rectangle){mazeOffset2D.x + 110, mazeOffset2D.y-40, 100, 40}, "Reload Maze"))
+                    if (IsMazeBundleBusy(mazeLoader))
+                    {
+                        // New maze being generated, current maze is kept until it is ready
+                        int bundlePhase = 0;
+                        float bundleProgress = GetMazeBundleProgress(mazeLoader, &bundlePhase);
+                        GuiProgressBar((Rectangle){mazeOffset2D.x + 110, mazeOffset2D.y-40, 100, 40}, NULL, NULL, &bundleProgress, 0.0f, 1.0f);
+                        DrawText(GetMazeBundlePhaseName(bundlePhase), mazeOffset2D.x + 118, mazeOffset2D.y-29, 18, BLACK);
+                    }
+                    else if (GuiButton((Rectangle){mazeOffset2D.x + 110, mazeOffset2D.y-40, 100, 40}, "Reload Maze"))
                     {
-                        UnloadImage(imMaze);
-                        imMaze = GenImageMaze(64, 64,xSpace,ySpace, skipChance);
-                        UnloadTexture(texMaze);
-                        texMaze = LoadTextureFromImage(imMaze);
-                        UnloadModel(mdlMaze);
-                        meshMaze = GenMeshCubicmap(imMaze, (Vector3){1.0f, 1.0f, 1.0f});
-                        mdlMaze = LoadModelFromMesh(meshMaze);
-                        playerCell = startCell;
-                        playerX = playerCell.x;
-                        playerY = playerCell.y;
-                        mazeItemsCounter = 0;
-                        for(int i = 0; i < MAX_MAZE_ITEMS; i++) mazeItemPicked[i] = true;
+                        MazeBundleConfig config = { 0 };
+                        config.width = newMazeWidth;
+                        config.height = newMazeHeight;
+                        config.spacingRows = xSpace;
+                        config.spacingCols = ySpace;
+                        config.skipChance = skipChance;
+                        config.seed = (unsigned int)GetRandomValue(0, 0x7fffffff);
+                        config.algorithm = mazeAlgorithm;
+                        config.modelChunk = MAZE_MODEL_CHUNK;
+                        config.maxModelCells = MAX_MODEL_CELLS;
+                        config.repair = true;
+                        StartMazeBundle(&mazeLoader, config);
                     }  
             } break;
             default: break;
@@ -677,6 +1098,24 @@ while (!WindowShouldClose())    // Detect window close button or ESC key
         sprintf(text, "Time : %.2f", gameTime);
 		DrawText(text, 11, 51, 20, BLACK);
 		DrawText(text, 10, 50, 20, WHITE);
+        if (endlessMode)
+        {
+            sprintf(text, "Endless : %d cells from start", abs(playerCell.x - 1) + abs(playerCell.y - 1));
+            DrawText(text, 11, 71, 20, BLACK);
+            DrawText(text, 10, 70, 20, WHITE);
+        }
+        else if (currentMode == MODE_GAME2D || currentMode == MODE_GAME3D)
+        {
+            int exitDistance = GetFlowFieldDistance(flowField, playerCell.x, playerCell.y);
+            if (exitDistance >= 0) sprintf(text, "Exit : %d", exitDistance);
+            else sprintf(text, "Exit : -");
+            DrawText(text, 11, 71, 20, BLACK);
+            DrawText(text, 10, 70, 20, WHITE);
+        }
+
+        if (showProfiler) DrawMazeProfiler(&profiler, screenWidth - 258, 10, 10);
+
+        EndMazeProfilerZone(&profiler, profFrame);
 
     EndDrawing();
     //----------------------------------------------------------------------------------
@@ -686,212 +1125,27 @@ while (!WindowShouldClose())    // Detect window close button or ESC key
 //--------------------------------------------------------------------------------------
 UnloadTexture(texMaze);     // Unload maze texture from VRAM (GPU)
 UnloadImage(imMaze);        // Unload maze image from RAM (CPU)
+UnloadMazeGrid(gridMaze);   // Unload maze grid from RAM (CPU)
+UnloadPathFinder(pathFinder); // Unload pathfinding data from RAM (CPU)
+UnloadPathPlanner(pathPlanner); // Unload live path planner data from RAM (CPU)
+UnloadFlowField(flowField); // Unload distance to exit data from RAM (CPU)
+UnloadMazeItems(mazeItems); // Unload maze items pool
+UnloadMazeRenderer(mazeRenderer);   // Unload 2D maze chunks from VRAM (GPU)
+UnloadMazePreview(mazePreview);     // Unload editor 3D preview render texture from VRAM (GPU)
 UnloadTexture(texItem);     // Unload item texture from VRAM (GPU)
+UnloadMazeItemsRenderer(itemsRenderer); // Unload items renderer buckets, quad and shader
+UnloadMazeSimRecording(simRecording);   // Unload recorded session inputs
 for (int i = 0; i < 4; i++) // Unload biomes textures from VRAM (GPU)
     UnloadTexture(texBiomes[i]); 
-UnloadModel(mdlMaze);        // Unload maze model from VRAM (GPU)
+UnloadMazeModel(mdlMaze);    // Unload maze model chunks from VRAM (GPU)
+UnloadMazeStream(mazeStream);   // Unload endless mode chunks and worker (if loaded)
+UnloadMazeStreamModel(mdlStream);   // Unload endless mode chunk models from VRAM (GPU)
 UnloadMusicStream(music);         // Unload music from RAM (CPU)
+CancelMazeBundle(&mazeLoader);    // Stop maze generation (if running) and unload it
+CancelMazeExport(&mazeExporter);  // Stop 3D mesh export (if running), partial file is removed
 
 CloseWindow();              // Close window and OpenGL context
 //--------------------------------------------------------------------------------------
 
 return 0;
 }
-
-// Generate procedural maze image, using grid-based algorithm
-// NOTE: Black=Walkable cell, White=Wall/Block cell
-static Image GenImageMaze(int width, int height, int spacingRows, int spacingCols, float skipChance)
-{
-// Generate image of plain color (BLACK)
-Image imMaze = GenImageColor(width, height, BLACK);
-
-// Allocate an array of point used for maze generation
-// NOTE: Dynamic array allocation, memory allocated in HEAP (MAX: Available RAM)
-Point *mazePoints = (Point *)malloc(MAZE_WIDTH*MAZE_HEIGHT*sizeof(Point));
-int mazePointsCounter = 0;
-
-// Start traversing image data, line by line, to paint our maze
-for (int y = 0; y < imMaze.height; y++)
-{
-    for (int x = 0; x < imMaze.width; x++)
-    {
-        // Check image borders (1 px)
-        if ((x == 0) || (x == (imMaze.width - 1)) || (y == 0) || (y == (imMaze.height - 1)))
-        {
-            ImageDrawPixel(&imMaze, x, y, WHITE);   // Image border pixels set to WHITE
-        }
-        else
-        {
-            // Check pixel module to set maze corridors width and height
-            if ((x%spacingCols == 0) && (y%spacingRows == 0))
-            {
-                // Get change to define a point for further processing
-                float chance = (float)GetRandomValue(0, 100)/100.0f;
-                
-                if (chance >= skipChance)
-                {
-                    // Set point as wall...
-                    ImageDrawPixel(&imMaze, x, y, WHITE);
-                    
-                    // ...save point for further processing
-                    mazePoints[mazePointsCounter] = (Point){ x, y };
-                    mazePointsCounter++;
-                }
-            }
-        }
-    }
-}
-
-// Define an array of 4 directions for convenience
-Point directions[4] = {
-    { 0, -1 },      // Up
-    { 0, 1 },       // Down
-    { -1, 0 },      // Left
-    { 1, 0 },       // Right
-};
-
-// Load a random sequence of points, to be used as indices, so,
-// we can access mazePoints[] randomly indexed, instead of following the order we gor them
-int *pointIndices = LoadRandomSequence(mazePointsCounter, 0, mazePointsCounter - 1);
-
-// Process every random maze point, moving in one random direction,
-// until we collision with another wall (WHITE pixel)
-for (int i = 0; i < mazePointsCounter; i++)
-{
-    Point currentPoint = mazePoints[pointIndices[i]];
-    Point currentDir = directions[GetRandomValue(0, 3)];
-    currentPoint.x += currentDir.x;
-    currentPoint.y += currentDir.y;
-    
-    // Keep incrementing wall in selected direction until a WHITE pixel is found
-    // NOTE: We only check against the color.r component
-    while (GetImageColor(imMaze, currentPoint.x, currentPoint.y).r != 255)
-    {
-        ImageDrawPixel(&imMaze, currentPoint.x, currentPoint.y, WHITE);
-        
-        currentPoint.x += currentDir.x;
-        currentPoint.y += currentDir.y;
-    }
-}
-
-UnloadRandomSequence(pointIndices);
-
-return imMaze;
-}
-
-// TODO: EXTRA: [10p] Get shorter path between two points, implements pathfinding algorithm: A*
-// NOTE: The functions returns an array of points and the pointCount
-// TODO: EXTRA: [10p] Get shorter path between two points, implements pathfinding algorithm: A*
-// NOTE: The functions returns an array of points and the pointCount
-static Point* LoadPathAStar(Image map, Point start, Point end, int* pointCount)
-{
-    printf("Calculating path between points: [%i, %i] -> [%i, %i]\n", start.x, start.y, end.x, end.y);
-    Point* path = NULL;
-    int pathCounter = 0;
-
-    // PathNode struct definition
-    // NOTE: This is a possible useful struct but it's not a requirement
-    typedef struct PathNode PathNode;
-    struct PathNode {
-        Point p;
-        int gvalue;
-        int hvalue;
-        PathNode* parent;
-    };
-
-    // TODO: Implement A* algorithm logic
-    // NOTE: This function must be self-contained!
-
-    PathNode* openList = (PathNode*)malloc(map.width * map.height * sizeof(PathNode));
-    PathNode* closedList = (PathNode*)malloc(map.width * map.height * sizeof(PathNode));
-    if (openList == NULL || closedList == NULL)
-    {
-        printf("Error: Memory could not be allocated\n");
-        return NULL;
-    }
-    int openListCounter = 0;
-    int closedListCounter = 0;
-    PathNode startNode = { start, 0, 0, NULL };
-    openList[openListCounter++] = startNode;
-    Point directions[4] = {
-        { 0, -1 },      // Up
-        { 0, 1 },       // Down
-        { -1, 0 },      // Left
-        { 1, 0 },       // Right
-    };
-    while (openListCounter > 0)
-    {
-        int lowestFI = 0;
-        for (int i = 0; i < openListCounter; i++)
-        {
-            if (openList[i].gvalue + openList[i].hvalue < openList[lowestFI].gvalue + openList[lowestFI].hvalue)
-                lowestFI = i;
-        }
-        closedList[closedListCounter++] = openList[lowestFI];
-        if (lowestFI < openListCounter - 1)
-            openList[lowestFI] = openList[openListCounter - 1];
-        openListCounter--;
-        if (openList[lowestFI].p.x == end.x && openList[lowestFI].p.y == end.y)
-        {
-            printf("Path found\n");
-            PathNode* currentNode = &closedList[closedListCounter - 1];
-            while (currentNode->p.x != startNode.p.x && currentNode->p.y != startNode.p.y)
-            {
-                pathCounter++;
-                Point* temp = (Point*)realloc(path, pathCounter * sizeof(Point));
-                if (temp == NULL)
-                {
-                    printf("Error: Memory could not be allocated\n");
-                    return NULL;
-                }
-                path = temp;
-                path[pathCounter - 1] = currentNode->p;
-                printf("Path point: [%i, %i]\n", currentNode->p.x, currentNode->p.y);
-                currentNode = currentNode->parent;
-            }
-            free(openList);
-            free(closedList);
-            *pointCount = pathCounter;
-            return path;
-        }
-        for (int i = 0; i < 4; i++)
-        {
-            Point next = { closedList[closedListCounter - 1].p.x + directions[i].x, closedList[closedListCounter - 1].p.y + directions[i].y };
-            if (next.x >= 0 && next.x < map.width && next.y >= 0 && next.y < map.height && ColorIsEqual(GetImageColor(map, next.x, next.y), BLACK))
-            {
-                bool inClosedList = false;
-                for (int j = 0; j < closedListCounter; j++)
-                {
-                    if (closedList[j].p.x == next.x && closedList[j].p.y == next.y)
-                    {
-                        inClosedList = true;
-                        break;
-                    }
-                }
-                if (inClosedList)
-                    continue;
-                bool inOpenList = false;
-                for (int j = 0; j < openListCounter; j++)
-                {
-                    if (openList[j].p.x == next.x && openList[j].p.y == next.y)
-                    {
-                        inOpenList = true;
-                        openList[j].gvalue = closedList[closedListCounter - 1].gvalue + 1;
-                        openList[j].parent = &closedList[closedListCounter - 1];
-                        break;
-                    }
-                }
-                if (!inOpenList)
-                {
-                    PathNode nextNode = { next, closedList[closedListCounter - 1].gvalue + 1, abs(next.x - end.x) + abs(next.y - end.y), &closedList[closedListCounter - 1] };
-                    openList[openListCounter++] = nextNode;
-                }
-            }
-        }
-    }
-
-    printf("Path not found\n");
-    *pointCount = pathCounter;  // Return number of path points 
-    return path;                // Return path array (dynamically allocated)
-}
-
@@ -0,0 +1,584 @@
+/**********************************************************************************************
+*
+*   maze_gen - Maze generation algorithms module
+*
+*   Generator interface over MazeGrid: every algorithm writes into the same bit-packed grid,
+*   GenMazeGridAlgorithm() selects the algorithm (MazeGenAlgorithm), so callers can choose
+*   the algorithm per maze size
+*
+*   Supported algorithms:
+*       MAZE_GEN_GRID           - Grid wall growing (GenMazeGrid()), fast, not a perfect maze,
+*                                 can leave disconnected regions
+*       MAZE_GEN_KRUSKAL        - Randomized Kruskal, union-find over rooms, edges visited in
+*                                 a random order given by a keyed permutation (no edge list)
+*       MAZE_GEN_BACKTRACKER    - Recursive backtracker, iterative, 1 byte per stacked room
+*       MAZE_GEN_WILSON         - Wilson (loop-erased random walks), uniform spanning tree
+*       MAZE_GEN_ELLER          - Eller, row by row, memory only depends on maze width
+*
+*   Perfect mazes (every algorithm but MAZE_GEN_GRID) place rooms on odd cells and walls on
+*   even cells, every room is reachable from any other room through exactly one path. On even
+*   sizes the extra column/row next to the border is kept as wall but cell (width - 2, height - 2),
+*   connected to the last room by a single passage, so it is always walkable and the maze is
+*   still perfect (walkable cells adjacencies = walkable cells - 1)
+*
+*   Random values are counter-based (GetMazeRandom()), the same seed always generates the
+*   same maze on any machine
+*
+*   CONFIGURATION:
+*       #define MAZE_IMPLEMENTATION
+*           Generates the implementation of the module in the including file,
+*           only ONE file of the program should define it
+*
+*   DEPENDENCIES:
+*       maze.h      - MazeGrid, GenMazeGrid(), GetMazeRandom(), memory allocators
+*
+**********************************************************************************************/
+
+#ifndef MAZE_GEN_H
+#define MAZE_GEN_H
+
+#include "maze.h"                       // Required for: MazeGrid, GenMazeGrid(), GetMazeRandom()
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Maze generation algorithms
+typedef enum {
+    MAZE_GEN_GRID = 0,          // Grid wall growing, not a perfect maze
+    MAZE_GEN_KRUSKAL,           // Randomized Kruskal (union-find)
+    MAZE_GEN_BACKTRACKER,       // Recursive backtracker (iterative)
+    MAZE_GEN_WILSON,            // Wilson (loop-erased random walks)
+    MAZE_GEN_ELLER              // Eller (row by row)
+} MazeGenAlgorithm;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+// Generate maze grid using the selected algorithm (MazeGenAlgorithm)
+// NOTE: spacingRows, spacingCols and skipChance are only used by MAZE_GEN_GRID
+MazeGrid GenMazeGridAlgorithm(int width, int height, int spacingRows, int spacingCols, float skipChance, unsigned int seed, int algorithm);
+
+// Generate perfect maze into grid (grid size is kept, all previous cells are overwritten)
+bool GenMazeKruskal(MazeGrid *grid, unsigned int seed);             // Generate perfect maze, randomized Kruskal
+bool GenMazeBacktracker(MazeGrid *grid, unsigned int seed);         // Generate perfect maze, recursive backtracker
+bool GenMazeWilson(MazeGrid *grid, unsigned int seed);              // Generate perfect maze, Wilson
+bool GenMazeEller(MazeGrid *grid, unsigned int seed);               // Generate perfect maze, Eller
+
+const char *GetMazeGenAlgorithmName(int algorithm);                 // Get algorithm name (i.e. "kruskal")
+
+#if defined(__cplusplus)
+}
+#endif
+
+/***********************************************************************************
+*
+*   MAZE GEN IMPLEMENTATION
+*
+************************************************************************************/
+#if defined(MAZE_IMPLEMENTATION)
+
+#include <string.h>                     // Required for: memset()
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Sequential random values for an algorithm run, counter-based (values do not depend on state)
+// NOTE: Every hash provides 32 random bits, small values only consume the bits they need
+typedef struct MazeGenRandom {
+    unsigned int seed;          // Maze seed
+    uint64_t counter;           // Values generated
+    uint64_t bits;              // Random bits not consumed yet
+    int bitCount;               // Number of random bits not consumed yet
+} MazeGenRandom;
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static unsigned int MazeGenRandomBits(MazeGenRandom *random, int count);    // Get random bits (count up to 32)
+static int MazeGenRandomChoice(MazeGenRandom *random, int count);           // Get random value in range [0, count - 1], count up to 4
+static uint64_t MazeGenPermute(uint64_t index, int halfBits, unsigned int seed);    // Get index permutation (Feistel network)
+
+static void MazeGenFillWalls(MazeGrid *grid);                               // Set every grid cell as wall
+static void MazeGenConnectEnd(MazeGrid *grid);                            // Connect cell (width - 2, height - 2) on even sizes
+static int MazeGenRoomNeighbours(int roomsX, int roomsY, int room, int *neighbours, int *directions);    // Get neighbour rooms (up to 4)
+static void MazeGenCarve(MazeGrid *grid, int roomsX, int room, int direction);      // Carve passage from room in direction (room also carved)
+static unsigned int MazeGenFind(unsigned int *parent, unsigned int room);   // Get room set root (union-find, path halving)
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Generate maze grid using the selected algorithm (MazeGenAlgorithm)
+MazeGrid GenMazeGridAlgorithm(int width, int height, int spacingRows, int spacingCols, float skipChance, unsigned int seed, int algorithm)
+{
+    if (algorithm == MAZE_GEN_GRID) return GenMazeGrid(width, height, spacingRows, spacingCols, skipChance, seed);
+
+    MazeGrid grid = LoadMazeGrid(width, height);
+    if (grid.cells == NULL) return grid;
+
+    bool success = false;
+
+    switch (algorithm)
+    {
+        case MAZE_GEN_KRUSKAL: success = GenMazeKruskal(&grid, seed); break;
+        case MAZE_GEN_BACKTRACKER: success = GenMazeBacktracker(&grid, seed); break;
+        case MAZE_GEN_WILSON: success = GenMazeWilson(&grid, seed); break;
+        case MAZE_GEN_ELLER: success = GenMazeEller(&grid, seed); break;
+        default: break;
+    }
+
+    if (!success)
+    {
+        UnloadMazeGrid(grid);
+        return (MazeGrid){ 0 };
+    }
+
+    return grid;
+}
+
+// Generate perfect maze, randomized Kruskal
+// NOTE: Edges are visited in the order given by a keyed permutation of edge indices,
+// equivalent to shuffling an edge list without storing it (4 bytes per room)
+bool GenMazeKruskal(MazeGrid *grid, unsigned int seed)
+{
+    int roomsX = (grid->width - 1)/2;
+    int roomsY = (grid->height - 1)/2;
+
+    MazeGenFillWalls(grid);
+    if ((roomsX <= 0) || (roomsY <= 0)) return (grid->cells != NULL);
+
+    unsigned int roomCount = (unsigned int)roomsX*roomsY;
+    unsigned int *parent = (unsigned int *)MAZE_MALLOC(roomCount*sizeof(unsigned int));
+    if (parent == NULL) return false;
+
+    for (unsigned int i = 0; i < roomCount; i++) parent[i] = i;
+
+    // Every room is the origin of 2 edges (east and south), edges out of the grid are skipped
+    uint64_t edgeCount = 2*(uint64_t)roomCount;
+    int halfBits = 1;
+    while ((1ull << (2*halfBits)) < edgeCount) halfBits++;
+
+    MazeGenRandom random = { .seed = seed };
+    unsigned int joined = 0;
+
+    for (uint64_t i = 0; (i < ((uint64_t)1 << (2*halfBits))) && (joined < (roomCount - 1)); i++)
+    {
+        // Cycle-walking: permutation values out of range are skipped, the rest is a permutation of edges
+        uint64_t edge = MazeGenPermute(i, halfBits, seed);
+        if (edge >= edgeCount) continue;
+
+        int room = (int)(edge >> 1);
+        int direction = (edge & 1)? 1 : 3;      // Down or Right (MazeGenCarve() directions)
+        int x = room%roomsX;
+        int y = room/roomsX;
+
+        if ((direction == 3) && (x == (roomsX - 1))) continue;
+        if ((direction == 1) && (y == (roomsY - 1))) continue;
+
+        unsigned int neighbour = (direction == 3)? room + 1 : room + roomsX;
+        unsigned int rootA = MazeGenFind(parent, room);
+        unsigned int rootB = MazeGenFind(parent, neighbour);
+
+        if (rootA != rootB)
+        {
+            // Link random root under the other one, keeps trees shallow in average
+            if (MazeGenRandomBits(&random, 1)) parent[rootA] = rootB;
+            else parent[rootB] = rootA;
+
+            MazeGenCarve(grid, roomsX, room, direction);
+            MazeGenCarve(grid, roomsX, neighbour, -1);
+            joined++;
+        }
+    }
+
+    // Maze with a single room has no edges
+    if (roomCount == 1) MazeGenCarve(grid, roomsX, 0, -1);
+
+    MAZE_FREE(parent);
+
+    MazeGenConnectEnd(grid);
+
+    return true;
+}
+
+// Generate perfect maze, recursive backtracker
+// NOTE: Carved rooms are visited rooms (no visited array), the stack stores the direction
+// every room was entered from (1 byte per stacked room), backtracking walks it back
+bool GenMazeBacktracker(MazeGrid *grid, unsigned int seed)
+{
+    int roomsX = (grid->width - 1)/2;
+    int roomsY = (grid->height - 1)/2;
+
+    MazeGenFillWalls(grid);
+    if ((roomsX <= 0) || (roomsY <= 0)) return (grid->cells != NULL);
+
+    MazeGenRandom random = { .seed = seed };
+    int capacity = 1024;
+    int stackCount = 0;
+    unsigned char *stack = (unsigned char *)MAZE_MALLOC(capacity);
+    if (stack == NULL) return false;
+
+    int neighbours[4] = { 0 };
+    int directions[4] = { 0 };
+    int room = (int)(MazeGenRandomBits(&random, 32)%(unsigned int)(roomsX*roomsY));
+    MazeGenCarve(grid, roomsX, room, -1);
+
+    while (true)
+    {
+        // Get neighbour rooms not visited yet
+        int count = MazeGenRoomNeighbours(roomsX, roomsY, room, neighbours, directions);
+        int available = 0;
+
+        for (int i = 0; i < count; i++)
+        {
+            if (IsMazeWall(*grid, 2*(neighbours[i]%roomsX) + 1, 2*(neighbours[i]/roomsX) + 1))
+            {
+                neighbours[available] = neighbours[i];
+                directions[available] = directions[i];
+                available++;
+            }
+        }
+
+        if (available > 0)
+        {
+            if (stackCount == capacity)
+            {
+                unsigned char *resized = (unsigned char *)MAZE_REALLOC(stack, 2*(size_t)capacity);
+
+                if (resized == NULL)
+                {
+                    MAZE_FREE(stack);
+                    return false;
+                }
+
+                stack = resized;
+                capacity *= 2;
+            }
+
+            int choice = MazeGenRandomChoice(&random, available);
+            MazeGenCarve(grid, roomsX, room, directions[choice]);
+            room = neighbours[choice];
+            MazeGenCarve(grid, roomsX, room, -1);
+            stack[stackCount++] = (unsigned char)directions[choice];
+        }
+        else if (stackCount > 0)
+        {
+            // Backtrack: move against the direction the room was entered from
+            switch (stack[--stackCount])
+            {
+                case 0: room += roomsX; break;
+                case 1: room -= roomsX; break;
+                case 2: room += 1; break;
+                case 3: room -= 1; break;
+                default: break;
+            }
+        }
+        else break;
+    }
+
+    MAZE_FREE(stack);
+
+    MazeGenConnectEnd(grid);
+
+    return true;
+}
+
+// Generate perfect maze, Wilson (uniform spanning tree)
+// NOTE: Carved rooms are rooms in the maze, random walks store the last exit direction
+// of every room (1 byte per room), following them from the walk start erases the loops
+bool GenMazeWilson(MazeGrid *grid, unsigned int seed)
+{
+    int roomsX = (grid->width - 1)/2;
+    int roomsY = (grid->height - 1)/2;
+
+    MazeGenFillWalls(grid);
+    if ((roomsX <= 0) || (roomsY <= 0)) return (grid->cells != NULL);
+
+    int roomCount = roomsX*roomsY;
+    unsigned char *walk = (unsigned char *)MAZE_MALLOC((size_t)roomCount);
+    if (walk == NULL) return false;
+
+    MazeGenRandom random = { .seed = seed };
+    int neighbours[4] = { 0 };
+    int directions[4] = { 0 };
+
+    MazeGenCarve(grid, roomsX, (int)(MazeGenRandomBits(&random, 32)%(unsigned int)roomCount), -1);
+
+    for (int start = 0; start < roomCount; start++)
+    {
+        if (!IsMazeWall(*grid, 2*(start%roomsX) + 1, 2*(start/roomsX) + 1)) continue;
+
+        // Random walk until a room in the maze is found, only the last exit of every room is kept
+        int room = start;
+
+        while (IsMazeWall(*grid, 2*(room%roomsX) + 1, 2*(room/roomsX) + 1))
+        {
+            int count = MazeGenRoomNeighbours(roomsX, roomsY, room, neighbours, directions);
+            int choice = MazeGenRandomChoice(&random, count);
+
+            walk[room] = (unsigned char)directions[choice];
+            room = neighbours[choice];
+        }
+
+        // Add loop-erased walk to the maze
+        for (room = start; IsMazeWall(*grid, 2*(room%roomsX) + 1, 2*(room/roomsX) + 1);)
+        {
+            MazeGenCarve(grid, roomsX, room, walk[room]);
+
+            switch (walk[room])
+            {
+                case 0: room -= roomsX; break;
+                case 1: room += roomsX; break;
+                case 2: room -= 1; break;
+                case 3: room += 1; break;
+                default: break;
+            }
+        }
+    }
+
+    MAZE_FREE(walk);
+
+    MazeGenConnectEnd(grid);
+
+    return true;
+}
+
+// Generate perfect maze, Eller (row by row)
+// NOTE: Only the sets of the current rooms row are stored (memory depends on width),
+// sets are tracked with a union-find over row positions, rebuilt for every row
+bool GenMazeEller(MazeGrid *grid, unsigned int seed)
+{
+    int roomsX = (grid->width - 1)/2;
+    int roomsY = (grid->height - 1)/2;
+
+    MazeGenFillWalls(grid);
+    if ((roomsX <= 0) || (roomsY <= 0)) return (grid->cells != NULL);
+
+    // Row sets data: room set label (previous row), union-find parent, first position for a label,
+    // last position and carried flag for a root
+    unsigned int *data = (unsigned int *)MAZE_MALLOC(6*(size_t)roomsX*sizeof(unsigned int));
+    if (data == NULL) return false;
+
+    unsigned int *label = data;
+    unsigned int *parent = data + roomsX;
+    unsigned int *first = data + 2*roomsX;          // 2*roomsX labels
+    unsigned int *last = data + 4*roomsX;
+    unsigned int *carried = data + 5*roomsX;
+
+    MazeGenRandom random = { .seed = seed };
+
+    // Every room of the first row is in its own set
+    for (int x = 0; x < roomsX; x++) label[x] = (unsigned int)x + roomsX;
+
+    for (int y = 0; y < roomsY; y++)
+    {
+        bool lastRow = (y == (roomsY - 1));
+
+        // Rebuild sets from labels: rooms with the same label (connected from above) share a root
+        memset(first, 0xff, 2*(size_t)roomsX*sizeof(unsigned int));
+
+        for (int x = 0; x < roomsX; x++)
+        {
+            if (first[label[x]] == 0xffffffff) first[label[x]] = (unsigned int)x;
+            parent[x] = first[label[x]];
+
+            MazeGenCarve(grid, roomsX, y*roomsX + x, -1);
+        }
+
+        // Join adjacent rooms of different sets randomly, last row joins all of them
+        for (int x = 0; x < (roomsX - 1); x++)
+        {
+            unsigned int rootA = MazeGenFind(parent, (unsigned int)x);
+            unsigned int rootB = MazeGenFind(parent, (unsigned int)x + 1);
+
+            if ((rootA != rootB) && (lastRow || MazeGenRandomBits(&random, 1)))
+            {
+                parent[rootB] = rootA;
+                MazeGenCarve(grid, roomsX, y*roomsX + x, 3);
+            }
+        }
+
+        if (lastRow) break;
+
+        // Carry every set down at least once: random rooms are carried,
+        // sets not carried at the end carry their last room
+        for (int x = 0; x < roomsX; x++) carried[x] = 0;
+
+        for (int x = 0; x < roomsX; x++)
+        {
+            unsigned int root = MazeGenFind(parent, (unsigned int)x);
+            last[root] = (unsigned int)x;
+
+            if (MazeGenRandomBits(&random, 1))
+            {
+                carried[root] = 1;
+                label[x] = root;
+            }
+            else label[x] = (unsigned int)x + roomsX;     // New set, labels never collide with roots
+        }
+
+        for (int x = 0; x < roomsX; x++)
+        {
+            if ((parent[x] == (unsigned int)x) && !carried[x]) label[last[x]] = (unsigned int)x;
+        }
+
+        for (int x = 0; x < roomsX; x++)
+        {
+            if (label[x] < (unsigned int)roomsX) MazeGenCarve(grid, roomsX, y*roomsX + x, 1);
+        }
+    }
+
+    MAZE_FREE(data);
+
+    MazeGenConnectEnd(grid);
+
+    return true;
+}
+
+// Get algorithm name (i.e. "kruskal")
+const char *GetMazeGenAlgorithmName(int algorithm)
+{
+    switch (algorithm)
+    {
+        case MAZE_GEN_GRID: return "grid";
+        case MAZE_GEN_KRUSKAL: return "kruskal";
+        case MAZE_GEN_BACKTRACKER: return "backtracker";
+        case MAZE_GEN_WILSON: return "wilson";
+        case MAZE_GEN_ELLER: return "eller";
+        default: return "unknown";
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+// Get random bits (count up to 32)
+static unsigned int MazeGenRandomBits(MazeGenRandom *random, int count)
+{
+    if (random->bitCount < count)
+    {
+        unsigned int value = GetMazeRandom(random->seed, (int)random->counter, (int)(random->counter >> 32), MAZE_RANDOM_ALGORITHM);
+        random->bits |= (uint64_t)value << random->bitCount;
+        random->bitCount += 32;
+        random->counter++;
+    }
+
+    unsigned int bits = (unsigned int)(random->bits & ((1ull << count) - 1));
+    random->bits >>= count;
+    random->bitCount -= count;
+
+    return bits;
+}
+
+// Get random value in range [0, count - 1], count up to 4
+static int MazeGenRandomChoice(MazeGenRandom *random, int count)
+{
+    if (count <= 1) return 0;
+    if (count == 2) return (int)MazeGenRandomBits(random, 1);
+
+    // Reject values out of range, no modulo bias
+    int value = (int)MazeGenRandomBits(random, 2);
+    while (value >= count) value = (int)MazeGenRandomBits(random, 2);
+
+    return value;
+}
+
+// Get index permutation (Feistel network), bijection over [0, 2^(2*halfBits))
+static uint64_t MazeGenPermute(uint64_t index, int halfBits, unsigned int seed)
+{
+    uint64_t mask = (1ull << halfBits) - 1;
+    uint64_t left = index >> halfBits;
+    uint64_t right = index & mask;
+
+    for (int round = 0; round < 4; round++)
+    {
+        uint64_t next = left ^ ((uint64_t)GetMazeRandom(seed, (int)right, (int)(right >> 32), MAZE_RANDOM_SHUFFLE + round*0x100) & mask);
+        left = right;
+        right = next;
+    }
+
+    return (left << halfBits) | right;
+}
+
+// Set every grid cell as wall
+// NOTE: Bits after the last column of every row are kept clear
+static void MazeGenFillWalls(MazeGrid *grid)
+{
+    if (grid->cells == NULL) return;
+
+    uint64_t lastMask = ((grid->width & 63) == 0)? ~0ull : ((1ull << (grid->width & 63)) - 1);
+
+    for (int y = 0; y < grid->height; y++)
+    {
+        uint64_t *row = GetMazeRow(*grid, y);
+
+        memset(row, 0xff, (size_t)grid->stride*sizeof(uint64_t));
+        row[grid->stride - 1] = lastMask;
+    }
+}
+
+// Connect cell (width - 2, height - 2) on even sizes, extra column/row next to the border is kept as wall
+// NOTE: Copying the last room column/row would duplicate its passages (cycles), a single passage is carved instead:
+// the cell is next to the last room, or next to the cell left of it if both sizes are even (corner room diagonal)
+static void MazeGenConnectEnd(MazeGrid *grid)
+{
+    bool evenWidth = (grid->width >= 4) && ((grid->width & 1) == 0);
+    bool evenHeight = (grid->height >= 4) && ((grid->height & 1) == 0);
+
+    if (!evenWidth && !evenHeight) return;
+
+    SetMazeWall(grid, grid->width - 2, grid->height - 2, false);
+    if (evenWidth && evenHeight) SetMazeWall(grid, grid->width - 3, grid->height - 2, false);
+}
+
+// Get neighbour rooms (up to 4), directions: 0 = Up, 1 = Down, 2 = Left, 3 = Right
+static int MazeGenRoomNeighbours(int roomsX, int roomsY, int room, int *neighbours, int *directions)
+{
+    int x = room%roomsX;
+    int y = room/roomsX;
+    int count = 0;
+
+    if (y > 0) { neighbours[count] = room - roomsX; directions[count++] = 0; }
+    if (y < (roomsY - 1)) { neighbours[count] = room + roomsX; directions[count++] = 1; }
+    if (x > 0) { neighbours[count] = room - 1; directions[count++] = 2; }
+    if (x < (roomsX - 1)) { neighbours[count] = room + 1; directions[count++] = 3; }
+
+    return count;
+}
+
+// Carve passage from room in direction (room also carved), direction -1 only carves the room
+static void MazeGenCarve(MazeGrid *grid, int roomsX, int room, int direction)
+{
+    int x = 2*(room%roomsX) + 1;
+    int y = 2*(room/roomsX) + 1;
+
+    SetMazeWall(grid, x, y, false);
+
+    switch (direction)
+    {
+        case 0: SetMazeWall(grid, x, y - 1, false); break;
+        case 1: SetMazeWall(grid, x, y + 1, false); break;
+        case 2: SetMazeWall(grid, x - 1, y, false); break;
+        case 3: SetMazeWall(grid, x + 1, y, false); break;
+        default: break;
+    }
+}
+
+// Get room set root (union-find, path halving)
+static unsigned int MazeGenFind(unsigned int *parent, unsigned int room)
+{
+    while (parent[room] != room)
+    {
+        parent[room] = parent[parent[room]];
+        room = parent[room];
+    }
+
+    return room;
+}
+
+#endif // MAZE_IMPLEMENTATION
+
+#endif // MAZE_GEN_H
@@ -0,0 +1,320 @@
+/**********************************************************************************************
+*
+*   maze_items - Maze collectible items module
+*
+*   Items pool (MazeItems) stored as structure of arrays (cell x, cell y, picked state), with
+*   an occupancy index from cell to item: placing, removing, finding and picking the item of
+*   a cell are O(1), so pickup checks do not depend on items count
+*
+*   Occupancy index is an open addressing hash table (linear probing) sized from the items
+*   count, not from the maze size, removed items are replaced by the last item of the pool
+*
+*   Items can be placed procedurally in bulk (GenMazeItems()) on cells reachable from a flow
+*   field goal (i.e. maze exit), cells are selected with counter-based random values, so the
+*   same seed always places the same items
+*
+*   CONFIGURATION:
+*       #define MAZE_IMPLEMENTATION
+*           Generates the implementation of the module in the including file,
+*           only ONE file of the program should define it
+*
+*   DEPENDENCIES:
+*       maze.h      - MazeGrid, GetMazeRandom(), memory allocators
+*       maze_path.h - FlowField (reachable cells for bulk placement)
+*
+**********************************************************************************************/
+
+#ifndef MAZE_ITEMS_H
+#define MAZE_ITEMS_H
+
+#include "maze.h"                       // Required for: MazeGrid, GetMazeRandom()
+#include "maze_path.h"                  // Required for: FlowField, GetFlowFieldDistance()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define MAZE_ITEMS_ATTEMPTS     32      // Bulk placement random cells tried per requested item
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Maze items pool, structure of arrays
+typedef struct MazeItems {
+    int width;                  // Maze width in cells
+    int height;                 // Maze height in cells
+    int count;                  // Items in pool
+    int capacity;               // Items pool capacity
+    int pickedCount;            // Items picked
+
+    int *x;                     // Item cell x, per item
+    int *y;                     // Item cell y, per item
+    unsigned char *picked;      // Item picked state, per item
+
+    int *slots;                 // Occupancy index: hash table slots, item index (-1: empty slot)
+    int slotCount;              // Hash table size (power of two, twice items capacity)
+
+    unsigned int version;       // Items positions changes counter (items added or removed)
+} MazeItems;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+MazeItems LoadMazeItems(int width, int height, int capacity);       // Load items pool for a maze size (pool grows as required)
+void UnloadMazeItems(MazeItems items);                              // Unload items pool
+void ClearMazeItems(MazeItems *items);                              // Remove all items
+int AddMazeItem(MazeItems *items, int x, int y);                    // Add item at cell, returns item index (-1 if cell has an item or out of bounds)
+bool RemoveMazeItem(MazeItems *items, int x, int y);                // Remove item at cell, last item takes its index
+int GetMazeItem(MazeItems items, int x, int y);                     // Get item index at cell, -1 if no item
+bool PickMazeItem(MazeItems *items, int x, int y);                  // Pick item at cell, true if an item was picked (not picked before)
+void ResetMazeItems(MazeItems *items);                              // Set all items as not picked
+int GenMazeItems(MazeItems *items, MazeGrid grid, FlowField field, int count, unsigned int seed);  // Place items on random cells reachable from field goal, returns items placed
+
+#if defined(__cplusplus)
+}
+#endif
+
+/***********************************************************************************
+*
+*   MAZE ITEMS IMPLEMENTATION
+*
+************************************************************************************/
+#if defined(MAZE_IMPLEMENTATION)
+
+#include <string.h>                     // Required for: memset()
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static int GetMazeItemHome(MazeItems items, int x, int y);          // Get cell hash table home slot (cell index hash)
+static int GetMazeItemSlot(MazeItems items, int x, int y);          // Get cell hash table slot: item slot or empty slot where it would be added
+static bool ResizeMazeItems(MazeItems *items, int capacity);        // Resize items pool and rebuild occupancy index
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Load items pool for a maze size (pool grows as required)
+MazeItems LoadMazeItems(int width, int height, int capacity)
+{
+    MazeItems items = { 0 };
+
+    if ((width <= 0) || (height <= 0)) return items;
+
+    items.width = width;
+    items.height = height;
+
+    if (!ResizeMazeItems(&items, (capacity > 16)? capacity : 16))
+    {
+        UnloadMazeItems(items);
+        return (MazeItems){ 0 };
+    }
+
+    return items;
+}
+
+// Unload items pool
+void UnloadMazeItems(MazeItems items)
+{
+    MAZE_FREE(items.x);
+    MAZE_FREE(items.y);
+    MAZE_FREE(items.picked);
+    MAZE_FREE(items.slots);
+}
+
+// Remove all items
+void ClearMazeItems(MazeItems *items)
+{
+    if (items->slots == NULL) return;
+
+    items->count = 0;
+    items->pickedCount = 0;
+    items->version++;
+    memset(items->slots, 0xff, (size_t)items->slotCount*sizeof(int));
+}
+
+// Add item at cell, returns item index (-1 if cell has an item or out of bounds)
+int AddMazeItem(MazeItems *items, int x, int y)
+{
+    if ((items->slots == NULL) || ((unsigned int)x >= (unsigned int)items->width) || ((unsigned int)y >= (unsigned int)items->height)) return -1;
+
+    int slot = GetMazeItemSlot(*items, x, y);
+
+    if (items->slots[slot] >= 0) return -1;
+
+    if (items->count >= items->capacity)
+    {
+        if ((items->capacity > 0x3fffffff/2) || !ResizeMazeItems(items, items->capacity*2)) return -1;
+        slot = GetMazeItemSlot(*items, x, y);
+    }
+
+    int index = items->count++;
+    items->x[index] = x;
+    items->y[index] = y;
+    items->picked[index] = 0;
+    items->slots[slot] = index;
+    items->version++;
+
+    return index;
+}
+
+// Remove item at cell, last item takes its index
+// NOTE: Hash table slot is removed with backward shift (no tombstones, lookups stay short)
+bool RemoveMazeItem(MazeItems *items, int x, int y)
+{
+    if ((items->slots == NULL) || ((unsigned int)x >= (unsigned int)items->width) || ((unsigned int)y >= (unsigned int)items->height)) return false;
+
+    int slot = GetMazeItemSlot(*items, x, y);
+    int index = items->slots[slot];
+
+    if (index < 0) return false;
+
+    int mask = items->slotCount - 1;
+    int hole = slot;
+
+    for (int next = (slot + 1) & mask; items->slots[next] >= 0; next = (next + 1) & mask)
+    {
+        int item = items->slots[next];
+        int home = GetMazeItemHome(*items, items->x[item], items->y[item]);
+
+        // Item can fill the hole if its home slot is not between hole and its slot (cyclic)
+        bool between = (hole <= next)? ((home > hole) && (home <= next)) : ((home > hole) || (home <= next));
+
+        if (!between)
+        {
+            items->slots[hole] = item;
+            hole = next;
+        }
+    }
+
+    items->slots[hole] = -1;
+
+    if (items->picked[index]) items->pickedCount--;
+
+    // Last item is moved to removed item index
+    int last = items->count - 1;
+
+    if (index != last)
+    {
+        items->slots[GetMazeItemSlot(*items, items->x[last], items->y[last])] = index;
+        items->x[index] = items->x[last];
+        items->y[index] = items->y[last];
+        items->picked[index] = items->picked[last];
+    }
+
+    items->count--;
+    items->version++;
+
+    return true;
+}
+
+// Get item index at cell, -1 if no item
+int GetMazeItem(MazeItems items, int x, int y)
+{
+    if ((items.slots == NULL) || ((unsigned int)x >= (unsigned int)items.width) || ((unsigned int)y >= (unsigned int)items.height)) return -1;
+
+    return items.slots[GetMazeItemSlot(items, x, y)];
+}
+
+// Pick item at cell, true if an item was picked (not picked before)
+bool PickMazeItem(MazeItems *items, int x, int y)
+{
+    int index = GetMazeItem(*items, x, y);
+
+    if ((index < 0) || items->picked[index]) return false;
+
+    items->picked[index] = 1;
+    items->pickedCount++;
+
+    return true;
+}
+
+// Set all items as not picked
+void ResetMazeItems(MazeItems *items)
+{
+    if (items->picked != NULL) memset(items->picked, 0, (size_t)items->count);
+    items->pickedCount = 0;
+}
+
+// Place items on random cells reachable from field goal, returns items placed
+// NOTE: Goal cell is never selected, cells with an item are skipped,
+// up to MAZE_ITEMS_ATTEMPTS random cells are tried per requested item
+int GenMazeItems(MazeItems *items, MazeGrid grid, FlowField field, int count, unsigned int seed)
+{
+    if ((grid.width != items->width) || (grid.height != items->height) || (count <= 0)) return 0;
+
+    int placed = 0;
+    long long attempts = (long long)count*MAZE_ITEMS_ATTEMPTS;
+
+    for (long long i = 0; (i < attempts) && (placed < count); i++)
+    {
+        int x = (int)(GetMazeRandom(seed, (int)i, (int)(i >> 31), MAZE_RANDOM_ITEM)%(unsigned int)grid.width);
+        int y = (int)(GetMazeRandom(seed, (int)i, (int)(i >> 31) + 1, MAZE_RANDOM_ITEM)%(unsigned int)grid.height);
+
+        if (GetFlowFieldDistance(field, x, y) <= 0) continue;   // Wall, not reachable or goal cell
+        if (AddMazeItem(items, x, y) >= 0) placed++;
+    }
+
+    return placed;
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+// Get cell hash table home slot (cell index hash)
+// NOTE: Cell index is hashed with a multiplicative (Fibonacci) hash
+static int GetMazeItemHome(MazeItems items, int x, int y)
+{
+    uint64_t key = (uint64_t)y*items.width + x;
+
+    return (int)((key*0x9e3779b97f4a7c15ull) >> 32) & (items.slotCount - 1);
+}
+
+// Get cell hash table slot: item slot or empty slot where it would be added
+// NOTE: Table has at least twice the items slots, an empty slot is always found
+static int GetMazeItemSlot(MazeItems items, int x, int y)
+{
+    int mask = items.slotCount - 1;
+    int slot = GetMazeItemHome(items, x, y);
+
+    while ((items.slots[slot] >= 0) && ((items.x[items.slots[slot]] != x) || (items.y[items.slots[slot]] != y))) slot = (slot + 1) & mask;
+
+    return slot;
+}
+
+// Resize items pool and rebuild occupancy index
+static bool ResizeMazeItems(MazeItems *items, int capacity)
+{
+    int *x = (int *)MAZE_REALLOC(items->x, (size_t)capacity*sizeof(int));
+    if (x != NULL) items->x = x;
+    int *y = (int *)MAZE_REALLOC(items->y, (size_t)capacity*sizeof(int));
+    if (y != NULL) items->y = y;
+    unsigned char *picked = (unsigned char *)MAZE_REALLOC(items->picked, (size_t)capacity);
+    if (picked != NULL) items->picked = picked;
+
+    int slotCount = 1;
+    while (slotCount < capacity*2) slotCount *= 2;
+    int *slots = (int *)MAZE_MALLOC((size_t)slotCount*sizeof(int));
+
+    if ((x == NULL) || (y == NULL) || (picked == NULL) || (slots == NULL))
+    {
+        MAZE_FREE(slots);
+        return false;
+    }
+
+    MAZE_FREE(items->slots);
+    items->slots = slots;
+    items->slotCount = slotCount;
+    items->capacity = capacity;
+    memset(items->slots, 0xff, (size_t)slotCount*sizeof(int));
+
+    for (int i = 0; i < items->count; i++) items->slots[GetMazeItemSlot(*items, items->x[i], items->y[i])] = i;
+
+    return true;
+}
+
+#endif // MAZE_IMPLEMENTATION
+
+#endif // MAZE_ITEMS_H
@@ -0,0 +1,464 @@
+/**********************************************************************************************
+*
+*   maze_mesh - Maze 3D mesh generation module
+*
+*   Generates the 3D mesh of a MazeGrid region (walls are 1x1x1 cubes, walkable cells have
+*   floor and ceiling), same layout and atlas tiles than raylib GenMeshCubicmap(), but coplanar
+*   faces are merged into maximal rectangles (greedy meshing): wall tops, floors and ceilings
+*   are merged in both directions, wall sides are merged along their row/column. Faces hidden
+*   between two walls are never generated, also across region borders (neighbour cells are read
+*   from the grid), so a maze can be split in chunks without extra faces
+*
+*   Merged faces cover several cells, their texture coordinates are in cells (texcoords, tiled
+*   with fract()) and the atlas tile origin is stored per vertex (texcoords2), the maze mesh
+*   shader (LoadMazeMeshShader()) must be used to draw them
+*
+*   Biome atlas layout (same as raylib cubicmap): 2x2 tiles
+*       - Top-left:     Wall sides facing +X and +Z
+*       - Top-right:    Wall sides facing -X and -Z
+*       - Bottom-left:  Wall tops and ceiling
+*       - Bottom-right: Floor
+*
+*   CONFIGURATION:
+*       #define MAZE_IMPLEMENTATION
+*           Generates the implementation of the module in the including file,
+*           only ONE file of the program should define it
+*
+*   DEPENDENCIES:
+*       raylib.h    - Mesh, Shader, mesh upload
+*       maze.h      - MazeGrid
+*
+**********************************************************************************************/
+
+#ifndef MAZE_MESH_H
+#define MAZE_MESH_H
+
+#include "raylib.h"                     // Required for: Mesh, Shader, Rectangle
+#include "maze.h"                       // Required for: MazeGrid
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+// Maximum region size in cells (width and height) for a single mesh
+// NOTE: Mesh indices are 16 bit, worst case region (checkerboard) requires 20 vertex per cell
+#define MAZE_MESH_MAX_REGION    48
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+// Generate maze region mesh (greedy meshing), vertex positions are relative to region origin
+// NOTE: Cell (x, y) is centered at (x - rec.x, 0.5, y - rec.y), mesh is uploaded to GPU
+Mesh GenMeshMaze(MazeGrid grid, Rectangle rec);
+Mesh GenMeshMazeData(MazeGrid grid, Rectangle rec);     // Generate maze region mesh data (CPU only, safe to call from any thread), upload with UploadMesh()
+Shader LoadMazeMeshShader(void);        // Load maze mesh shader (atlas tiles repeated on merged faces)
+
+#if defined(__cplusplus)
+}
+#endif
+
+/***********************************************************************************
+*
+*   MAZE MESH IMPLEMENTATION
+*
+************************************************************************************/
+
+#if defined(MAZE_IMPLEMENTATION)
+
+#include <stdlib.h>                     // Required for: malloc(), free()
+
+#if defined(PLATFORM_ANDROID) || defined(PLATFORM_WEB)
+    #define MESH_GLSL_VERSION   100
+#else
+    #define MESH_GLSL_VERSION   330
+#endif
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Mesh data being generated (indexed quads)
+typedef struct MeshBuilder {
+    Mesh mesh;                  // Mesh data, buffers allocated for worst case
+    int quadCount;              // Quads added
+    float originX;              // Region origin (cell x)
+    float originZ;              // Region origin (cell y)
+} MeshBuilder;
+
+// Face directions, atlas tile origin (texcoords2) for every direction
+typedef enum {
+    MESH_FACE_TOP = 0,          // Wall top, +Y
+    MESH_FACE_FLOOR,            // Walkable floor, +Y
+    MESH_FACE_CEILING,          // Walkable ceiling, -Y
+    MESH_FACE_EAST,             // Wall side, +X
+    MESH_FACE_WEST,             // Wall side, -X
+    MESH_FACE_SOUTH,            // Wall side, +Z
+    MESH_FACE_NORTH             // Wall side, -Z
+} MeshFace;
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static const Vector2 meshFaceTiles[7] = { { 0.0f, 0.5f }, { 0.5f, 0.5f }, { 0.0f, 0.5f }, { 0.0f, 0.0f }, { 0.5f, 0.0f }, { 0.0f, 0.0f }, { 0.5f, 0.0f } };
+static const Vector3 meshFaceNormals[7] = { { 0, 1, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 1, 0, 0 }, { -1, 0, 0 }, { 0, 0, 1 }, { 0, 0, -1 } };
+
+// Maze mesh shader: texcoords are in cells, repeated inside the atlas tile (texcoords2 origin)
+static const char *meshVertexShader =
+#if MESH_GLSL_VERSION == 330
+    "#version 330\n"
+    "in vec3 vertexPosition;\n"
+    "in vec2 vertexTexCoord;\n"
+    "in vec2 vertexTexCoord2;\n"
+    "uniform mat4 mvp;\n"
+    "out vec2 fragTexCoord;\n"
+    "out vec2 fragTileOrigin;\n"
+#else
+    "#version 100\n"
+    "attribute vec3 vertexPosition;\n"
+    "attribute vec2 vertexTexCoord;\n"
+    "attribute vec2 vertexTexCoord2;\n"
+    "uniform mat4 mvp;\n"
+    "varying vec2 fragTexCoord;\n"
+    "varying vec2 fragTileOrigin;\n"
+#endif
+    "void main()\n"
+    "{\n"
+    "    fragTexCoord = vertexTexCoord;\n"
+    "    fragTileOrigin = vertexTexCoord2;\n"
+    "    gl_Position = mvp*vec4(vertexPosition, 1.0);\n"
+    "}\n";
+
+static const char *meshFragmentShader =
+#if MESH_GLSL_VERSION == 330
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec2 fragTileOrigin;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec4 colDiffuse;\n"
+    "out vec4 finalColor;\n"
+    "void main()\n"
+    "{\n"
+    "    finalColor = texture(texture0, fragTileOrigin + fract(fragTexCoord)*0.5)*colDiffuse;\n"
+    "}\n";
+#else
+    "#version 100\n"
+    "precision mediump float;\n"
+    "varying vec2 fragTexCoord;\n"
+    "varying vec2 fragTileOrigin;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec4 colDiffuse;\n"
+    "void main()\n"
+    "{\n"
+    "    gl_FragColor = texture2D(texture0, fragTileOrigin + fract(fragTexCoord)*0.5)*colDiffuse;\n"
+    "}\n";
+#endif
+
+//----------------------------------------------------------------------------------
+// Module specific Functions Declaration
+//----------------------------------------------------------------------------------
+static inline int MeshLowestBit(uint64_t word);                   // Get index of lowest set bit (word must not be 0)
+static uint64_t MeshRowBits(MazeGrid grid, int x, int y, int count);   // Get cells bits of a grid row segment, out of grid cells are walkable (0)
+static void MeshAddQuad(MeshBuilder *builder, MeshFace face, float x0, float z0, float x1, float z1);  // Add face quad covering cells area
+static void MeshAddRects(MeshBuilder *builder, MeshFace face, uint64_t *rows, int x, int y, int width, int height); // Add faces for cells in rows, merged in maximal rectangles
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Generate maze region mesh (greedy meshing), vertex positions are relative to region origin
+Mesh GenMeshMaze(MazeGrid grid, Rectangle rec)
+{
+    Mesh mesh = GenMeshMazeData(grid, rec);
+
+    // Upload vertex data to GPU (static mesh)
+    if (mesh.vertexCount > 0) UploadMesh(&mesh, false);
+
+    return mesh;
+}
+
+// Generate maze region mesh data (CPU only, safe to call from any thread)
+// NOTE: No GPU resources are created, mesh must be uploaded with UploadMesh() on main thread
+Mesh GenMeshMazeData(MazeGrid grid, Rectangle rec)
+{
+    Mesh mesh = { 0 };
+
+    int x = (rec.x < 0)? 0 : (int)rec.x;
+    int y = (rec.y < 0)? 0 : (int)rec.y;
+    int width = ((int)(rec.x + rec.width) < grid.width)? (int)(rec.x + rec.width) - x : grid.width - x;
+    int height = ((int)(rec.y + rec.height) < grid.height)? (int)(rec.y + rec.height) - y : grid.height - y;
+
+    if ((width <= 0) || (height <= 0)) return mesh;
+    if ((width > MAZE_MESH_MAX_REGION) || (height > MAZE_MESH_MAX_REGION))
+    {
+        TraceLog(LOG_WARNING, "MESH: Maze region too big (%ix%i), maximum is %ix%i", width, height, MAZE_MESH_MAX_REGION, MAZE_MESH_MAX_REGION);
+        return mesh;
+    }
+
+    // Region rows (cells bits), one extra row above and below for wall sides
+    // NOTE: Bit i is cell (x + i), region is at most 48 cells wide
+    uint64_t walls[MAZE_MESH_MAX_REGION + 2] = { 0 };
+    uint64_t rects[MAZE_MESH_MAX_REGION] = { 0 };
+    uint64_t mask = (1ull << width) - 1;
+
+    for (int i = -1; i <= height; i++) walls[i + 1] = MeshRowBits(grid, x, y + i, width);
+
+    // Buffers allocated for worst case (5 quads per cell) and shrinked at the end
+    int maxQuads = width*height*5;
+
+    MeshBuilder builder = { 0 };
+    builder.originX = (float)x;
+    builder.originZ = (float)y;
+    builder.mesh.vertices = (float *)RL_MALLOC(maxQuads*4*3*sizeof(float));
+    builder.mesh.texcoords = (float *)RL_MALLOC(maxQuads*4*2*sizeof(float));
+    builder.mesh.texcoords2 = (float *)RL_MALLOC(maxQuads*4*2*sizeof(float));
+    builder.mesh.normals = (float *)RL_MALLOC(maxQuads*4*3*sizeof(float));
+    builder.mesh.indices = (unsigned short *)RL_MALLOC(maxQuads*6*sizeof(unsigned short));
+
+    // Wall tops
+    for (int i = 0; i < height; i++) rects[i] = walls[i + 1];
+    MeshAddRects(&builder, MESH_FACE_TOP, rects, x, y, width, height);
+
+    // Floors and ceilings (same rectangles)
+    for (int i = 0; i < height; i++) rects[i] = ~walls[i + 1] & mask;
+    MeshAddRects(&builder, MESH_FACE_FLOOR, rects, x, y, width, height);
+    for (int i = 0; i < height; i++) rects[i] = ~walls[i + 1] & mask;
+    MeshAddRects(&builder, MESH_FACE_CEILING, rects, x, y, width, height);
+
+    // Wall sides facing -Z/+Z: walls with walkable cell above/below, merged along the row
+    for (int i = 0; i < height; i++)
+    {
+        for (int side = 0; side < 2; side++)
+        {
+            uint64_t faces = walls[i + 1] & ~walls[(side == 0)? i : i + 2];
+            float z = y + i + ((side == 0)? -0.5f : 0.5f);
+
+            while (faces != 0)
+            {
+                // Run of consecutive cells [start, end)
+                int start = MeshLowestBit(faces);
+                int end = start + MeshLowestBit(~(faces >> start));
+                faces &= ~0ull << end;
+
+                if (side == 0) MeshAddQuad(&builder, MESH_FACE_NORTH, x + start - 0.5f, z, x + end - 0.5f, z);
+                else MeshAddQuad(&builder, MESH_FACE_SOUTH, x + start - 0.5f, z, x + end - 0.5f, z);
+            }
+        }
+    }
+
+    // Wall sides facing -X/+X: walls with walkable cell left/right, merged along the column
+    // NOTE: Faces of all columns are computed at once (row bits), only columns where a run
+    // starts or ends are visited
+    int runStart[2][MAZE_MESH_MAX_REGION] = { 0 };
+    uint64_t previous[2] = { 0 };
+
+    for (int i = 0; i <= height; i++)
+    {
+        uint64_t faces[2] = { 0 };
+
+        if (i < height)
+        {
+            uint64_t left = MeshRowBits(grid, x - 1, y + i, 1);
+            uint64_t right = MeshRowBits(grid, x + width, y + i, 1);
+            faces[0] = walls[i + 1] & ~((walls[i + 1] << 1) | left);
+            faces[1] = walls[i + 1] & ~((walls[i + 1] >> 1) | (right << (width - 1)));
+        }
+
+        for (int side = 0; side < 2; side++)
+        {
+            uint64_t changed = previous[side] ^ faces[side];
+
+            while (changed != 0)
+            {
+                int column = MeshLowestBit(changed);
+                changed &= changed - 1;
+
+                if ((faces[side] >> column) & 1) runStart[side][column] = i;
+                else
+                {
+                    float cx = x + column + ((side == 0)? -0.5f : 0.5f);
+
+                    if (side == 0) MeshAddQuad(&builder, MESH_FACE_WEST, cx, y + runStart[side][column] - 0.5f, cx, y + i - 0.5f);
+                    else MeshAddQuad(&builder, MESH_FACE_EAST, cx, y + runStart[side][column] - 0.5f, cx, y + i - 0.5f);
+                }
+            }
+
+            previous[side] = faces[side];
+        }
+    }
+
+    // Shrink buffers to generated quads
+    // NOTE: Every cell has a wall top or a floor, there is at least one quad
+    Mesh *result = &builder.mesh;
+    result->vertexCount = builder.quadCount*4;
+    result->triangleCount = builder.quadCount*2;
+    result->vertices = (float *)RL_REALLOC(result->vertices, result->vertexCount*3*sizeof(float));
+    result->texcoords = (float *)RL_REALLOC(result->texcoords, result->vertexCount*2*sizeof(float));
+    result->texcoords2 = (float *)RL_REALLOC(result->texcoords2, result->vertexCount*2*sizeof(float));
+    result->normals = (float *)RL_REALLOC(result->normals, result->vertexCount*3*sizeof(float));
+    result->indices = (unsigned short *)RL_REALLOC(result->indices, result->triangleCount*3*sizeof(unsigned short));
+
+    return builder.mesh;
+}
+
+// Load maze mesh shader (atlas tiles repeated on merged faces)
+Shader LoadMazeMeshShader(void)
+{
+    return LoadShaderFromMemory(meshVertexShader, meshFragmentShader);
+}
+
+//----------------------------------------------------------------------------------
+// Module specific Functions Definition
+//----------------------------------------------------------------------------------
+// Get index of lowest set bit (word must not be 0)
+static inline int MeshLowestBit(uint64_t word)
+{
+#if defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanForward64(&index, word);
+    return (int)index;
+#else
+    return __builtin_ctzll(word);
+#endif
+}
+
+// Get cells bits of a grid row segment, out of grid cells are walkable (0)
+// NOTE: Bit i is cell (x + i), count must be 64 or lower
+static uint64_t MeshRowBits(MazeGrid grid, int x, int y, int count)
+{
+    if ((y < 0) || (y >= grid.height) || (x < 0) || (x >= grid.width)) return 0;
+    if (x + count > grid.width) count = grid.width - x;
+
+    const uint64_t *row = GetMazeRow(grid, y);
+    int k = x >> 6;
+    int shift = x & 63;
+    uint64_t bits = row[k] >> shift;
+
+    if ((shift != 0) && (k + 1 < grid.stride)) bits |= row[k + 1] << (64 - shift);
+    if (count < 64) bits &= (1ull << count) - 1;
+
+    return bits;
+}
+
+// Add face quad covering cells area, (x0, z0) to (x1, z1) in cell coordinates (cell centers are integers)
+// NOTE: Vertical faces have x0 == x1 or z0 == z1, texcoords are in cells (tiled by the shader)
+static void MeshAddQuad(MeshBuilder *builder, MeshFace face, float x0, float z0, float x1, float z1)
+{
+    // Quad corners, counter-clockwise seen from the face normal: top-left, bottom-left, bottom-right, top-right
+    Vector3 corners[4] = { 0 };
+    float sizeU = 1.0f;
+    float sizeV = 1.0f;
+
+    x0 -= builder->originX;
+    x1 -= builder->originX;
+    z0 -= builder->originZ;
+    z1 -= builder->originZ;
+
+    switch (face)
+    {
+        case MESH_FACE_TOP:
+        case MESH_FACE_FLOOR:
+        {
+            float y = (face == MESH_FACE_TOP)? 1.0f : 0.0f;
+            corners[0] = (Vector3){ x0, y, z0 };
+            corners[1] = (Vector3){ x0, y, z1 };
+            corners[2] = (Vector3){ x1, y, z1 };
+            corners[3] = (Vector3){ x1, y, z0 };
+            sizeU = x1 - x0;
+            sizeV = z1 - z0;
+        } break;
+        case MESH_FACE_CEILING:
+        {
+            corners[0] = (Vector3){ x0, 1.0f, z0 };
+            corners[1] = (Vector3){ x1, 1.0f, z0 };
+            corners[2] = (Vector3){ x1, 1.0f, z1 };
+            corners[3] = (Vector3){ x0, 1.0f, z1 };
+            sizeU = x1 - x0;
+            sizeV = z1 - z0;
+        } break;
+        case MESH_FACE_NORTH:
+        {
+            corners[0] = (Vector3){ x1, 1.0f, z0 };
+            corners[1] = (Vector3){ x1, 0.0f, z0 };
+            corners[2] = (Vector3){ x0, 0.0f, z0 };
+            corners[3] = (Vector3){ x0, 1.0f, z0 };
+            sizeU = x1 - x0;
+        } break;
+        case MESH_FACE_SOUTH:
+        {
+            corners[0] = (Vector3){ x0, 1.0f, z0 };
+            corners[1] = (Vector3){ x0, 0.0f, z0 };
+            corners[2] = (Vector3){ x1, 0.0f, z0 };
+            corners[3] = (Vector3){ x1, 1.0f, z0 };
+            sizeU = x1 - x0;
+        } break;
+        case MESH_FACE_EAST:
+        {
+            corners[0] = (Vector3){ x0, 1.0f, z1 };
+            corners[1] = (Vector3){ x0, 0.0f, z1 };
+            corners[2] = (Vector3){ x0, 0.0f, z0 };
+            corners[3] = (Vector3){ x0, 1.0f, z0 };
+            sizeU = z1 - z0;
+        } break;
+        case MESH_FACE_WEST:
+        {
+            corners[0] = (Vector3){ x0, 1.0f, z0 };
+            corners[1] = (Vector3){ x0, 0.0f, z0 };
+            corners[2] = (Vector3){ x0, 0.0f, z1 };
+            corners[3] = (Vector3){ x0, 1.0f, z1 };
+            sizeU = z1 - z0;
+        } break;
+        default: break;
+    }
+
+    const float texcoords[4][2] = { { 0.0f, 0.0f }, { 0.0f, sizeV }, { sizeU, sizeV }, { sizeU, 0.0f } };
+    Mesh *mesh = &builder->mesh;
+    int vertex = builder->quadCount*4;
+
+    for (int i = 0; i < 4; i++)
+    {
+        mesh->vertices[(vertex + i)*3 + 0] = corners[i].x;
+        mesh->vertices[(vertex + i)*3 + 1] = corners[i].y;
+        mesh->vertices[(vertex + i)*3 + 2] = corners[i].z;
+        mesh->normals[(vertex + i)*3 + 0] = meshFaceNormals[face].x;
+        mesh->normals[(vertex + i)*3 + 1] = meshFaceNormals[face].y;
+        mesh->normals[(vertex + i)*3 + 2] = meshFaceNormals[face].z;
+        mesh->texcoords[(vertex + i)*2 + 0] = texcoords[i][0];
+        mesh->texcoords[(vertex + i)*2 + 1] = texcoords[i][1];
+        mesh->texcoords2[(vertex + i)*2 + 0] = meshFaceTiles[face].x;
+        mesh->texcoords2[(vertex + i)*2 + 1] = meshFaceTiles[face].y;
+    }
+
+    const unsigned short quadIndices[6] = { 0, 1, 2, 0, 2, 3 };
+    for (int i = 0; i < 6; i++) mesh->indices[builder->quadCount*6 + i] = (unsigned short)(vertex + quadIndices[i]);
+
+    builder->quadCount++;
+}
+
+// Add faces for cells in rows, merged in maximal rectangles
+// NOTE: Greedy meshing: the lowest run of a row is extended down while the next rows contain
+// the whole run, rows bits are cleared as they are used
+static void MeshAddRects(MeshBuilder *builder, MeshFace face, uint64_t *rows, int x, int y, int width, int height)
+{
+    (void)width;
+
+    for (int i = 0; i < height; i++)
+    {
+        while (rows[i] != 0)
+        {
+            int start = MeshLowestBit(rows[i]);
+            int end = start + MeshLowestBit(~(rows[i] >> start));
+            uint64_t run = (~0ull << start) & ~(~0ull << end);
+
+            int last = i + 1;
+            while ((last < height) && ((rows[last] & run) == run)) last++;
+            for (int j = i; j < last; j++) rows[j] &= ~run;
+
+            MeshAddQuad(builder, face, x + start - 0.5f, y + i - 0.5f, x + end - 0.5f, y + last - 0.5f);
+        }
+    }
+}
+
+#endif // MAZE_IMPLEMENTATION
+
+#endif // MAZE_MESH_H
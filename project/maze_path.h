@@ -0,0 +1,1616 @@
+/**********************************************************************************************
+*
+*   maze_path - Maze pathfinding module
+*
+*   Shortest path search over MazeGrid (4-connected, uniform cost), using a reusable
+*   search context (PathFinder): all per-cell search data is allocated once and reused
+*   between queries, a search stamp invalidates the previous search in O(1)
+*
+*   Supported algorithms:
+*       PATH_ASTAR  - A* with Manhattan heuristic, every cell is a search node
+*       PATH_JPS    - Jump Point Search (4-connected variant), straight corridors are
+*                     skipped using bit scans over the grid row words, only jump points
+*                     are search nodes
+*
+*   Incremental replanning (PathPlanner) is implemented with D* Lite: search data is kept
+*   between updates, so moving the start cell or changing grid cells only repairs the
+*   affected part of the search instead of solving from scratch
+*
+*   Flow fields (FlowField) store the distance to a goal cell for every cell, so the next step
+*   towards the goal is available in O(1) from anywhere. Distances are computed with a
+*   word-parallel BFS over the grid words (64 cells per operation, only words in the frontier
+*   are processed), big frontiers are expanded by several threads. Editing a cell only
+*   recomputes the cells whose distance depends on it
+*
+*   CONFIGURATION:
+*       #define MAZE_IMPLEMENTATION
+*           Generates the implementation of the module in the including file,
+*           only ONE file of the program should define it
+*
+*       #define MAZE_NO_THREADS
+*           Disables worker threads (C11 threads.h), flow fields are computed by the calling thread
+*
+*   DEPENDENCIES:
+*       maze.h      - MazeGrid, Point, memory allocators
+*       threads.h   - Flow field worker threads (C11), not required if MAZE_NO_THREADS is defined
+*
+**********************************************************************************************/
+
+#ifndef MAZE_PATH_H
+#define MAZE_PATH_H
+
+#include "maze.h"                       // Required for: MazeGrid, Point
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Open list bucket (stack of cell indices)
+typedef struct PathBucket {
+    int *cells;                 // Cell indices (y*width + x)
+    int count;                  // Cells in bucket
+    int capacity;               // Bucket capacity
+} PathBucket;
+
+// Open list node for searches with arbitrary step costs (binary min-heap)
+typedef struct PathHeapNode {
+    long long key;              // Node priority, lower first
+    int cell;                   // Cell index (y*width + x)
+} PathHeapNode;
+
+// Pathfinding search context, reusable between queries
+typedef struct PathFinder {
+    int width;                  // Search area width in cells
+    int height;                 // Search area height in cells
+
+    int *gScore;                // Cost from start, per cell
+    unsigned char *parentDir;   // Direction to parent cell, per cell
+    unsigned char *visited;     // Search stamp when cell was reached, per cell
+    unsigned char *closed;      // Search stamp when cell was expanded, per cell
+    unsigned char stamp;        // Current search stamp, cells with an old stamp are unvisited
+
+    PathBucket open[2];         // Open list (A*): cells with f = F and f = F + 2 (F: current lowest f)
+    PathHeapNode *heap;         // Open list (JPS): jump points ordered by f
+    int heapCount;              // Open list nodes
+    int heapCapacity;           // Open list capacity
+
+    Point *points;              // Last path found, from start to end (both included)
+    int pointCount;             // Last path points
+    int pointCapacity;          // Path points capacity
+
+    int expanded;               // Nodes expanded by last search
+} PathFinder;
+
+// Indexed priority queue (binary min-heap), supports key updates and removal
+typedef struct PathQueue {
+    PathHeapNode *nodes;        // Heap nodes
+    int count;                  // Nodes in queue
+    int capacity;               // Queue capacity
+    int *index;                 // Position of cell in heap, per cell (-1: not in queue)
+} PathQueue;
+
+// Incremental path planner (D* Lite), search goes from goal to start
+typedef struct PathPlanner {
+    int width;                  // Search area width in cells
+    int height;                 // Search area height in cells
+
+    int *gScore;                // Cost to goal, per cell
+    int *rhs;                   // One-step lookahead cost to goal, per cell
+    PathQueue queue;            // Inconsistent cells (gScore != rhs)
+
+    Point start;                // Current start cell
+    Point goal;                 // Goal cell
+    Point last;                 // Start cell when keys were last adjusted
+    int keyModifier;            // Key modifier (km), accumulated start movement
+
+    Point *points;              // Last path, from start to goal (both included)
+    int pointCount;             // Last path points
+    int pointCapacity;          // Path points capacity
+
+    int expanded;               // Cells expanded by last update
+} PathPlanner;
+
+// Flow field frontier entry: cells of one grid word reached on the same BFS level
+typedef struct FlowWord {
+    int x;                      // Grid word column (cell x/64)
+    int y;                      // Grid row
+    uint64_t bits;              // Cells bits in word
+} FlowWord;
+
+// Flow field: distance to goal for every cell
+typedef struct FlowField {
+    int width;                  // Field width in cells
+    int height;                 // Field height in cells
+    Point goal;                 // Goal cell
+
+    int *distance;              // Steps to goal, per cell (-1: wall or not reachable)
+    int updated;                // Cells recomputed by last compute/update
+
+    uint64_t *visited;          // Reached cells bits (BFS), queued cells bits (updates), per grid word
+    FlowWord *frontier[2];      // Current and next BFS level frontier
+    int frontierCapacity[2];    // Frontier capacities
+    int *queue;                 // Cells queue (updates)
+    int queueCapacity;          // Cells queue capacity
+} FlowField;
+
+// Pathfinding algorithms
+typedef enum {
+    PATH_ASTAR = 0,             // A*, every cell is a search node
+    PATH_JPS                    // Jump Point Search, only jump points are search nodes
+} PathAlgorithm;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+PathFinder LoadPathFinder(int width, int height);                  // Load pathfinding context for a grid size
+void UnloadPathFinder(PathFinder finder);                           // Unload pathfinding context
+
+// Get shorter path between two points, implements pathfinding algorithm: A*
+// NOTE: Returned path (start to end) is owned by finder and valid until next search, NULL if not found
+const Point *FindPathAStar(PathFinder *finder, MazeGrid grid, Point start, Point end, int *pointCount);
+
+// Get shorter path between two points, implements pathfinding algorithm: Jump Point Search
+// NOTE: Same result format than FindPathAStar(), path includes every cell from start to end
+const Point *FindPathJPS(PathFinder *finder, MazeGrid grid, Point start, Point end, int *pointCount);
+
+// Get shorter path between two points, using the selected algorithm (PathAlgorithm)
+const Point *FindPath(PathFinder *finder, MazeGrid grid, Point start, Point end, int algorithm, int *pointCount);
+
+// Get shorter path between two points, one-shot version (allocates its own context)
+// NOTE: Returned path must be freed with UnloadPath()
+Point *LoadPathAStar(MazeGrid grid, Point start, Point end, int *pointCount);
+void UnloadPath(Point *path);                                       // Unload path loaded with LoadPath*()
+
+// Incremental path planner (D* Lite)
+PathPlanner LoadPathPlanner(int width, int height);                 // Load incremental path planner for a grid size
+void UnloadPathPlanner(PathPlanner planner);                        // Unload incremental path planner
+void ResetPathPlanner(PathPlanner *planner, Point start, Point goal);   // Reset planner search for new start and goal
+void SetPathPlannerStart(PathPlanner *planner, Point start);        // Set new start cell (i.e. player moved), search is kept
+void UpdatePathPlannerCell(PathPlanner *planner, MazeGrid grid, int x, int y);    // Notify grid cell changed (after changing it)
+const Point *UpdatePathPlanner(PathPlanner *planner, MazeGrid grid, int *pointCount);   // Repair search and get path, NULL if not found
+
+// Flow field (distance to goal for every cell)
+FlowField LoadFlowField(int width, int height);                     // Load flow field for a grid size
+void UnloadFlowField(FlowField field);                              // Unload flow field
+bool ComputeFlowField(FlowField *field, MazeGrid grid, Point goal, int threadCount);  // Compute distances to goal (threadCount: 0 = all processors)
+void UpdateFlowFieldCell(FlowField *field, MazeGrid grid, int x, int y);             // Notify grid cell changed (after changing it)
+int GetFlowFieldDistance(FlowField field, int x, int y);           // Get steps to goal from cell, -1 if not reachable
+Point GetFlowFieldNext(FlowField field, int x, int y);             // Get next cell towards goal, same cell if goal or not reachable
+
+#if defined(__cplusplus)
+}
+#endif
+
+/***********************************************************************************
+*
+*   MAZE PATH IMPLEMENTATION
+*
+************************************************************************************/
+#if defined(MAZE_IMPLEMENTATION)
+
+#include <stdlib.h>                     // Required for: abs(), qsort()
+#include <string.h>                     // Required for: memset(), memcpy()
+
+#define PATH_INFINITY   0x3f3f3f3f      // Unreachable cost, every byte is 0x3f (memset), can be incremented
+
+#if defined(_MSC_VER)
+    #include <intrin.h>                 // Required for: _BitScanForward64(), _BitScanReverse64()
+#endif
+
+#if !defined(MAZE_NO_THREADS)
+    #include <threads.h>                // Required for: thrd_create(), mtx_t, cnd_t
+    #include <stdatomic.h>              // Required for: atomic_int, atomic_fetch_or_explicit()
+#endif
+
+#define FLOW_PARALLEL_MIN_WORDS     2048    // Frontier words required to expand a BFS level with worker threads
+#define FLOW_WORKER_CHUNK            256    // Frontier words taken at once by a worker
+#define MAX_FLOW_THREADS              64    // Maximum threads computing a flow field
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+#if !defined(MAZE_NO_THREADS)
+// Flow field workers shared state, workers expand one BFS level per dispatch
+typedef struct FlowWorkers {
+    FlowField *field;           // Flow field being computed
+    MazeGrid grid;              // Grid being computed
+    int distance;               // Distance of cells reached by current level
+    int frontierCount;          // Current level frontier words
+    int workerCount;            // Worker threads (calling thread not included)
+
+    atomic_int nextWord;        // Next frontier word to be taken
+    atomic_int nextCount;       // Next level frontier words
+    atomic_int finished;        // Workers done with current level
+
+    mtx_t mutex;                // Protects generation and quit
+    cnd_t dispatch;             // Signaled on new level or quit
+    int generation;             // Levels dispatched
+    bool quit;                  // Workers must exit
+} FlowWorkers;
+#endif
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+// Search directions, parent direction is stored as the index of the move that reached the cell
+static const Point pathDirections[4] = {
+    { 0, -1 },      // Up
+    { 0, 1 },       // Down
+    { -1, 0 },      // Left
+    { 1, 0 },       // Right
+};
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static bool PathFinderReset(PathFinder *finder, int width, int height);       // Start new search, resize context if required
+static void PathBucketPush(PathBucket *bucket, int cell);                     // Add cell to open list bucket
+static void PathHeapPush(PathFinder *finder, int cell, long long key);        // Add cell to open list heap
+static int PathHeapPop(PathFinder *finder);                                    // Remove cell with lower key from open list heap
+static int PathJumpHorizontal(MazeGrid grid, int x, int y, int dx, Point end); // Jump horizontally, returns jump point x or -1
+static int PathJumpVertical(MazeGrid grid, int x, int y, int dy, Point end);   // Jump vertically, returns jump point y or -1
+
+static void PathQueueUpdate(PathQueue *queue, int cell, long long key);       // Insert cell in queue or update its key
+static void PathQueueRemove(PathQueue *queue, int cell);                       // Remove cell from queue
+static void PathQueueSiftUp(PathQueue *queue, int index);
+static void PathQueueSiftDown(PathQueue *queue, int index);
+static long long PlannerKey(PathPlanner *planner, int cell);                   // Calculate cell key in planner queue
+static int PlannerRhs(PathPlanner *planner, MazeGrid grid, int cell);          // Calculate cell rhs: min(g(neighbour) + 1)
+static void PlannerUpdateCell(PathPlanner *planner, int cell);                 // Update cell position in queue (D* Lite: UpdateVertex)
+static const Point *PathFinderBuild(PathFinder *finder, Point end, int *pointCount);   // Build path following parents from end
+
+static bool FlowReserve(FlowField *field, int frontier, int count);           // Reserve frontier entries
+static bool FlowQueuePush(FlowField *field, int *count, int cell);            // Add cell to updates queue
+static int FlowExpandWord(FlowField *field, MazeGrid grid, FlowWord word, int distance, bool shared, FlowWord *claimed); // Expand frontier word
+static inline int FlowClaim(FlowField *field, MazeGrid grid, int x, int y, uint64_t bits, int distance, bool shared, FlowWord *claimed); // Claim word cells
+static int FlowNeighbourDistance(FlowField *field, int cell);                 // Get lower neighbour distance + 1, -1 if none
+static void FlowPropagate(FlowField *field, MazeGrid grid, int cell);         // Cell became walkable: propagate decreased distances
+static void FlowInvalidate(FlowField *field, MazeGrid grid, int cell);        // Cell became wall: recompute cells depending on it
+static int FlowCompareSeeds(const void *a, const void *b);                     // Compare seeds by distance (qsort)
+#if !defined(MAZE_NO_THREADS)
+static int FlowExpandShared(FlowWorkers *workers, int distance, int frontierCount);   // Expand BFS level with all workers
+static void FlowWorkerExpand(FlowWorkers *workers);                            // Expand frontier chunks until level is done
+static int FlowWorker(void *arg);                                              // Worker thread: expand dispatched levels until quit
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Load pathfinding context for a grid size
+PathFinder LoadPathFinder(int width, int height)
+{
+    PathFinder finder = { 0 };
+
+    PathFinderReset(&finder, width, height);
+
+    return finder;
+}
+
+// Unload pathfinding context
+void UnloadPathFinder(PathFinder finder)
+{
+    MAZE_FREE(finder.gScore);
+    MAZE_FREE(finder.parentDir);
+    MAZE_FREE(finder.visited);
+    MAZE_FREE(finder.closed);
+    MAZE_FREE(finder.open[0].cells);
+    MAZE_FREE(finder.open[1].cells);
+    MAZE_FREE(finder.heap);
+    MAZE_FREE(finder.points);
+}
+
+// Get shorter path between two points, implements pathfinding algorithm: A*
+// NOTE: With a Manhattan heuristic on a 4-connected uniform cost grid, every move changes f
+// by 0 or +2, so open cells always have f = F or f = F + 2 (F: lowest f in open list), the open
+// list is kept as two buckets (stacks) with O(1) insert/remove instead of a sorted list,
+// improved cells are inserted again and stale entries skipped when removed (already closed)
+const Point *FindPathAStar(PathFinder *finder, MazeGrid grid, Point start, Point end, int *pointCount)
+{
+    *pointCount = 0;
+    finder->pointCount = 0;
+    finder->expanded = 0;
+
+    if (IsMazeWall(grid, start.x, start.y) || IsMazeWall(grid, end.x, end.y)) return NULL;
+    if (!PathFinderReset(finder, grid.width, grid.height)) return NULL;
+
+    int width = grid.width;
+    int startCell = start.y*width + start.x;
+    int endCell = end.y*width + end.x;
+    int lowestF = abs(start.x - end.x) + abs(start.y - end.y);
+    PathBucket *current = &finder->open[0];
+    PathBucket *next = &finder->open[1];
+
+    finder->visited[startCell] = finder->stamp;
+    finder->gScore[startCell] = 0;
+    finder->parentDir[startCell] = 0;
+    PathBucketPush(current, startCell);
+
+    while ((current->count > 0) || (next->count > 0))
+    {
+        if (current->count == 0)
+        {
+            // Current f exhausted, continue with next f
+            PathBucket *temp = current;
+            current = next;
+            next = temp;
+            lowestF += 2;
+            continue;
+        }
+
+        int cell = current->cells[--current->count];
+        if (finder->closed[cell] == finder->stamp) continue;    // Stale entry
+
+        finder->closed[cell] = finder->stamp;
+        finder->expanded++;
+
+        if (cell == endCell) return PathFinderBuild(finder, end, pointCount);
+
+        int cx = cell%width;
+        int cy = cell/width;
+        int nextScore = finder->gScore[cell] + 1;
+
+        for (int i = 0; i < 4; i++)
+        {
+            int nx = cx + pathDirections[i].x;
+            int ny = cy + pathDirections[i].y;
+
+            if (IsMazeWall(grid, nx, ny)) continue;
+
+            int neighbour = ny*width + nx;
+
+            if (finder->visited[neighbour] == finder->stamp)
+            {
+                if ((finder->closed[neighbour] == finder->stamp) || (nextScore >= finder->gScore[neighbour])) continue;
+            }
+            else finder->visited[neighbour] = finder->stamp;
+
+            finder->gScore[neighbour] = nextScore;
+            finder->parentDir[neighbour] = (unsigned char)i;
+
+            int fScore = nextScore + abs(nx - end.x) + abs(ny - end.y);
+            PathBucketPush((fScore == lowestF)? current : next, neighbour);
+        }
+    }
+
+    return NULL;
+}
+
+// Get shorter path between two points, implements pathfinding algorithm: Jump Point Search
+// NOTE: 4-connected variant, canonical paths move vertically first and turn horizontally:
+//  - Moving vertically, both horizontal moves are natural successors, a vertical jump stops
+//    on cells where a horizontal jump would find a jump point (like diagonals in 8-connected JPS)
+//  - Moving horizontally, a vertical move is only required (forced) when the cell behind it is a wall
+const Point *FindPathJPS(PathFinder *finder, MazeGrid grid, Point start, Point end, int *pointCount)
+{
+    *pointCount = 0;
+    finder->pointCount = 0;
+    finder->expanded = 0;
+
+    if (IsMazeWall(grid, start.x, start.y) || IsMazeWall(grid, end.x, end.y)) return NULL;
+    if (!PathFinderReset(finder, grid.width, grid.height)) return NULL;
+
+    int width = grid.width;
+    int startCell = start.y*width + start.x;
+    int endCell = end.y*width + end.x;
+
+    finder->visited[startCell] = finder->stamp;
+    finder->gScore[startCell] = 0;
+    finder->parentDir[startCell] = 0;
+    PathHeapPush(finder, startCell, 0);
+
+    while (finder->heapCount > 0)
+    {
+        int cell = PathHeapPop(finder);
+        if (finder->closed[cell] == finder->stamp) continue;    // Stale entry
+
+        finder->closed[cell] = finder->stamp;
+        finder->expanded++;
+
+        if (cell == endCell) return PathFinderBuild(finder, end, pointCount);
+
+        int cx = cell%width;
+        int cy = cell/width;
+
+        // Select successor directions (pruning), start cell explores all directions
+        bool explore[4] = { true, true, true, true };
+        if (cell != startCell)
+        {
+            int dir = finder->parentDir[cell];
+
+            if (dir >= 2)
+            {
+                int dx = pathDirections[dir].x;
+                explore[0] = !IsMazeWall(grid, cx, cy - 1) && IsMazeWall(grid, cx - dx, cy - 1);
+                explore[1] = !IsMazeWall(grid, cx, cy + 1) && IsMazeWall(grid, cx - dx, cy + 1);
+                explore[2] = (dir == 2);
+                explore[3] = (dir == 3);
+            }
+            else
+            {
+                explore[0] = (dir == 0);
+                explore[1] = (dir == 1);
+            }
+        }
+
+        for (int i = 0; i < 4; i++)
+        {
+            if (!explore[i]) continue;
+
+            int nx = cx;
+            int ny = cy;
+
+            if (i < 2) ny = PathJumpVertical(grid, cx, cy, pathDirections[i].y, end);
+            else nx = PathJumpHorizontal(grid, cx, cy, pathDirections[i].x, end);
+
+            if ((nx < 0) || (ny < 0)) continue;     // No jump point in that direction
+
+            int jump = ny*width + nx;
+            int nextScore = finder->gScore[cell] + abs(nx - cx) + abs(ny - cy);
+
+            if (finder->visited[jump] == finder->stamp)
+            {
+                if ((finder->closed[jump] == finder->stamp) || (nextScore >= finder->gScore[jump])) continue;
+            }
+            else finder->visited[jump] = finder->stamp;
+
+            finder->gScore[jump] = nextScore;
+            finder->parentDir[jump] = (unsigned char)i;
+
+            // Priority: f = g + h, ties broken by higher g (closer to goal)
+            int fScore = nextScore + abs(nx - end.x) + abs(ny - end.y);
+            PathHeapPush(finder, jump, ((long long)fScore << 32) | (unsigned int)(0x7fffffff - nextScore));
+        }
+    }
+
+    return NULL;
+}
+
+// Get shorter path between two points, using the selected algorithm (PathAlgorithm)
+const Point *FindPath(PathFinder *finder, MazeGrid grid, Point start, Point end, int algorithm, int *pointCount)
+{
+    if (algorithm == PATH_JPS) return FindPathJPS(finder, grid, start, end, pointCount);
+
+    return FindPathAStar(finder, grid, start, end, pointCount);
+}
+
+// Get shorter path between two points, one-shot version (allocates its own context)
+Point *LoadPathAStar(MazeGrid grid, Point start, Point end, int *pointCount)
+{
+    PathFinder finder = LoadPathFinder(grid.width, grid.height);
+    Point *path = NULL;
+
+    const Point *points = FindPathAStar(&finder, grid, start, end, pointCount);
+
+    if (points != NULL)
+    {
+        path = (Point *)MAZE_MALLOC(*pointCount*sizeof(Point));
+        if (path != NULL) memcpy(path, points, *pointCount*sizeof(Point));
+        else *pointCount = 0;
+    }
+
+    UnloadPathFinder(finder);
+
+    return path;
+}
+
+// Unload path loaded with LoadPath*()
+void UnloadPath(Point *path)
+{
+    MAZE_FREE(path);
+}
+
+// Load incremental path planner for a grid size
+PathPlanner LoadPathPlanner(int width, int height)
+{
+    PathPlanner planner = { 0 };
+
+    if ((width <= 0) || (height <= 0)) return planner;
+
+    size_t cellCount = (size_t)width*height;
+
+    planner.gScore = (int *)MAZE_MALLOC(cellCount*sizeof(int));
+    planner.rhs = (int *)MAZE_MALLOC(cellCount*sizeof(int));
+    planner.queue.index = (int *)MAZE_MALLOC(cellCount*sizeof(int));
+
+    if ((planner.gScore == NULL) || (planner.rhs == NULL) || (planner.queue.index == NULL))
+    {
+        UnloadPathPlanner(planner);
+        return (PathPlanner){ 0 };
+    }
+
+    planner.width = width;
+    planner.height = height;
+
+    return planner;
+}
+
+// Unload incremental path planner
+void UnloadPathPlanner(PathPlanner planner)
+{
+    MAZE_FREE(planner.gScore);
+    MAZE_FREE(planner.rhs);
+    MAZE_FREE(planner.queue.index);
+    MAZE_FREE(planner.queue.nodes);
+    MAZE_FREE(planner.points);
+}
+
+// Reset planner search for new start and goal
+void ResetPathPlanner(PathPlanner *planner, Point start, Point goal)
+{
+    if (planner->gScore == NULL) return;
+
+    size_t cellCount = (size_t)planner->width*planner->height;
+
+    // NOTE: Infinite cost is 0x3f3f3f3f, so it can be set with memset() and incremented safely
+    memset(planner->gScore, 0x3f, cellCount*sizeof(int));
+    memset(planner->rhs, 0x3f, cellCount*sizeof(int));
+    memset(planner->queue.index, 0xff, cellCount*sizeof(int));
+    planner->queue.count = 0;
+
+    planner->start = start;
+    planner->last = start;
+    planner->goal = goal;
+    planner->keyModifier = 0;
+    planner->pointCount = 0;
+
+    if (((unsigned int)goal.x < (unsigned int)planner->width) && ((unsigned int)goal.y < (unsigned int)planner->height))
+    {
+        int goalCell = goal.y*planner->width + goal.x;
+        planner->rhs[goalCell] = 0;
+        PathQueueUpdate(&planner->queue, goalCell, PlannerKey(planner, goalCell));
+    }
+}
+
+// Set new start cell (i.e. player moved), search is kept
+// NOTE: Queue keys are relative to start, instead of recomputing them, the key modifier
+// is increased by the heuristic distance moved (lower bound of the keys change)
+void SetPathPlannerStart(PathPlanner *planner, Point start)
+{
+    if ((start.x == planner->start.x) && (start.y == planner->start.y)) return;
+
+    planner->keyModifier += abs(planner->last.x - start.x) + abs(planner->last.y - start.y);
+    planner->last = start;
+    planner->start = start;
+}
+
+// Notify grid cell changed (after changing it)
+// NOTE: Cell and its neighbours edges changed, their rhs is recomputed
+void UpdatePathPlannerCell(PathPlanner *planner, MazeGrid grid, int x, int y)
+{
+    if ((planner->gScore == NULL) || (grid.width != planner->width) || (grid.height != planner->height)) return;
+    if (((unsigned int)x >= (unsigned int)grid.width) || ((unsigned int)y >= (unsigned int)grid.height)) return;
+
+    int goalCell = planner->goal.y*planner->width + planner->goal.x;
+
+    for (int i = -1; i < 4; i++)
+    {
+        int nx = x + ((i < 0)? 0 : pathDirections[i].x);
+        int ny = y + ((i < 0)? 0 : pathDirections[i].y);
+
+        if (((unsigned int)nx >= (unsigned int)grid.width) || ((unsigned int)ny >= (unsigned int)grid.height)) continue;
+
+        int cell = ny*grid.width + nx;
+
+        if (cell == goalCell) planner->rhs[cell] = IsMazeWall(grid, nx, ny)? PATH_INFINITY : 0;
+        else planner->rhs[cell] = PlannerRhs(planner, grid, cell);
+
+        PlannerUpdateCell(planner, cell);
+    }
+}
+
+// Repair search and get path, NULL if not found
+const Point *UpdatePathPlanner(PathPlanner *planner, MazeGrid grid, int *pointCount)
+{
+    *pointCount = 0;
+    planner->pointCount = 0;
+    planner->expanded = 0;
+
+    if ((planner->gScore == NULL) || (grid.width != planner->width) || (grid.height != planner->height)) return NULL;
+    if (IsMazeWall(grid, planner->start.x, planner->start.y)) return NULL;
+
+    int width = grid.width;
+    int startCell = planner->start.y*width + planner->start.x;
+    int goalCell = planner->goal.y*width + planner->goal.x;
+    int *g = planner->gScore;
+    int *rhs = planner->rhs;
+    PathQueue *queue = &planner->queue;
+
+    // Compute shortest path: expand inconsistent cells until start is consistent and no
+    // queued cell can improve it
+    while ((queue->count > 0) && ((queue->nodes[0].key < PlannerKey(planner, startCell)) || (rhs[startCell] != g[startCell])))
+    {
+        int cell = queue->nodes[0].cell;
+        long long oldKey = queue->nodes[0].key;
+        long long newKey = PlannerKey(planner, cell);
+
+        planner->expanded++;
+
+        if (oldKey < newKey)
+        {
+            // Key outdated (start moved), queue it again
+            PathQueueUpdate(queue, cell, newKey);
+            continue;
+        }
+
+        int cx = cell%width;
+        int cy = cell/width;
+
+        if (g[cell] > rhs[cell])
+        {
+            // Cost improved: set it and relax neighbours
+            g[cell] = rhs[cell];
+            PathQueueRemove(queue, cell);
+
+            for (int i = 0; i < 4; i++)
+            {
+                int nx = cx + pathDirections[i].x;
+                int ny = cy + pathDirections[i].y;
+                if (IsMazeWall(grid, nx, ny)) continue;
+
+                int neighbour = ny*width + nx;
+                if ((neighbour != goalCell) && (g[cell] + 1 < rhs[neighbour])) rhs[neighbour] = g[cell] + 1;
+                PlannerUpdateCell(planner, neighbour);
+            }
+        }
+        else
+        {
+            // Cost got worse: invalidate it, neighbours depending on it are recomputed
+            int oldScore = g[cell];
+            g[cell] = PATH_INFINITY;
+
+            for (int i = -1; i < 4; i++)
+            {
+                int nx = cx + ((i < 0)? 0 : pathDirections[i].x);
+                int ny = cy + ((i < 0)? 0 : pathDirections[i].y);
+                if (IsMazeWall(grid, nx, ny) && (i >= 0)) continue;
+
+                int neighbour = ny*width + nx;
+                if ((neighbour != goalCell) && ((i < 0) || (rhs[neighbour] == oldScore + 1))) rhs[neighbour] = PlannerRhs(planner, grid, neighbour);
+                PlannerUpdateCell(planner, neighbour);
+            }
+        }
+    }
+
+    if (g[startCell] >= PATH_INFINITY) return NULL;
+
+    // Extract path: descend cost to goal from start
+    int count = g[startCell] + 1;
+
+    if (count > planner->pointCapacity)
+    {
+        Point *points = (Point *)MAZE_REALLOC(planner->points, (size_t)count*sizeof(Point));
+        if (points == NULL) return NULL;
+
+        planner->points = points;
+        planner->pointCapacity = count;
+    }
+
+    Point current = planner->start;
+    planner->points[0] = current;
+
+    for (int i = 1; i < count; i++)
+    {
+        int best = -1;
+        int bestScore = g[current.y*width + current.x];
+
+        for (int d = 0; d < 4; d++)
+        {
+            int nx = current.x + pathDirections[d].x;
+            int ny = current.y + pathDirections[d].y;
+            if (IsMazeWall(grid, nx, ny)) continue;
+
+            int score = g[ny*width + nx];
+            if (score < bestScore)
+            {
+                best = d;
+                bestScore = score;
+            }
+        }
+
+        if (best < 0) return NULL;      // Should not happen, search is consistent on the path
+
+        current.x += pathDirections[best].x;
+        current.y += pathDirections[best].y;
+        planner->points[i] = current;
+    }
+
+    planner->pointCount = count;
+    *pointCount = count;
+
+    return planner->points;
+}
+
+// Load flow field for a grid size
+FlowField LoadFlowField(int width, int height)
+{
+    FlowField field = { 0 };
+
+    if ((width <= 0) || (height <= 0)) return field;
+
+    size_t cellCount = (size_t)width*height;
+    size_t wordCount = (size_t)((width + 63)/64)*height;
+
+    field.distance = (int *)MAZE_MALLOC(cellCount*sizeof(int));
+    field.visited = (uint64_t *)MAZE_CALLOC(wordCount, sizeof(uint64_t));
+
+    if ((field.distance == NULL) || (field.visited == NULL))
+    {
+        UnloadFlowField(field);
+        return (FlowField){ 0 };
+    }
+
+    memset(field.distance, 0xff, cellCount*sizeof(int));
+
+    field.width = width;
+    field.height = height;
+    field.goal = (Point){ -1, -1 };
+
+    return field;
+}
+
+// Unload flow field
+void UnloadFlowField(FlowField field)
+{
+    MAZE_FREE(field.distance);
+    MAZE_FREE(field.visited);
+    MAZE_FREE(field.frontier[0]);
+    MAZE_FREE(field.frontier[1]);
+    MAZE_FREE(field.queue);
+}
+
+// Compute distances to goal (threadCount: 0 = all processors)
+// NOTE: BFS from goal, every level expands the frontier words to their neighbour words
+// (left/right: shifted bits, up/down: same bits) masked with walkable unvisited cells
+bool ComputeFlowField(FlowField *field, MazeGrid grid, Point goal, int threadCount)
+{
+    if ((field->distance == NULL) || (grid.width != field->width) || (grid.height != field->height)) return false;
+
+    size_t cellCount = (size_t)grid.width*grid.height;
+    size_t wordCount = (size_t)grid.stride*grid.height;
+
+    memset(field->distance, 0xff, cellCount*sizeof(int));
+    memset(field->visited, 0, wordCount*sizeof(uint64_t));
+    field->goal = goal;
+    field->updated = (int)cellCount;
+
+    if (IsMazeWall(grid, goal.x, goal.y)) return true;
+    if (!FlowReserve(field, 0, 1)) return false;
+
+    int goalIndex = goal.y*grid.stride + (goal.x >> 6);
+    field->distance[goal.y*grid.width + goal.x] = 0;
+    field->visited[goalIndex] = 1ull << (goal.x & 63);
+    field->frontier[0][0] = (FlowWord){ goal.x >> 6, goal.y, 1ull << (goal.x & 63) };
+
+    int frontierCount = 1;
+    bool success = true;
+
+#if !defined(MAZE_NO_THREADS)
+    // Worker threads are only dispatched for levels with big frontiers,
+    // the calling thread expands small levels alone
+    FlowWorkers workers = { .field = field, .grid = grid };
+    thrd_t threads[MAX_FLOW_THREADS] = { 0 };
+    bool workersReady = false;
+
+    if (threadCount <= 0) threadCount = GetProcessorCount();
+    if (threadCount > MAX_FLOW_THREADS) threadCount = MAX_FLOW_THREADS;
+
+    if ((threadCount > 1) && (mtx_init(&workers.mutex, mtx_plain) == thrd_success))
+    {
+        if (cnd_init(&workers.dispatch) == thrd_success) workersReady = true;
+        else mtx_destroy(&workers.mutex);
+    }
+
+    for (int i = 0; workersReady && (i < (threadCount - 1)); i++)
+    {
+        if (thrd_create(&threads[workers.workerCount], FlowWorker, &workers) == thrd_success) workers.workerCount++;
+    }
+#else
+    (void)threadCount;
+#endif
+
+    for (int distance = 1; frontierCount > 0; distance++)
+    {
+        // Every frontier word claims cells in 5 words at most
+        int nextCount = 0;
+        size_t maxNextCount = (size_t)frontierCount*5;
+        if (maxNextCount > cellCount) maxNextCount = cellCount;
+
+        if (!FlowReserve(field, 1, (int)maxNextCount))
+        {
+            success = false;
+            break;
+        }
+
+#if !defined(MAZE_NO_THREADS)
+        if ((workers.workerCount > 0) && (frontierCount >= FLOW_PARALLEL_MIN_WORDS)) nextCount = FlowExpandShared(&workers, distance, frontierCount);
+        else
+#endif
+        {
+            for (int i = 0; i < frontierCount; i++)
+            {
+                nextCount += FlowExpandWord(field, grid, field->frontier[0][i], distance, false, field->frontier[1] + nextCount);
+            }
+        }
+
+        FlowWord *frontier = field->frontier[0];
+        int frontierCapacity = field->frontierCapacity[0];
+        field->frontier[0] = field->frontier[1];
+        field->frontierCapacity[0] = field->frontierCapacity[1];
+        field->frontier[1] = frontier;
+        field->frontierCapacity[1] = frontierCapacity;
+        frontierCount = nextCount;
+    }
+
+#if !defined(MAZE_NO_THREADS)
+    if (workers.workerCount > 0)
+    {
+        mtx_lock(&workers.mutex);
+        workers.quit = true;
+        cnd_broadcast(&workers.dispatch);
+        mtx_unlock(&workers.mutex);
+
+        for (int i = 0; i < workers.workerCount; i++) thrd_join(threads[i], NULL);
+    }
+
+    if (workersReady)
+    {
+        cnd_destroy(&workers.dispatch);
+        mtx_destroy(&workers.mutex);
+    }
+#endif
+
+    // Visited bits are kept clear, updates use them to mark queued cells
+    memset(field->visited, 0, wordCount*sizeof(uint64_t));
+
+    return success;
+}
+
+// Notify grid cell changed (after changing it)
+// NOTE: Only cells whose distance depends on the changed cell are recomputed
+void UpdateFlowFieldCell(FlowField *field, MazeGrid grid, int x, int y)
+{
+    field->updated = 0;
+
+    if ((field->distance == NULL) || (grid.width != field->width) || (grid.height != field->height)) return;
+    if (((unsigned int)x >= (unsigned int)grid.width) || ((unsigned int)y >= (unsigned int)grid.height)) return;
+
+    int cell = y*grid.width + x;
+
+    // Goal changed, any distance can change
+    if ((x == field->goal.x) && (y == field->goal.y)) ComputeFlowField(field, grid, field->goal, 1);
+    else if (IsMazeWall(grid, x, y))
+    {
+        if (field->distance[cell] >= 0) FlowInvalidate(field, grid, cell);
+    }
+    else if (field->distance[cell] < 0) FlowPropagate(field, grid, cell);
+}
+
+// Get steps to goal from cell, -1 if not reachable
+int GetFlowFieldDistance(FlowField field, int x, int y)
+{
+    if ((field.distance == NULL) || ((unsigned int)x >= (unsigned int)field.width) || ((unsigned int)y >= (unsigned int)field.height)) return -1;
+
+    return field.distance[y*field.width + x];
+}
+
+// Get next cell towards goal, same cell if goal or not reachable
+Point GetFlowFieldNext(FlowField field, int x, int y)
+{
+    int distance = GetFlowFieldDistance(field, x, y);
+
+    if (distance > 0)
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            int nx = x + pathDirections[i].x;
+            int ny = y + pathDirections[i].y;
+
+            if (GetFlowFieldDistance(field, nx, ny) == (distance - 1)) return (Point){ nx, ny };
+        }
+    }
+
+    return (Point){ x, y };
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+// Start new search, resize context if required
+static bool PathFinderReset(PathFinder *finder, int width, int height)
+{
+    if ((width <= 0) || (height <= 0)) return false;
+
+    if ((finder->width != width) || (finder->height != height) || (finder->visited == NULL))
+    {
+        size_t cellCount = (size_t)width*height;
+
+        MAZE_FREE(finder->gScore);
+        MAZE_FREE(finder->parentDir);
+        MAZE_FREE(finder->visited);
+        MAZE_FREE(finder->closed);
+
+        finder->gScore = (int *)MAZE_MALLOC(cellCount*sizeof(int));
+        finder->parentDir = (unsigned char *)MAZE_MALLOC(cellCount);
+        finder->visited = (unsigned char *)MAZE_CALLOC(cellCount, 1);
+        finder->closed = (unsigned char *)MAZE_CALLOC(cellCount, 1);
+        finder->stamp = 0;
+
+        if ((finder->gScore == NULL) || (finder->parentDir == NULL) || (finder->visited == NULL) || (finder->closed == NULL))
+        {
+            UnloadPathFinder(*finder);
+            *finder = (PathFinder){ 0 };
+            return false;
+        }
+
+        finder->width = width;
+        finder->height = height;
+    }
+
+    // Stamp 0 is never used, on wrap around the stamps have to be cleared
+    finder->stamp++;
+    if (finder->stamp == 0)
+    {
+        memset(finder->visited, 0, (size_t)width*height);
+        memset(finder->closed, 0, (size_t)width*height);
+        finder->stamp = 1;
+    }
+
+    finder->open[0].count = 0;
+    finder->open[1].count = 0;
+    finder->heapCount = 0;
+
+    return true;
+}
+
+// Add cell to open list bucket
+static void PathBucketPush(PathBucket *bucket, int cell)
+{
+    if (bucket->count == bucket->capacity)
+    {
+        int capacity = (bucket->capacity > 0)? bucket->capacity*2 : 1024;
+        int *cells = (int *)MAZE_REALLOC(bucket->cells, (size_t)capacity*sizeof(int));
+        if (cells == NULL) return;
+
+        bucket->cells = cells;
+        bucket->capacity = capacity;
+    }
+
+    bucket->cells[bucket->count++] = cell;
+}
+
+// Add cell to open list heap
+// NOTE: Improved cells are added again, stale entries are skipped when removed
+static void PathHeapPush(PathFinder *finder, int cell, long long key)
+{
+    if (finder->heapCount == finder->heapCapacity)
+    {
+        int capacity = (finder->heapCapacity > 0)? finder->heapCapacity*2 : 256;
+        PathHeapNode *heap = (PathHeapNode *)MAZE_REALLOC(finder->heap, (size_t)capacity*sizeof(PathHeapNode));
+        if (heap == NULL) return;
+
+        finder->heap = heap;
+        finder->heapCapacity = capacity;
+    }
+
+    // Sift up
+    int index = finder->heapCount++;
+    while (index > 0)
+    {
+        int parent = (index - 1)/2;
+        if (finder->heap[parent].key <= key) break;
+
+        finder->heap[index] = finder->heap[parent];
+        index = parent;
+    }
+
+    finder->heap[index] = (PathHeapNode){ key, cell };
+}
+
+// Remove cell with lower key from open list heap
+static int PathHeapPop(PathFinder *finder)
+{
+    int cell = finder->heap[0].cell;
+    PathHeapNode last = finder->heap[--finder->heapCount];
+
+    // Sift down last node from the root
+    int index = 0;
+    for (;;)
+    {
+        int child = index*2 + 1;
+        if (child >= finder->heapCount) break;
+        if ((child + 1 < finder->heapCount) && (finder->heap[child + 1].key < finder->heap[child].key)) child++;
+        if (last.key <= finder->heap[child].key) break;
+
+        finder->heap[index] = finder->heap[child];
+        index = child;
+    }
+
+    if (finder->heapCount > 0) finder->heap[index] = last;
+
+    return cell;
+}
+
+// Get maze row word, cells out of the grid (including row padding bits) are walls
+static inline uint64_t PathRowWord(MazeGrid grid, int y, int k)
+{
+    if ((y < 0) || (y >= grid.height) || (k < 0) || (k >= grid.stride)) return ~0ull;
+
+    uint64_t word = GetMazeRow(grid, y)[k];
+    if ((k == (grid.stride - 1)) && ((grid.width & 63) != 0)) word |= ~0ull << (grid.width & 63);
+
+    return word;
+}
+
+// Get index of lowest/highest set bit (word must not be 0)
+static inline int PathLowestBit(uint64_t word)
+{
+#if defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanForward64(&index, word);
+    return (int)index;
+#else
+    return __builtin_ctzll(word);
+#endif
+}
+
+static inline int PathHighestBit(uint64_t word)
+{
+#if defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanReverse64(&index, word);
+    return (int)index;
+#else
+    return 63 - __builtin_clzll(word);
+#endif
+}
+
+// Jump horizontally from (x, y), returns jump point x or -1 if a wall is found first
+// NOTE: 64 cells are checked at once, a cell c is a jump point if it is the goal or if it has
+// a forced neighbour: cell above/below c is walkable but cell above/below (c - dx) is a wall
+static int PathJumpHorizontal(MazeGrid grid, int x, int y, int dx, Point end)
+{
+    int first = x + dx;
+    if ((first < 0) || (first >= grid.width)) return -1;
+
+    int k = first >> 6;
+    uint64_t rangeMask = (dx > 0)? (~0ull << (first & 63)) : (~0ull >> (63 - (first & 63)));
+
+    for (; (k >= 0) && (k < grid.stride); k += dx, rangeMask = ~0ull)
+    {
+        uint64_t current = PathRowWord(grid, y, k);
+        uint64_t up = PathRowWord(grid, y - 1, k);
+        uint64_t down = PathRowWord(grid, y + 1, k);
+        uint64_t upBehind, downBehind;
+
+        // Walls behind every cell (c - dx), crossing word boundaries
+        if (dx > 0)
+        {
+            upBehind = (up << 1) | (PathRowWord(grid, y - 1, k - 1) >> 63);
+            downBehind = (down << 1) | (PathRowWord(grid, y + 1, k - 1) >> 63);
+        }
+        else
+        {
+            upBehind = (up >> 1) | (PathRowWord(grid, y - 1, k + 1) << 63);
+            downBehind = (down >> 1) | (PathRowWord(grid, y + 1, k + 1) << 63);
+        }
+
+        uint64_t jumps = ((~up & upBehind) | (~down & downBehind)) & ~current;
+        if ((y == end.y) && ((end.x >> 6) == k)) jumps |= 1ull << (end.x & 63);
+
+        uint64_t stops = (jumps | current) & rangeMask;
+
+        if (stops != 0)
+        {
+            int bit = (dx > 0)? PathLowestBit(stops) : PathHighestBit(stops);
+            if ((current >> bit) & 1) return -1;     // Wall found before any jump point
+
+            return k*64 + bit;
+        }
+    }
+
+    return -1;
+}
+
+// Jump vertically from (x, y), returns jump point y or -1 if a wall is found first
+static int PathJumpVertical(MazeGrid grid, int x, int y, int dy, Point end)
+{
+    for (y += dy; !IsMazeWall(grid, x, y); y += dy)
+    {
+        if ((x == end.x) && (y == end.y)) return y;
+
+        // Horizontal moves are natural successors, stop if any of them finds a jump point
+        if ((PathJumpHorizontal(grid, x, y, 1, end) >= 0) || (PathJumpHorizontal(grid, x, y, -1, end) >= 0)) return y;
+    }
+
+    return -1;
+}
+
+// Insert cell in queue or update its key
+static void PathQueueUpdate(PathQueue *queue, int cell, long long key)
+{
+    int index = queue->index[cell];
+
+    if (index >= 0)
+    {
+        long long oldKey = queue->nodes[index].key;
+        queue->nodes[index].key = key;
+
+        if (key < oldKey) PathQueueSiftUp(queue, index);
+        else PathQueueSiftDown(queue, index);
+        return;
+    }
+
+    if (queue->count == queue->capacity)
+    {
+        int capacity = (queue->capacity > 0)? queue->capacity*2 : 256;
+        PathHeapNode *nodes = (PathHeapNode *)MAZE_REALLOC(queue->nodes, (size_t)capacity*sizeof(PathHeapNode));
+        if (nodes == NULL) return;
+
+        queue->nodes = nodes;
+        queue->capacity = capacity;
+    }
+
+    index = queue->count++;
+    queue->nodes[index] = (PathHeapNode){ key, cell };
+    queue->index[cell] = index;
+    PathQueueSiftUp(queue, index);
+}
+
+// Remove cell from queue
+static void PathQueueRemove(PathQueue *queue, int cell)
+{
+    int index = queue->index[cell];
+    if (index < 0) return;
+
+    queue->index[cell] = -1;
+    queue->count--;
+
+    if (index < queue->count)
+    {
+        long long removedKey = queue->nodes[index].key;
+        queue->nodes[index] = queue->nodes[queue->count];
+        queue->index[queue->nodes[index].cell] = index;
+
+        if (queue->nodes[index].key < removedKey) PathQueueSiftUp(queue, index);
+        else PathQueueSiftDown(queue, index);
+    }
+}
+
+static void PathQueueSiftUp(PathQueue *queue, int index)
+{
+    PathHeapNode node = queue->nodes[index];
+
+    while (index > 0)
+    {
+        int parent = (index - 1)/2;
+        if (queue->nodes[parent].key <= node.key) break;
+
+        queue->nodes[index] = queue->nodes[parent];
+        queue->index[queue->nodes[index].cell] = index;
+        index = parent;
+    }
+
+    queue->nodes[index] = node;
+    queue->index[node.cell] = index;
+}
+
+static void PathQueueSiftDown(PathQueue *queue, int index)
+{
+    PathHeapNode node = queue->nodes[index];
+
+    for (;;)
+    {
+        int child = index*2 + 1;
+        if (child >= queue->count) break;
+        if ((child + 1 < queue->count) && (queue->nodes[child + 1].key < queue->nodes[child].key)) child++;
+        if (node.key <= queue->nodes[child].key) break;
+
+        queue->nodes[index] = queue->nodes[child];
+        queue->index[queue->nodes[index].cell] = index;
+        index = child;
+    }
+
+    queue->nodes[index] = node;
+    queue->index[node.cell] = index;
+}
+
+// Calculate cell key in planner queue: [min(g, rhs) + h(start, cell) + km; min(g, rhs)]
+static long long PlannerKey(PathPlanner *planner, int cell)
+{
+    int x = cell%planner->width;
+    int y = cell/planner->width;
+    int score = (planner->gScore[cell] < planner->rhs[cell])? planner->gScore[cell] : planner->rhs[cell];
+    int primary = score + abs(x - planner->start.x) + abs(y - planner->start.y) + planner->keyModifier;
+
+    return ((long long)primary << 32) | (unsigned int)score;
+}
+
+// Calculate cell rhs: min(g(neighbour) + 1), walls are not traversable
+static int PlannerRhs(PathPlanner *planner, MazeGrid grid, int cell)
+{
+    int x = cell%grid.width;
+    int y = cell/grid.width;
+    int best = PATH_INFINITY;
+
+    if (IsMazeWall(grid, x, y)) return best;
+
+    for (int i = 0; i < 4; i++)
+    {
+        int nx = x + pathDirections[i].x;
+        int ny = y + pathDirections[i].y;
+        if (IsMazeWall(grid, nx, ny)) continue;
+
+        int score = planner->gScore[ny*grid.width + nx];
+        if (score + 1 < best) best = score + 1;
+    }
+
+    return best;
+}
+
+// Update cell position in queue (D* Lite: UpdateVertex)
+static void PlannerUpdateCell(PathPlanner *planner, int cell)
+{
+    if (planner->gScore[cell] != planner->rhs[cell]) PathQueueUpdate(&planner->queue, cell, PlannerKey(planner, cell));
+    else PathQueueRemove(&planner->queue, cell);
+}
+
+// Build path following parents from end, path is stored in finder->points
+static const Point *PathFinderBuild(PathFinder *finder, Point end, int *pointCount)
+{
+    // Path length is known: cost to end + 1
+    int count = finder->gScore[end.y*finder->width + end.x] + 1;
+
+    if (count > finder->pointCapacity)
+    {
+        Point *points = (Point *)MAZE_REALLOC(finder->points, (size_t)count*sizeof(Point));
+        if (points == NULL) return NULL;
+
+        finder->points = points;
+        finder->pointCapacity = count;
+    }
+
+    // Fill path backwards, from end to start, one cell at a time
+    // NOTE: Search nodes can be several cells apart (JPS), the direction is kept until a
+    // node with the expected cost is reached, any such node is a valid way back to start
+    Point current = end;
+    int dir = 0;
+    for (int i = count - 1; i >= 0; i--)
+    {
+        finder->points[i] = current;
+
+        int cell = current.y*finder->width + current.x;
+        if ((finder->visited[cell] == finder->stamp) && (finder->gScore[cell] == i)) dir = finder->parentDir[cell];
+
+        current.x -= pathDirections[dir].x;
+        current.y -= pathDirections[dir].y;
+    }
+
+    finder->pointCount = count;
+    *pointCount = count;
+
+    return finder->points;
+}
+
+// Reserve frontier entries
+static bool FlowReserve(FlowField *field, int frontier, int count)
+{
+    if (count <= field->frontierCapacity[frontier]) return true;
+
+    int capacity = (field->frontierCapacity[frontier] > 0)? field->frontierCapacity[frontier] : 256;
+    while (capacity < count) capacity *= 2;
+
+    FlowWord *words = (FlowWord *)MAZE_REALLOC(field->frontier[frontier], (size_t)capacity*sizeof(FlowWord));
+    if (words == NULL) return false;
+
+    field->frontier[frontier] = words;
+    field->frontierCapacity[frontier] = capacity;
+
+    return true;
+}
+
+// Add cell to updates queue
+static bool FlowQueuePush(FlowField *field, int *count, int cell)
+{
+    if (*count == field->queueCapacity)
+    {
+        int capacity = (field->queueCapacity > 0)? field->queueCapacity*2 : 256;
+        int *queue = (int *)MAZE_REALLOC(field->queue, (size_t)capacity*sizeof(int));
+        if (queue == NULL) return false;
+
+        field->queue = queue;
+        field->queueCapacity = capacity;
+    }
+
+    field->queue[(*count)++] = cell;
+
+    return true;
+}
+
+// Expand frontier word to its neighbour words, claim walkable unvisited cells and set their distance
+// NOTE: Shared expansion (several threads) claims cells atomically, so every cell is claimed once,
+// returns number of claimed words (new frontier entries)
+static int FlowExpandWord(FlowField *field, MazeGrid grid, FlowWord word, int distance, bool shared, FlowWord *claimed)
+{
+    int claimedCount = 0;
+    uint64_t bits = word.bits;
+
+    // Neighbour cells per word: same word (left and right), previous/next word (carry), word above/below
+    claimedCount += FlowClaim(field, grid, word.x, word.y, (bits << 1) | (bits >> 1), distance, shared, claimed + claimedCount);
+    if ((word.x > 0) && (bits & 1)) claimedCount += FlowClaim(field, grid, word.x - 1, word.y, 1ull << 63, distance, shared, claimed + claimedCount);
+    if ((word.x < (grid.stride - 1)) && (bits >> 63)) claimedCount += FlowClaim(field, grid, word.x + 1, word.y, 1, distance, shared, claimed + claimedCount);
+    if (word.y > 0) claimedCount += FlowClaim(field, grid, word.x, word.y - 1, bits, distance, shared, claimed + claimedCount);
+    if (word.y < (grid.height - 1)) claimedCount += FlowClaim(field, grid, word.x, word.y + 1, bits, distance, shared, claimed + claimedCount);
+
+    return claimedCount;
+}
+
+// Claim walkable unvisited cells of a word and set their distance, returns 1 if any cell was claimed
+static inline int FlowClaim(FlowField *field, MazeGrid grid, int x, int y, uint64_t bits, int distance, bool shared, FlowWord *claimed)
+{
+    size_t index = (size_t)y*grid.stride + x;
+    uint64_t cells = bits & ~grid.cells[index];
+
+    if ((x == (grid.stride - 1)) && ((grid.width & 63) != 0)) cells &= ~(~0ull << (grid.width & 63));
+    if (cells == 0) return 0;
+
+#if !defined(MAZE_NO_THREADS)
+    _Atomic(uint64_t) *visited = (_Atomic(uint64_t) *)&field->visited[index];
+
+    if (shared) cells &= ~atomic_fetch_or_explicit(visited, cells, memory_order_relaxed);
+    else
+    {
+        uint64_t previous = atomic_load_explicit(visited, memory_order_relaxed);
+        cells &= ~previous;
+        atomic_store_explicit(visited, previous | cells, memory_order_relaxed);
+    }
+#else
+    (void)shared;
+    cells &= ~field->visited[index];
+    field->visited[index] |= cells;
+#endif
+    if (cells == 0) return 0;
+
+    int *row = field->distance + (size_t)y*grid.width + x*64;
+    for (uint64_t rest = cells; rest != 0; rest &= (rest - 1)) row[PathLowestBit(rest)] = distance;
+
+    *claimed = (FlowWord){ x, y, cells };
+
+    return 1;
+}
+
+// Get lower neighbour distance + 1, -1 if no neighbour is reachable
+static int FlowNeighbourDistance(FlowField *field, int cell)
+{
+    int x = cell%field->width;
+    int y = cell/field->width;
+    int best = -1;
+
+    for (int i = 0; i < 4; i++)
+    {
+        int distance = GetFlowFieldDistance(*field, x + pathDirections[i].x, y + pathDirections[i].y);
+        if ((distance >= 0) && ((best < 0) || (distance + 1 < best))) best = distance + 1;
+    }
+
+    return best;
+}
+
+// Cell became walkable: set its distance from neighbours and propagate decreased distances
+// NOTE: Single source, so a FIFO queue processes cells in distance order (BFS)
+static void FlowPropagate(FlowField *field, MazeGrid grid, int cell)
+{
+    int *distance = field->distance;
+    int count = 0;
+
+    distance[cell] = FlowNeighbourDistance(field, cell);
+    if ((distance[cell] < 0) || !FlowQueuePush(field, &count, cell)) return;
+
+    for (int head = 0; head < count; head++)
+    {
+        int current = field->queue[head];
+        int cx = current%grid.width;
+        int cy = current/grid.width;
+
+        field->updated++;
+
+        for (int i = 0; i < 4; i++)
+        {
+            int nx = cx + pathDirections[i].x;
+            int ny = cy + pathDirections[i].y;
+            if (IsMazeWall(grid, nx, ny)) continue;
+
+            int neighbour = ny*grid.width + nx;
+            if ((distance[neighbour] < 0) || (distance[neighbour] > distance[current] + 1))
+            {
+                distance[neighbour] = distance[current] + 1;
+                if (!FlowQueuePush(field, &count, neighbour)) return;
+            }
+        }
+    }
+}
+
+// Cell became wall: find cells depending on it and recompute them from the unaffected ones
+// NOTE: A cell is affected if no unaffected neighbour is one step closer to goal, cells are
+// checked in distance order (FIFO from the wall), affected ones are invalidated (-1) and then
+// recomputed as a multi-source BFS, seeded from their unaffected neighbours in distance order
+static void FlowInvalidate(FlowField *field, MazeGrid grid, int cell)
+{
+    int *distance = field->distance;
+    int count = 0;
+    int affectedCount = 0;
+
+    // Find affected cells, starting from the wall (its old distance is kept until it is checked)
+    field->visited[(cell/grid.width)*grid.stride + ((cell%grid.width) >> 6)] |= 1ull << ((cell%grid.width) & 63);
+    if (!FlowQueuePush(field, &count, cell)) return;
+
+    for (int head = 0; head < count; head++)
+    {
+        int current = field->queue[head];
+        int cx = current%grid.width;
+        int cy = current/grid.width;
+        int currentDistance = distance[current];
+        bool supported = (current != cell) && (FlowNeighbourDistance(field, current) == currentDistance);
+
+        // NOTE: Cells farther than current can only be queued by cells at its distance,
+        // all of them were already checked, so it can be unmarked
+        field->visited[cy*grid.stride + (cx >> 6)] &= ~(1ull << (cx & 63));
+
+        if (supported) continue;
+
+        distance[current] = -1;
+        field->queue[affectedCount++] = current;
+
+        for (int i = 0; i < 4; i++)
+        {
+            int nx = cx + pathDirections[i].x;
+            int ny = cy + pathDirections[i].y;
+            if (GetFlowFieldDistance(*field, nx, ny) != currentDistance + 1) continue;
+
+            uint64_t *word = &field->visited[ny*grid.stride + (nx >> 6)];
+            if (*word & (1ull << (nx & 63))) continue;
+
+            *word |= 1ull << (nx & 63);
+            if (!FlowQueuePush(field, &count, ny*grid.width + nx)) return;
+        }
+    }
+
+    // Seed affected cells from their unaffected neighbours, sorted by distance
+    // NOTE: Seeds are stored as frontier entries: cell coordinates and distance (bits)
+    if (!FlowReserve(field, 0, affectedCount)) return;
+
+    FlowWord *seeds = field->frontier[0];
+    int seedCount = 0;
+
+    for (int i = 0; i < affectedCount; i++)
+    {
+        int current = field->queue[i];
+        int seedDistance = (current == cell)? -1 : FlowNeighbourDistance(field, current);
+        if (seedDistance < 0) continue;
+
+        seeds[seedCount++] = (FlowWord){ current%grid.width, current/grid.width, (uint64_t)seedDistance };
+    }
+
+    qsort(seeds, seedCount, sizeof(FlowWord), FlowCompareSeeds);
+    field->updated = affectedCount;
+
+    // Multi-source BFS: seeds and queued cells are merged in distance order
+    int head = 0;
+    count = 0;
+
+    for (int s = 0; (s < seedCount) || (head < count);)
+    {
+        int current = -1;
+
+        if ((s < seedCount) && ((head == count) || ((int)seeds[s].bits <= distance[field->queue[head]])))
+        {
+            current = seeds[s].y*grid.width + seeds[s].x;
+            int seedDistance = (int)seeds[s].bits;
+            s++;
+
+            if ((distance[current] >= 0) && (distance[current] <= seedDistance)) continue;
+            distance[current] = seedDistance;
+        }
+        else current = field->queue[head++];
+
+        int cx = current%grid.width;
+        int cy = current/grid.width;
+
+        for (int i = 0; i < 4; i++)
+        {
+            int nx = cx + pathDirections[i].x;
+            int ny = cy + pathDirections[i].y;
+            if (IsMazeWall(grid, nx, ny)) continue;
+
+            int neighbour = ny*grid.width + nx;
+            if ((distance[neighbour] < 0) || (distance[neighbour] > distance[current] + 1))
+            {
+                distance[neighbour] = distance[current] + 1;
+                if (!FlowQueuePush(field, &count, neighbour)) return;
+            }
+        }
+    }
+}
+
+// Compare seeds by distance (qsort)
+static int FlowCompareSeeds(const void *a, const void *b)
+{
+    uint64_t da = ((const FlowWord *)a)->bits;
+    uint64_t db = ((const FlowWord *)b)->bits;
+
+    return (da > db) - (da < db);
+}
+
+#if !defined(MAZE_NO_THREADS)
+// Expand BFS level with all workers, calling thread included
+static int FlowExpandShared(FlowWorkers *workers, int distance, int frontierCount)
+{
+    workers->distance = distance;
+    workers->frontierCount = frontierCount;
+    atomic_store(&workers->nextWord, 0);
+    atomic_store(&workers->nextCount, 0);
+    atomic_store(&workers->finished, 0);
+
+    mtx_lock(&workers->mutex);
+    workers->generation++;
+    cnd_broadcast(&workers->dispatch);
+    mtx_unlock(&workers->mutex);
+
+    FlowWorkerExpand(workers);
+
+    // NOTE: Levels are short, waiting is done spinning instead of sleeping
+    while (atomic_load(&workers->finished) < workers->workerCount) thrd_yield();
+
+    return atomic_load(&workers->nextCount);
+}
+
+// Expand frontier chunks until level is done, claimed words are appended to next frontier
+static void FlowWorkerExpand(FlowWorkers *workers)
+{
+    FlowField *field = workers->field;
+    FlowWord claimed[FLOW_WORKER_CHUNK*5];
+
+    for (int first = atomic_fetch_add(&workers->nextWord, FLOW_WORKER_CHUNK); first < workers->frontierCount;
+         first = atomic_fetch_add(&workers->nextWord, FLOW_WORKER_CHUNK))
+    {
+        int last = (first + FLOW_WORKER_CHUNK < workers->frontierCount)? first + FLOW_WORKER_CHUNK : workers->frontierCount;
+        int claimedCount = 0;
+
+        for (int i = first; i < last; i++)
+        {
+            claimedCount += FlowExpandWord(field, workers->grid, field->frontier[0][i], workers->distance, true, claimed + claimedCount);
+        }
+
+        int offset = atomic_fetch_add(&workers->nextCount, claimedCount);
+        memcpy(field->frontier[1] + offset, claimed, claimedCount*sizeof(FlowWord));
+    }
+}
+
+// Worker thread: expand dispatched levels until quit
+static int FlowWorker(void *arg)
+{
+    FlowWorkers *workers = (FlowWorkers *)arg;
+    int generation = 0;
+
+    while (true)
+    {
+        mtx_lock(&workers->mutex);
+        while ((workers->generation == generation) && !workers->quit) cnd_wait(&workers->dispatch, &workers->mutex);
+        generation = workers->generation;
+        bool quit = workers->quit;
+        mtx_unlock(&workers->mutex);
+
+        if (quit) break;
+
+        FlowWorkerExpand(workers);
+        atomic_fetch_add(&workers->finished, 1);
+    }
+
+    return 0;
+}
+#endif
+
+#endif // MAZE_IMPLEMENTATION
+
+#endif // MAZE_PATH_H
@@ -0,0 +1,292 @@
+/**********************************************************************************************
+*
+*   maze_prof - Frame phases profiler module
+*
+*   Lightweight timers for named zones (i.e. frame phases: update, collision, drawing...),
+*   every zone keeps its last MAZE_PROF_SAMPLES timings in a ring buffer, statistics
+*   (mean, p50, p99, max) are computed on request from the samples in the ring buffer
+*
+*   Zones are timed with BeginMazeProfilerZone()/EndMazeProfilerZone() pairs (same thread),
+*   samples can also be added from any thread with AddMazeProfilerSample(): ring buffer slots
+*   are claimed with an atomic counter, recording never locks or allocates
+*
+*   Statistics can be drawn as an overlay (raylib) or exported to CSV/JSON files (headless)
+*
+*   NOTE: Drawing zones time CPU side only (commands submission), GPU work is asynchronous
+*
+*   CONFIGURATION:
+*       #define MAZE_IMPLEMENTATION
+*           Generates the implementation of the module in the including file,
+*           only ONE file of the program should define it
+*
+*       #define MAZE_NO_THREADS
+*           Ring buffer counters are not atomic, samples must be added from a single thread
+*
+*   DEPENDENCIES:
+*       raylib.h    - OPTIONAL: If included before this module, overlay drawing is available
+*                     (DrawMazeProfiler())
+*       maze.h      - GetElapsedTime()
+*       stdatomic.h - Ring buffer counters (C11), not required if MAZE_NO_THREADS is defined
+*
+**********************************************************************************************/
+
+#ifndef MAZE_PROF_H
+#define MAZE_PROF_H
+
+#include "maze.h"                       // Required for: GetElapsedTime()
+
+#if !defined(MAZE_NO_THREADS)
+    #include <stdatomic.h>              // Required for: atomic_uint
+#endif
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define MAZE_PROF_MAX_ZONES     16      // Maximum zones per profiler
+#define MAZE_PROF_SAMPLES       256     // Samples kept per zone (power of two)
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Profiler zone, ring buffer of last timings
+typedef struct MazeProfilerZone {
+    const char *name;           // Zone name (not copied, must be kept valid)
+    double startTime;           // Current timing start (BeginMazeProfilerZone())
+#if !defined(MAZE_NO_THREADS)
+    atomic_uint sampleCount;    // Samples added since start (next ring buffer slot)
+#else
+    unsigned int sampleCount;   // Samples added since start (next ring buffer slot)
+#endif
+    float samples[MAZE_PROF_SAMPLES];   // Timings ring buffer (milliseconds)
+} MazeProfilerZone;
+
+// Profiler, fixed set of zones
+typedef struct MazeProfiler {
+    int zoneCount;              // Zones added
+    MazeProfilerZone zones[MAZE_PROF_MAX_ZONES];    // Zones
+} MazeProfiler;
+
+// Zone statistics, computed from ring buffer samples (milliseconds)
+typedef struct MazeProfilerStats {
+    int count;                  // Samples available (up to MAZE_PROF_SAMPLES)
+    float last;                 // Last sample
+    float mean;                 // Mean
+    float p50;                  // Median (50th percentile)
+    float p99;                  // 99th percentile
+    float max;                  // Maximum
+} MazeProfilerStats;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+int AddMazeProfilerZone(MazeProfiler *profiler, const char *name);  // Add named zone, returns zone index (-1 if full)
+void BeginMazeProfilerZone(MazeProfiler *profiler, int zone);       // Begin zone timing
+void EndMazeProfilerZone(MazeProfiler *profiler, int zone);         // End zone timing, adds sample
+void AddMazeProfilerSample(MazeProfiler *profiler, int zone, double time);  // Add zone sample (seconds), lock-free, any thread
+MazeProfilerStats GetMazeProfilerStats(const MazeProfiler *profiler, int zone);   // Get zone statistics
+bool ExportMazeProfilerCSV(const MazeProfiler *profiler, const char *fileName);    // Export zones statistics as CSV
+bool ExportMazeProfilerJSON(const MazeProfiler *profiler, const char *fileName);   // Export zones statistics as JSON
+
+#if defined(RAYLIB_H)
+void DrawMazeProfiler(const MazeProfiler *profiler, int posX, int posY, int fontSize);    // Draw zones statistics overlay
+#endif
+
+#if defined(__cplusplus)
+}
+#endif
+
+/***********************************************************************************
+*
+*   MAZE PROF IMPLEMENTATION
+*
+************************************************************************************/
+#if defined(MAZE_IMPLEMENTATION)
+
+#include <stdio.h>                      // Required for: FILE, fopen(), fprintf(), snprintf()
+#include <stdlib.h>                     // Required for: qsort()
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static int ProfCompareSamples(const void *a, const void *b);        // Compare samples (qsort)
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Add named zone, returns zone index (-1 if full)
+int AddMazeProfilerZone(MazeProfiler *profiler, const char *name)
+{
+    if (profiler->zoneCount >= MAZE_PROF_MAX_ZONES) return -1;
+
+    profiler->zones[profiler->zoneCount].name = name;
+
+    return profiler->zoneCount++;
+}
+
+// Begin zone timing
+void BeginMazeProfilerZone(MazeProfiler *profiler, int zone)
+{
+    if ((zone < 0) || (zone >= profiler->zoneCount)) return;
+
+    profiler->zones[zone].startTime = GetElapsedTime();
+}
+
+// End zone timing, adds sample
+void EndMazeProfilerZone(MazeProfiler *profiler, int zone)
+{
+    if ((zone < 0) || (zone >= profiler->zoneCount)) return;
+
+    AddMazeProfilerSample(profiler, zone, GetElapsedTime() - profiler->zones[zone].startTime);
+}
+
+// Add zone sample (seconds), lock-free, any thread
+// NOTE: Every sample claims its own ring buffer slot, readers can get a slot being written (stale value)
+void AddMazeProfilerSample(MazeProfiler *profiler, int zone, double time)
+{
+    if ((zone < 0) || (zone >= profiler->zoneCount)) return;
+
+    MazeProfilerZone *profZone = &profiler->zones[zone];
+
+#if !defined(MAZE_NO_THREADS)
+    unsigned int index = atomic_fetch_add_explicit(&profZone->sampleCount, 1, memory_order_relaxed);
+#else
+    unsigned int index = profZone->sampleCount++;
+#endif
+
+    profZone->samples[index & (MAZE_PROF_SAMPLES - 1)] = (float)(time*1000.0);
+}
+
+// Get zone statistics
+// NOTE: Percentiles use nearest rank over the samples in the ring buffer
+MazeProfilerStats GetMazeProfilerStats(const MazeProfiler *profiler, int zone)
+{
+    MazeProfilerStats stats = { 0 };
+
+    if ((zone < 0) || (zone >= profiler->zoneCount)) return stats;
+
+    const MazeProfilerZone *profZone = &profiler->zones[zone];
+
+#if !defined(MAZE_NO_THREADS)
+    unsigned int sampleCount = atomic_load_explicit(&profZone->sampleCount, memory_order_relaxed);
+#else
+    unsigned int sampleCount = profZone->sampleCount;
+#endif
+
+    if (sampleCount == 0) return stats;
+
+    float sorted[MAZE_PROF_SAMPLES] = { 0 };
+    int count = (sampleCount < MAZE_PROF_SAMPLES)? (int)sampleCount : MAZE_PROF_SAMPLES;
+    double sum = 0.0;
+
+    for (int i = 0; i < count; i++)
+    {
+        sorted[i] = profZone->samples[i];
+        sum += sorted[i];
+    }
+
+    qsort(sorted, count, sizeof(float), ProfCompareSamples);
+
+    stats.count = count;
+    stats.last = profZone->samples[(sampleCount - 1) & (MAZE_PROF_SAMPLES - 1)];
+    stats.mean = (float)(sum/count);
+    stats.p50 = sorted[(count*50 + 99)/100 - 1];
+    stats.p99 = sorted[(count*99 + 99)/100 - 1];
+    stats.max = sorted[count - 1];
+
+    return stats;
+}
+
+// Export zones statistics as CSV
+// NOTE: One row per zone, times in milliseconds
+bool ExportMazeProfilerCSV(const MazeProfiler *profiler, const char *fileName)
+{
+    FILE *file = fopen(fileName, "wt");
+
+    if (file == NULL) return false;
+
+    fprintf(file, "zone,samples,last_ms,mean_ms,p50_ms,p99_ms,max_ms\n");
+
+    for (int i = 0; i < profiler->zoneCount; i++)
+    {
+        MazeProfilerStats stats = GetMazeProfilerStats(profiler, i);
+        fprintf(file, "%s,%i,%.4f,%.4f,%.4f,%.4f,%.4f\n", profiler->zones[i].name, stats.count, stats.last, stats.mean, stats.p50, stats.p99, stats.max);
+    }
+
+    return (fclose(file) == 0);
+}
+
+// Export zones statistics as JSON
+// NOTE: Zone names are written as they are (not escaped), times in milliseconds
+bool ExportMazeProfilerJSON(const MazeProfiler *profiler, const char *fileName)
+{
+    FILE *file = fopen(fileName, "wt");
+
+    if (file == NULL) return false;
+
+    fprintf(file, "{\n    \"zones\": [\n");
+
+    for (int i = 0; i < profiler->zoneCount; i++)
+    {
+        MazeProfilerStats stats = GetMazeProfilerStats(profiler, i);
+        fprintf(file, "        { \"name\": \"%s\", \"samples\": %i, \"last_ms\": %.4f, \"mean_ms\": %.4f, \"p50_ms\": %.4f, \"p99_ms\": %.4f, \"max_ms\": %.4f }%s\n",
+            profiler->zones[i].name, stats.count, stats.last, stats.mean, stats.p50, stats.p99, stats.max, (i < (profiler->zoneCount - 1))? "," : "");
+    }
+
+    fprintf(file, "    ]\n}\n");
+
+    return (fclose(file) == 0);
+}
+
+#if defined(RAYLIB_H)
+// Draw zones statistics overlay
+void DrawMazeProfiler(const MazeProfiler *profiler, int posX, int posY, int fontSize)
+{
+    int lineHeight = fontSize + 4;
+    int columnWidth = fontSize*4;
+    char text[64] = { 0 };
+
+    DrawRectangle(posX, posY, columnWidth*6 + 8, lineHeight*(profiler->zoneCount + 1) + 8, Fade(BLACK, 0.7f));
+
+    DrawText("zone", posX + 4, posY + 4, fontSize, LIGHTGRAY);
+    DrawText("last", posX + 4 + columnWidth*2, posY + 4, fontSize, LIGHTGRAY);
+    DrawText("p50", posX + 4 + columnWidth*3, posY + 4, fontSize, LIGHTGRAY);
+    DrawText("p99", posX + 4 + columnWidth*4, posY + 4, fontSize, LIGHTGRAY);
+    DrawText("max", posX + 4 + columnWidth*5, posY + 4, fontSize, LIGHTGRAY);
+
+    for (int i = 0; i < profiler->zoneCount; i++)
+    {
+        MazeProfilerStats stats = GetMazeProfilerStats(profiler, i);
+        int y = posY + 4 + lineHeight*(i + 1);
+
+        DrawText(profiler->zones[i].name, posX + 4, y, fontSize, WHITE);
+        snprintf(text, sizeof(text), "%.2f", stats.last);
+        DrawText(text, posX + 4 + columnWidth*2, y, fontSize, WHITE);
+        snprintf(text, sizeof(text), "%.2f", stats.p50);
+        DrawText(text, posX + 4 + columnWidth*3, y, fontSize, WHITE);
+        snprintf(text, sizeof(text), "%.2f", stats.p99);
+        DrawText(text, posX + 4 + columnWidth*4, y, fontSize, (stats.p99 > 16.0f)? RED : WHITE);
+        snprintf(text, sizeof(text), "%.2f", stats.max);
+        DrawText(text, posX + 4 + columnWidth*5, y, fontSize, WHITE);
+    }
+}
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+// Compare samples (qsort)
+static int ProfCompareSamples(const void *a, const void *b)
+{
+    float sampleA = *(const float *)a;
+    float sampleB = *(const float *)b;
+
+    return (sampleA > sampleB) - (sampleA < sampleB);
+}
+
+#endif // MAZE_IMPLEMENTATION
+
+#endif // MAZE_PROF_H
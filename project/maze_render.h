@@ -0,0 +1,1162 @@
+/**********************************************************************************************
+*
+*   maze_render - Maze chunked renderer module
+*
+*   Draws a MazeGrid in 2D using a biome atlas, the maze is split in square chunks of cells
+*   that are pre-rendered (baked) into render textures, only chunks visible by the camera
+*   are drawn, so draw calls per frame depend on screen size, not on maze size
+*
+*   Baked chunks are kept in a fixed-size cache (least recently used chunk is replaced when
+*   a new one is required), a chunk is only baked again when its cells change (the user must
+*   notify it with SetMazeRendererCellDirty()) or when it is requested with another atlas
+*
+*   Biome atlas layout (same as the game atlases): 2x2 tiles, wall tile bottom-left,
+*   floor tile bottom-right
+*
+*   The 3D maze model (MazeModel) is also split in chunks, one model per chunk generated with
+*   the greedy maze mesher (maze_mesh.h), so changing some cells only rebuilds the chunks
+*   containing them or their neighbours (UpdateMazeModelRec()), chunk meshes can also be generated
+*   on another thread (GenMeshMazeData()) and only uploaded on main thread (LoadMazeModelFromMeshes())
+*
+*   Streamed mazes (maze_stream.h) are drawn from the stream window: 2D draws the visible cells
+*   directly (DrawMazeStream()), 3D keeps one model per window slot (MazeStreamModel), generated
+*   when the slot chunk gets ready, a limited number of chunks per frame
+*
+*   The 3D preview (MazePreview) renders a MazeModel into a texture only when required: model swapped,
+*   biome texture changed, camera moved or cells edited (SetMazePreviewDirty()), redraws are limited
+*   to an update rate and the texture can have a reduced resolution (huge mazes)
+*
+*   Maze items (maze_items.h) are drawn by MazeItemsRenderer: items are sorted in buckets of
+*   square chunks of cells (sorted again only when items are added or removed), so only items
+*   of chunks in view are processed; 2D items are atlas quads (batched), 3D items are billboards
+*   drawn with a single instanced draw call, oriented to the camera in the vertex shader
+*
+*   CONFIGURATION:
+*       #define MAZE_IMPLEMENTATION
+*           Generates the implementation of the module in the including file,
+*           only ONE file of the program should define it
+*
+*   DEPENDENCIES:
+*       raylib.h    - Render textures, drawing and models
+*       maze.h      - MazeGrid, memory allocators
+*       maze_mesh.h - Maze chunks meshes and shader
+*       maze_stream.h - Streamed maze window
+*       maze_items.h - Maze items pool
+*
+**********************************************************************************************/
+
+#ifndef MAZE_RENDER_H
+#define MAZE_RENDER_H
+
+#include "raylib.h"                     // Required for: RenderTexture2D, Texture2D, Camera2D, Model
+#include "maze.h"                       // Required for: MazeGrid
+#include "maze_mesh.h"                  // Required for: GenMeshMaze(), LoadMazeMeshShader()
+#include "maze_stream.h"                // Required for: MazeStream, IsMazeStreamWall()
+#include "maze_items.h"                 // Required for: MazeItems
+
+#define MAZE_STREAM_MODEL_PARTS     4   // Models per stream chunk (chunk split in 2x2 mesher regions)
+#define MAZE_ITEMS_CHUNK           32   // Items renderer chunk size in cells (culling buckets)
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Baked chunk cache slot
+typedef struct MazeChunkSlot {
+    RenderTexture2D target;     // Baked chunk, loaded on first use
+    int chunk;                  // Chunk index (chunkY*chunkCountX + chunkX), -1 if slot free
+    unsigned int atlasId;       // Atlas texture id used to bake the chunk
+    unsigned int lastUsed;      // Frame the chunk was last drawn (LRU)
+} MazeChunkSlot;
+
+// Maze chunked renderer
+typedef struct MazeRenderer {
+    int width;                  // Maze width in cells
+    int height;                 // Maze height in cells
+    int chunkSize;              // Chunk size in cells (chunks are square)
+    float cellSize;             // Cell size in world units (pixels)
+    int chunkCountX;            // Chunks per row
+    int chunkCountY;            // Chunks per column
+
+    int *chunkSlot;             // Cache slot of every chunk, -1 if not baked
+    MazeChunkSlot *slots;       // Cache slots
+    int slotCount;              // Cache slots (grows if more chunks are visible at once)
+
+    Rectangle view;             // Visible chunks (in chunks) of last update
+    unsigned int frame;         // Update counter (LRU)
+    int chunksBaked;            // Chunks baked by last update
+    int chunksDrawn;            // Chunks drawn by last draw
+} MazeRenderer;
+
+// Maze chunked 3D model
+typedef struct MazeModel {
+    int width;                  // Maze width in cells
+    int height;                 // Maze height in cells
+    int chunkSize;              // Chunk size in cells (chunks are square)
+    int chunkCountX;            // Chunks per row
+    int chunkCountY;            // Chunks per column
+
+    Model *chunks;              // Chunk models, chunkY*chunkCountX + chunkX
+    Shader shader;              // Maze mesh shader, shared by all chunks
+
+    int vertexCount;            // Vertices of all chunks
+    int triangleCount;          // Triangles of all chunks
+    int chunksRebuilt;          // Chunks generated by last load/update
+    double buildTime;           // Time to generate chunks of last load/update (seconds)
+} MazeModel;
+
+// Streamed maze 3D model, models of every stream window slot
+typedef struct MazeStreamModel {
+    int windowChunks;           // Stream window size (chunks per side)
+    Model *models;              // Slot models, MAZE_STREAM_MODEL_PARTS per slot
+    Point *builtChunk;          // Chunk of slot models
+    unsigned int *builtVersion; // Stream slot version of slot models (0: not built)
+    Shader shader;              // Maze mesh shader, shared by all models
+    Texture2D texture;          // Diffuse texture (biome atlas) of all models
+    int chunksRebuilt;          // Chunks generated by last update
+} MazeStreamModel;
+
+// Maze 3D preview, model rendered into a texture only when its content changes
+typedef struct MazePreview {
+    RenderTexture2D target;     // Preview render texture (resolutionScale times preview size)
+    int width;                  // Preview width (screen pixels)
+    int height;                 // Preview height (screen pixels)
+    float resolutionScale;      // Render texture size relative to preview size
+    float updateRate;           // Maximum redraws per second (0: no limit)
+    bool dirty;                 // Content changed since last redraw
+    double lastUpdate;          // Last redraw time (seconds)
+    Camera3D camera;            // Camera of last redraw
+    Model *chunks;              // Model chunks of last redraw (model swapped)
+    unsigned int textureId;     // Model texture of last redraw (biome changed)
+    int redraws;                // Redraws since load
+} MazePreview;
+
+// Maze items renderer, items sorted by chunk for view culling
+typedef struct MazeItemsRenderer {
+    int width;                  // Maze width in cells (items pool of buckets)
+    int height;                 // Maze height in cells
+    int chunkCountX;            // Chunks per row
+    int chunkCountY;            // Chunks per column
+
+    int *chunkStart;            // First bucket entry of every chunk (chunks count + 1 entries)
+    int *bucket;                // Items indices, sorted by chunk
+    int bucketCapacity;         // Bucket entries allocated
+    unsigned int version;       // Items version of buckets
+    const int *itemsX;          // Items pool of buckets (pool swapped)
+    int itemsCount;             // Items count of buckets
+
+    Mesh quad;                  // Billboard quad, instanced for every item
+    Shader shader;              // Billboard instancing shader
+    Material material;          // Billboard material (shader and items atlas)
+    Matrix *transforms;         // Items instances transforms of last 3D draw
+    int transformCapacity;      // Transforms allocated
+
+    int itemsDrawn;             // Items drawn by last draw
+    int drawCalls;              // Instanced draw calls of last 3D draw
+} MazeItemsRenderer;
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+MazeRenderer LoadMazeRenderer(int width, int height, int chunkSize, float cellSize, int cacheSize);   // Load chunked renderer for a maze size
+void UnloadMazeRenderer(MazeRenderer renderer);                     // Unload chunked renderer (cache render textures)
+void SetMazeRendererCellDirty(MazeRenderer *renderer, int x, int y); // Notify maze cell changed, its chunk is baked again when visible
+void SetMazeRendererDirty(MazeRenderer *renderer);                 // Notify all maze cells changed
+
+// Bake visible chunks not in cache, must be called before BeginMode2D() (uses texture mode)
+void UpdateMazeRenderer(MazeRenderer *renderer, MazeGrid grid, Texture2D atlas, Camera2D camera);
+void DrawMazeRenderer(MazeRenderer *renderer);                      // Draw visible chunks, must be called inside BeginMode2D()
+
+MazeModel LoadMazeModel(MazeGrid grid, int chunkSize);              // Load chunked 3D model from maze grid (chunkSize up to MAZE_MESH_MAX_REGION)
+MazeModel LoadMazeModelFromMeshes(Mesh *meshes, int width, int height, int chunkSize);  // Load chunked 3D model from chunk meshes generated with GenMeshMazeData() (uploaded)
+void UnloadMazeModel(MazeModel model);                              // Unload chunked 3D model
+void UpdateMazeModelRec(MazeModel *model, MazeGrid grid, Rectangle rec);    // Rebuild chunks affected by changed cells region
+void SetMazeModelTexture(MazeModel *model, Texture2D texture);     // Set diffuse texture (biome atlas) of all chunks
+void DrawMazeModel(MazeModel model, Vector3 position, Color tint);  // Draw chunked 3D model, must be called inside BeginMode3D()
+
+void DrawMazeStream(MazeStream stream, Texture2D atlas, Camera2D camera, float cellSize);  // Draw streamed maze cells visible by camera, must be called inside BeginMode2D()
+MazeStreamModel LoadMazeStreamModel(MazeStream stream);             // Load streamed maze 3D model, models are generated as stream chunks get ready
+void UnloadMazeStreamModel(MazeStreamModel model);                  // Unload streamed maze 3D model
+void UpdateMazeStreamModel(MazeStreamModel *model, MazeStream stream, int maxChunks);  // Generate models of chunks ready since last update (up to maxChunks)
+void SetMazeStreamModelTexture(MazeStreamModel *model, Texture2D texture);   // Set diffuse texture (biome atlas) of all models
+void DrawMazeStreamModel(MazeStreamModel model, MazeStream stream, Color tint);     // Draw streamed maze 3D model, must be called inside BeginMode3D()
+
+MazePreview LoadMazePreview(int width, int height, float resolutionScale, float updateRate);   // Load maze 3D preview (render texture)
+void UnloadMazePreview(MazePreview preview);                        // Unload maze 3D preview
+void SetMazePreviewResolution(MazePreview *preview, float resolutionScale);    // Set preview texture resolution (relative to preview size)
+void SetMazePreviewDirty(MazePreview *preview);                     // Notify preview content changed (i.e. maze cells edited)
+bool UpdateMazePreview(MazePreview *preview, MazeModel model, Vector3 position, Camera3D camera, Color background);  // Redraw preview if required, returns true if redrawn
+void DrawMazePreview(MazePreview preview, Rectangle bounds);        // Draw preview texture (scaled to bounds)
+
+MazeItemsRenderer LoadMazeItemsRenderer(void);                      // Load items renderer (billboard quad and instancing shader)
+void UnloadMazeItemsRenderer(MazeItemsRenderer renderer);           // Unload items renderer
+void DrawMazeItems2D(MazeItemsRenderer *renderer, MazeItems items, Texture2D atlas, Camera2D camera, float cellSize, bool drawPicked);    // Draw items visible by camera, must be called inside BeginMode2D()
+void DrawMazeItems3D(MazeItemsRenderer *renderer, MazeItems items, Texture2D atlas, Camera3D camera, float viewDistance);     // Draw not picked items in view distance (instanced), must be called inside BeginMode3D()
+
+#if defined(__cplusplus)
+}
+#endif
+
+/***********************************************************************************
+*
+*   MAZE RENDER IMPLEMENTATION
+*
+************************************************************************************/
+
+#if defined(MAZE_IMPLEMENTATION)
+
+#include <stdlib.h>                     // Required for: malloc(), free(), abs()
+#include <string.h>                     // Required for: memset(), memcmp()
+#include <math.h>                       // Required for: floorf(), sqrtf()
+
+#if defined(PLATFORM_ANDROID) || defined(PLATFORM_WEB)
+    #define ITEMS_GLSL_VERSION  100
+#else
+    #define ITEMS_GLSL_VERSION  330
+#endif
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+// Items billboard shader: quad oriented to the camera (vertical axis fixed), positioned by instance transform
+// NOTE: Camera right vector is the first row of the view matrix
+static const char *itemsVertexShader =
+#if ITEMS_GLSL_VERSION == 330
+    "#version 330\n"
+    "in vec3 vertexPosition;\n"
+    "in vec2 vertexTexCoord;\n"
+    "in mat4 instanceTransform;\n"
+    "uniform mat4 mvp;\n"
+    "uniform mat4 matView;\n"
+    "out vec2 fragTexCoord;\n"
+#else
+    "#version 100\n"
+    "attribute vec3 vertexPosition;\n"
+    "attribute vec2 vertexTexCoord;\n"
+    "attribute mat4 instanceTransform;\n"
+    "uniform mat4 mvp;\n"
+    "uniform mat4 matView;\n"
+    "varying vec2 fragTexCoord;\n"
+#endif
+    "void main()\n"
+    "{\n"
+    "    vec3 right = vec3(matView[0][0], matView[1][0], matView[2][0]);\n"
+    "    vec3 position = instanceTransform[3].xyz + right*vertexPosition.x + vec3(0.0, vertexPosition.y, 0.0);\n"
+    "    fragTexCoord = vertexTexCoord;\n"
+    "    gl_Position = mvp*vec4(position, 1.0);\n"
+    "}\n";
+
+// NOTE: Transparent pixels are discarded, so they do not hide items drawn later
+static const char *itemsFragmentShader =
+#if ITEMS_GLSL_VERSION == 330
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec4 colDiffuse;\n"
+    "out vec4 finalColor;\n"
+    "void main()\n"
+    "{\n"
+    "    vec4 color = texture(texture0, fragTexCoord)*colDiffuse;\n"
+    "    if (color.a < 0.1) discard;\n"
+    "    finalColor = color;\n"
+    "}\n";
+#else
+    "#version 100\n"
+    "precision mediump float;\n"
+    "varying vec2 fragTexCoord;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec4 colDiffuse;\n"
+    "void main()\n"
+    "{\n"
+    "    vec4 color = texture2D(texture0, fragTexCoord)*colDiffuse;\n"
+    "    if (color.a < 0.1) discard;\n"
+    "    gl_FragColor = color;\n"
+    "}\n";
+#endif
+
+//----------------------------------------------------------------------------------
+// Module specific Functions Declaration
+//----------------------------------------------------------------------------------
+static int RendererGetSlot(MazeRenderer *renderer);                // Get a free cache slot, least recently used chunk is replaced
+static void RendererBakeChunk(MazeRenderer *renderer, MazeChunkSlot *slot, MazeGrid grid, Texture2D atlas);   // Draw chunk cells into slot render texture
+static Model ModelGenChunk(MazeModel *model, MazeGrid grid, int chunkX, int chunkY);  // Generate chunk model from its grid region
+static bool ItemsRendererUpdate(MazeItemsRenderer *renderer, MazeItems items);  // Sort items in chunk buckets if items changed, false if no buckets
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Load chunked renderer for a maze size
+// NOTE: Chunk render textures are only loaded when chunks are first drawn
+MazeRenderer LoadMazeRenderer(int width, int height, int chunkSize, float cellSize, int cacheSize)
+{
+    MazeRenderer renderer = { 0 };
+
+    if ((width <= 0) || (height <= 0) || (chunkSize <= 0) || (cellSize <= 0.0f) || (cacheSize <= 0)) return renderer;
+
+    renderer.chunkCountX = (width + chunkSize - 1)/chunkSize;
+    renderer.chunkCountY = (height + chunkSize - 1)/chunkSize;
+
+    size_t chunkCount = (size_t)renderer.chunkCountX*renderer.chunkCountY;
+
+    renderer.chunkSlot = (int *)MAZE_MALLOC(chunkCount*sizeof(int));
+    renderer.slots = (MazeChunkSlot *)MAZE_CALLOC(cacheSize, sizeof(MazeChunkSlot));
+
+    if ((renderer.chunkSlot == NULL) || (renderer.slots == NULL))
+    {
+        UnloadMazeRenderer(renderer);
+        return (MazeRenderer){ 0 };
+    }
+
+    memset(renderer.chunkSlot, 0xff, chunkCount*sizeof(int));
+    for (int i = 0; i < cacheSize; i++) renderer.slots[i].chunk = -1;
+
+    renderer.width = width;
+    renderer.height = height;
+    renderer.chunkSize = chunkSize;
+    renderer.cellSize = cellSize;
+    renderer.slotCount = cacheSize;
+
+    return renderer;
+}
+
+// Unload chunked renderer (cache render textures)
+void UnloadMazeRenderer(MazeRenderer renderer)
+{
+    for (int i = 0; i < renderer.slotCount; i++)
+    {
+        if (renderer.slots[i].target.id > 0) UnloadRenderTexture(renderer.slots[i].target);
+    }
+
+    MAZE_FREE(renderer.chunkSlot);
+    MAZE_FREE(renderer.slots);
+}
+
+// Notify maze cell changed, its chunk is baked again when visible
+void SetMazeRendererCellDirty(MazeRenderer *renderer, int x, int y)
+{
+    if (((unsigned int)x >= (unsigned int)renderer->width) || ((unsigned int)y >= (unsigned int)renderer->height)) return;
+
+    int chunk = (y/renderer->chunkSize)*renderer->chunkCountX + x/renderer->chunkSize;
+    int slot = renderer->chunkSlot[chunk];
+
+    // Slot is released, its render texture is kept for next baked chunk
+    if (slot >= 0)
+    {
+        renderer->slots[slot].chunk = -1;
+        renderer->chunkSlot[chunk] = -1;
+    }
+}
+
+// Notify all maze cells changed
+void SetMazeRendererDirty(MazeRenderer *renderer)
+{
+    for (int i = 0; i < renderer->slotCount; i++)
+    {
+        if (renderer->slots[i].chunk >= 0) renderer->chunkSlot[renderer->slots[i].chunk] = -1;
+        renderer->slots[i].chunk = -1;
+    }
+}
+
+// Bake visible chunks not in cache, must be called before BeginMode2D() (uses texture mode)
+void UpdateMazeRenderer(MazeRenderer *renderer, MazeGrid grid, Texture2D atlas, Camera2D camera)
+{
+    renderer->chunksBaked = 0;
+    renderer->view = (Rectangle){ 0 };
+
+    if ((renderer->chunkSlot == NULL) || (grid.width != renderer->width) || (grid.height != renderer->height)) return;
+
+    renderer->frame++;
+
+    // Get visible chunks range from screen corners
+    float chunkWorldSize = renderer->chunkSize*renderer->cellSize;
+    Vector2 viewMin = GetScreenToWorld2D((Vector2){ 0, 0 }, camera);
+    Vector2 viewMax = GetScreenToWorld2D((Vector2){ (float)GetScreenWidth(), (float)GetScreenHeight() }, camera);
+
+    int firstX = (viewMin.x < 0.0f)? 0 : (int)(viewMin.x/chunkWorldSize);
+    int firstY = (viewMin.y < 0.0f)? 0 : (int)(viewMin.y/chunkWorldSize);
+    int lastX = (viewMax.x < 0.0f)? -1 : (int)(viewMax.x/chunkWorldSize);
+    int lastY = (viewMax.y < 0.0f)? -1 : (int)(viewMax.y/chunkWorldSize);
+    if (lastX >= renderer->chunkCountX) lastX = renderer->chunkCountX - 1;
+    if (lastY >= renderer->chunkCountY) lastY = renderer->chunkCountY - 1;
+    if ((firstX > lastX) || (firstY > lastY)) return;
+
+    renderer->view = (Rectangle){ (float)firstX, (float)firstY, (float)(lastX - firstX + 1), (float)(lastY - firstY + 1) };
+
+    // Grow cache if it can not hold all visible chunks (i.e. screen resized)
+    int visibleCount = (lastX - firstX + 1)*(lastY - firstY + 1);
+    if (visibleCount > renderer->slotCount)
+    {
+        MazeChunkSlot *slots = (MazeChunkSlot *)MAZE_REALLOC(renderer->slots, visibleCount*sizeof(MazeChunkSlot));
+        if (slots == NULL) return;
+
+        memset(slots + renderer->slotCount, 0, (visibleCount - renderer->slotCount)*sizeof(MazeChunkSlot));
+        for (int i = renderer->slotCount; i < visibleCount; i++) slots[i].chunk = -1;
+
+        renderer->slots = slots;
+        renderer->slotCount = visibleCount;
+    }
+
+    // Mark visible chunks as used before baking, so they are not replaced by another visible chunk
+    for (int y = firstY; y <= lastY; y++)
+    {
+        for (int x = firstX; x <= lastX; x++)
+        {
+            int slot = renderer->chunkSlot[y*renderer->chunkCountX + x];
+            if (slot >= 0) renderer->slots[slot].lastUsed = renderer->frame;
+        }
+    }
+
+    for (int y = firstY; y <= lastY; y++)
+    {
+        for (int x = firstX; x <= lastX; x++)
+        {
+            int chunk = y*renderer->chunkCountX + x;
+            int slot = renderer->chunkSlot[chunk];
+
+            if ((slot >= 0) && (renderer->slots[slot].atlasId == atlas.id)) continue;
+
+            if (slot < 0)
+            {
+                slot = RendererGetSlot(renderer);
+                renderer->slots[slot].chunk = chunk;
+                renderer->chunkSlot[chunk] = slot;
+            }
+
+            renderer->slots[slot].lastUsed = renderer->frame;
+            RendererBakeChunk(renderer, &renderer->slots[slot], grid, atlas);
+            renderer->chunksBaked++;
+        }
+    }
+}
+
+// Draw visible chunks, must be called inside BeginMode2D()
+void DrawMazeRenderer(MazeRenderer *renderer)
+{
+    float chunkWorldSize = renderer->chunkSize*renderer->cellSize;
+
+    renderer->chunksDrawn = 0;
+
+    for (int y = (int)renderer->view.y; y < (int)(renderer->view.y + renderer->view.height); y++)
+    {
+        for (int x = (int)renderer->view.x; x < (int)(renderer->view.x + renderer->view.width); x++)
+        {
+            int slot = renderer->chunkSlot[y*renderer->chunkCountX + x];
+            if (slot < 0) continue;
+
+            // NOTE: Render texture is flipped vertically (OpenGL coordinates)
+            Texture2D texture = renderer->slots[slot].target.texture;
+            DrawTextureRec(texture, (Rectangle){ 0, 0, (float)texture.width, (float)-texture.height }, (Vector2){ x*chunkWorldSize, y*chunkWorldSize }, WHITE);
+            renderer->chunksDrawn++;
+        }
+    }
+}
+
+// Load chunked 3D model from maze grid (chunkSize up to MAZE_MESH_MAX_REGION)
+MazeModel LoadMazeModel(MazeGrid grid, int chunkSize)
+{
+    MazeModel model = { 0 };
+
+    if ((grid.width <= 0) || (grid.height <= 0) || (chunkSize <= 0) || (chunkSize > MAZE_MESH_MAX_REGION)) return model;
+
+    model.chunkCountX = (grid.width + chunkSize - 1)/chunkSize;
+    model.chunkCountY = (grid.height + chunkSize - 1)/chunkSize;
+    model.chunks = (Model *)MAZE_CALLOC(model.chunkCountX*model.chunkCountY, sizeof(Model));
+
+    if (model.chunks == NULL) return (MazeModel){ 0 };
+
+    model.width = grid.width;
+    model.height = grid.height;
+    model.chunkSize = chunkSize;
+    model.shader = LoadMazeMeshShader();
+
+    UpdateMazeModelRec(&model, grid, (Rectangle){ 0, 0, (float)grid.width, (float)grid.height });
+
+    return model;
+}
+
+// Load chunked 3D model from chunk meshes generated with GenMeshMazeData() (uploaded)
+// NOTE: Meshes array (chunkY*chunkCountX + chunkX) is freed, model chunks take meshes data,
+// on failure meshes are unloaded, no grid is required so meshes can be generated on another thread
+MazeModel LoadMazeModelFromMeshes(Mesh *meshes, int width, int height, int chunkSize)
+{
+    MazeModel model = { 0 };
+
+    if (meshes == NULL) return model;
+
+    int chunkCount = 0;
+
+    if ((width > 0) && (height > 0) && (chunkSize > 0) && (chunkSize <= MAZE_MESH_MAX_REGION))
+    {
+        model.chunkCountX = (width + chunkSize - 1)/chunkSize;
+        model.chunkCountY = (height + chunkSize - 1)/chunkSize;
+        chunkCount = model.chunkCountX*model.chunkCountY;
+        model.chunks = (Model *)MAZE_CALLOC(chunkCount, sizeof(Model));
+    }
+
+    if (model.chunks == NULL)
+    {
+        for (int i = 0; i < chunkCount; i++) UnloadMesh(meshes[i]);
+        MAZE_FREE(meshes);
+        return (MazeModel){ 0 };
+    }
+
+    model.width = width;
+    model.height = height;
+    model.chunkSize = chunkSize;
+    model.shader = LoadMazeMeshShader();
+
+    double startTime = GetElapsedTime();
+
+    for (int i = 0; i < chunkCount; i++)
+    {
+        if (meshes[i].vertexCount <= 0) continue;
+
+        // Upload vertex data to GPU (static mesh)
+        UploadMesh(&meshes[i], false);
+
+        model.chunks[i] = LoadModelFromMesh(meshes[i]);
+        model.chunks[i].materials[0].shader = model.shader;
+        model.vertexCount += meshes[i].vertexCount;
+        model.triangleCount += meshes[i].triangleCount;
+        model.chunksRebuilt++;
+    }
+
+    model.buildTime = GetElapsedTime() - startTime;
+
+    MAZE_FREE(meshes);
+
+    return model;
+}
+
+// Unload chunked 3D model
+void UnloadMazeModel(MazeModel model)
+{
+    for (int i = 0; i < model.chunkCountX*model.chunkCountY; i++) UnloadModel(model.chunks[i]);
+
+    if (model.chunks != NULL) UnloadShader(model.shader);
+    MAZE_FREE(model.chunks);
+}
+
+// Rebuild chunks affected by changed cells region
+// NOTE: Wall sides depend on neighbour cells, chunks touching the region border are also rebuilt
+void UpdateMazeModelRec(MazeModel *model, MazeGrid grid, Rectangle rec)
+{
+    model->chunksRebuilt = 0;
+    model->buildTime = 0.0;
+
+    if ((model->chunks == NULL) || (grid.width != model->width) || (grid.height != model->height)) return;
+    if ((rec.width <= 0) || (rec.height <= 0)) return;
+
+    int firstX = ((int)rec.x - 1)/model->chunkSize;
+    int firstY = ((int)rec.y - 1)/model->chunkSize;
+    int lastX = (int)(rec.x + rec.width)/model->chunkSize;
+    int lastY = (int)(rec.y + rec.height)/model->chunkSize;
+    if (firstX < 0) firstX = 0;
+    if (firstY < 0) firstY = 0;
+    if (lastX >= model->chunkCountX) lastX = model->chunkCountX - 1;
+    if (lastY >= model->chunkCountY) lastY = model->chunkCountY - 1;
+
+    double startTime = GetElapsedTime();
+
+    for (int y = firstY; y <= lastY; y++)
+    {
+        for (int x = firstX; x <= lastX; x++)
+        {
+            Model *chunk = &model->chunks[y*model->chunkCountX + x];
+
+            // Keep chunk texture (biome) on rebuild
+            Texture2D texture = { 0 };
+            if (chunk->materialCount > 0)
+            {
+                texture = chunk->materials[0].maps[MATERIAL_MAP_DIFFUSE].texture;
+                model->vertexCount -= chunk->meshes[0].vertexCount;
+                model->triangleCount -= chunk->meshes[0].triangleCount;
+            }
+
+            UnloadModel(*chunk);
+            *chunk = ModelGenChunk(model, grid, x, y);
+
+            if (chunk->materialCount > 0)
+            {
+                chunk->materials[0].shader = model->shader;
+                if (texture.id > 0) chunk->materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = texture;
+                model->vertexCount += chunk->meshes[0].vertexCount;
+                model->triangleCount += chunk->meshes[0].triangleCount;
+            }
+
+            model->chunksRebuilt++;
+        }
+    }
+
+    model->buildTime = GetElapsedTime() - startTime;
+}
+
+// Set diffuse texture (biome atlas) of all chunks
+void SetMazeModelTexture(MazeModel *model, Texture2D texture)
+{
+    for (int i = 0; i < model->chunkCountX*model->chunkCountY; i++)
+    {
+        if (model->chunks[i].materialCount > 0) model->chunks[i].materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = texture;
+    }
+}
+
+// Draw chunked 3D model, must be called inside BeginMode3D()
+void DrawMazeModel(MazeModel model, Vector3 position, Color tint)
+{
+    for (int y = 0; y < model.chunkCountY; y++)
+    {
+        for (int x = 0; x < model.chunkCountX; x++)
+        {
+            Vector3 chunkPosition = { position.x + x*model.chunkSize, position.y, position.z + y*model.chunkSize };
+            DrawModel(model.chunks[y*model.chunkCountX + x], chunkPosition, 1.0f, tint);
+        }
+    }
+}
+
+// Draw streamed maze cells visible by camera, must be called inside BeginMode2D()
+// NOTE: Cells are drawn directly (one atlas quad per cell, batched), only visible cells are
+// processed so cost only depends on screen size and zoom, cells of chunks not ready are not drawn
+void DrawMazeStream(MazeStream stream, Texture2D atlas, Camera2D camera, float cellSize)
+{
+    Vector2 viewMin = GetScreenToWorld2D((Vector2){ 0, 0 }, camera);
+    Vector2 viewMax = GetScreenToWorld2D((Vector2){ (float)GetScreenWidth(), (float)GetScreenHeight() }, camera);
+    int firstX = (int)floorf(viewMin.x/cellSize);
+    int firstY = (int)floorf(viewMin.y/cellSize);
+    int lastX = (int)floorf(viewMax.x/cellSize);
+    int lastY = (int)floorf(viewMax.y/cellSize);
+
+    Rectangle wallTile = { 0, atlas.height/2.0f, atlas.width/2.0f, atlas.height/2.0f };
+    Rectangle floorTile = { atlas.width/2.0f, atlas.height/2.0f, atlas.width/2.0f, atlas.height/2.0f };
+
+    for (int y = firstY; y <= lastY; y++)
+    {
+        for (int x = firstX; x <= lastX; x++)
+        {
+            if (!IsMazeStreamChunkReady(stream, GetMazeStreamChunk(x), GetMazeStreamChunk(y))) continue;
+
+            Rectangle dest = { x*cellSize, y*cellSize, cellSize, cellSize };
+            DrawTexturePro(atlas, IsMazeStreamWall(stream, x, y)? wallTile : floorTile, dest, (Vector2){ 0, 0 }, 0.0f, WHITE);
+        }
+    }
+}
+
+// Load streamed maze 3D model, models are generated as stream chunks get ready
+MazeStreamModel LoadMazeStreamModel(MazeStream stream)
+{
+    MazeStreamModel model = { 0 };
+    int slotCount = stream.windowChunks*stream.windowChunks;
+
+    if (slotCount <= 0) return model;
+
+    model.models = (Model *)MAZE_CALLOC(slotCount*MAZE_STREAM_MODEL_PARTS, sizeof(Model));
+    model.builtChunk = (Point *)MAZE_MALLOC(slotCount*sizeof(Point));
+    model.builtVersion = (unsigned int *)MAZE_CALLOC(slotCount, sizeof(unsigned int));
+
+    if ((model.models == NULL) || (model.builtChunk == NULL) || (model.builtVersion == NULL))
+    {
+        MAZE_FREE(model.models);
+        MAZE_FREE(model.builtChunk);
+        MAZE_FREE(model.builtVersion);
+        return (MazeStreamModel){ 0 };
+    }
+
+    model.windowChunks = stream.windowChunks;
+    model.shader = LoadMazeMeshShader();
+
+    return model;
+}
+
+// Unload streamed maze 3D model
+void UnloadMazeStreamModel(MazeStreamModel model)
+{
+    for (int i = 0; i < model.windowChunks*model.windowChunks*MAZE_STREAM_MODEL_PARTS; i++) UnloadModel(model.models[i]);
+
+    if (model.models != NULL) UnloadShader(model.shader);
+    MAZE_FREE(model.models);
+    MAZE_FREE(model.builtChunk);
+    MAZE_FREE(model.builtVersion);
+}
+
+// Generate models of stream chunks ready since last update, up to maxChunks (nearest to center first)
+// NOTE: Cells out of the chunk are considered walkable by the mesher, faces on chunk borders are
+// always generated, so chunk models never depend on neighbour chunks
+void UpdateMazeStreamModel(MazeStreamModel *model, MazeStream stream, int maxChunks)
+{
+    int slotCount = model->windowChunks*model->windowChunks;
+    int partSize = MAZE_STREAM_CHUNK/2;
+
+    model->chunksRebuilt = 0;
+
+    if ((model->models == NULL) || (model->windowChunks != stream.windowChunks)) return;
+
+    MazeGrid chunkGrid = LoadMazeGrid(MAZE_STREAM_CHUNK, MAZE_STREAM_CHUNK);
+    if (chunkGrid.cells == NULL) return;
+
+    while (model->chunksRebuilt < maxChunks)
+    {
+        // Get nearest chunk ready and not built
+        int slot = -1;
+        int slotDistance = 0;
+
+        for (int i = 0; i < slotCount; i++)
+        {
+            if (!stream.slotReady[i] || (model->builtVersion[i] == stream.slotVersion[i])) continue;
+
+            int distance = abs(stream.slotChunk[i].x - stream.center.x) + abs(stream.slotChunk[i].y - stream.center.y);
+
+            if ((slot < 0) || (distance < slotDistance))
+            {
+                slot = i;
+                slotDistance = distance;
+            }
+        }
+
+        if (slot < 0) break;
+
+        // Copy chunk cells from window, one word per chunk row
+        int slotX = slot%model->windowChunks;
+        int slotY = slot/model->windowChunks;
+
+        for (int row = 0; row < MAZE_STREAM_CHUNK; row++) GetMazeRow(chunkGrid, row)[0] = GetMazeRow(stream.window, slotY*MAZE_STREAM_CHUNK + row)[slotX];
+
+        for (int i = 0; i < MAZE_STREAM_MODEL_PARTS; i++)
+        {
+            Model *part = &model->models[slot*MAZE_STREAM_MODEL_PARTS + i];
+            Rectangle rec = { (float)((i%2)*partSize), (float)((i/2)*partSize), (float)partSize, (float)partSize };
+
+            UnloadModel(*part);
+            *part = LoadModelFromMesh(GenMeshMaze(chunkGrid, rec));
+
+            if (part->materialCount > 0)
+            {
+                part->materials[0].shader = model->shader;
+                part->materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = model->texture;
+            }
+        }
+
+        model->builtChunk[slot] = stream.slotChunk[slot];
+        model->builtVersion[slot] = stream.slotVersion[slot];
+        model->chunksRebuilt++;
+    }
+
+    UnloadMazeGrid(chunkGrid);
+}
+
+// Set diffuse texture (biome atlas) of all chunks
+void SetMazeStreamModelTexture(MazeStreamModel *model, Texture2D texture)
+{
+    model->texture = texture;
+
+    for (int i = 0; i < model->windowChunks*model->windowChunks*MAZE_STREAM_MODEL_PARTS; i++)
+    {
+        if (model->models[i].materialCount > 0) model->models[i].materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = texture;
+    }
+}
+
+// Draw streamed maze 3D model (chunks in window), must be called inside BeginMode3D()
+// NOTE: Cell (x, y) is centered at world position (x, 0, y), same as MazeModel
+void DrawMazeStreamModel(MazeStreamModel model, MazeStream stream, Color tint)
+{
+    int partSize = MAZE_STREAM_CHUNK/2;
+
+    if ((model.models == NULL) || (model.windowChunks != stream.windowChunks)) return;
+
+    for (int slot = 0; slot < model.windowChunks*model.windowChunks; slot++)
+    {
+        // Chunks not built yet or replaced in window are not drawn
+        if (!stream.slotReady[slot] || (model.builtVersion[slot] != stream.slotVersion[slot])) continue;
+
+        Point chunk = model.builtChunk[slot];
+
+        for (int i = 0; i < MAZE_STREAM_MODEL_PARTS; i++)
+        {
+            Vector3 position = { (float)(chunk.x*MAZE_STREAM_CHUNK + (i%2)*partSize), 0.0f, (float)(chunk.y*MAZE_STREAM_CHUNK + (i/2)*partSize) };
+            DrawModel(model.models[slot*MAZE_STREAM_MODEL_PARTS + i], position, 1.0f, tint);
+        }
+    }
+}
+
+// Load maze 3D preview, texture is resolutionScale times preview size
+// NOTE: updateRate limits redraws per second (0: redraw every frame content changes)
+MazePreview LoadMazePreview(int width, int height, float resolutionScale, float updateRate)
+{
+    MazePreview preview = { 0 };
+
+    preview.width = width;
+    preview.height = height;
+    preview.updateRate = updateRate;
+    preview.dirty = true;
+
+    SetMazePreviewResolution(&preview, resolutionScale);
+
+    return preview;
+}
+
+// Unload maze 3D preview
+void UnloadMazePreview(MazePreview preview)
+{
+    UnloadRenderTexture(preview.target);
+}
+
+// Set preview texture resolution (relative to preview size), texture is reloaded if size changes
+void SetMazePreviewResolution(MazePreview *preview, float resolutionScale)
+{
+    if (resolutionScale <= 0.0f) resolutionScale = 1.0f;
+
+    int width = (int)(preview->width*resolutionScale);
+    int height = (int)(preview->height*resolutionScale);
+
+    if ((width < 1) || (height < 1)) return;
+
+    preview->resolutionScale = resolutionScale;
+
+    if ((preview->target.id > 0) && (preview->target.texture.width == width) && (preview->target.texture.height == height)) return;
+
+    UnloadRenderTexture(preview->target);
+    preview->target = LoadRenderTexture(width, height);
+
+    // Reduced resolution texture is upscaled when drawn
+    if (resolutionScale < 1.0f) SetTextureFilter(preview->target.texture, TEXTURE_FILTER_BILINEAR);
+
+    preview->dirty = true;
+}
+
+// Notify preview content changed (i.e. maze cells edited), redrawn on next update
+void SetMazePreviewDirty(MazePreview *preview)
+{
+    preview->dirty = true;
+}
+
+// Redraw preview if content changed and update rate allows it, returns true if redrawn
+// NOTE: Model swapped, biome texture changed and camera moved are detected, maze edits must be
+// notified with SetMazePreviewDirty(), must be called outside of BeginTextureMode()
+bool UpdateMazePreview(MazePreview *preview, MazeModel model, Vector3 position, Camera3D camera, Color background)
+{
+    unsigned int textureId = 0;
+    if ((model.chunks != NULL) && (model.chunks[0].materialCount > 0)) textureId = model.chunks[0].materials[0].maps[MATERIAL_MAP_DIFFUSE].texture.id;
+
+    if ((model.chunks != preview->chunks) || (textureId != preview->textureId) ||
+        (memcmp(&camera, &preview->camera, sizeof(Camera3D)) != 0)) preview->dirty = true;
+
+    if (!preview->dirty || (preview->target.id == 0)) return false;
+
+    double time = GetElapsedTime();
+    if ((preview->updateRate > 0.0f) && (preview->redraws > 0) && ((time - preview->lastUpdate) < 1.0/preview->updateRate)) return false;
+
+    BeginTextureMode(preview->target);
+        ClearBackground(background);
+        BeginMode3D(camera);
+            DrawMazeModel(model, position, WHITE);
+        EndMode3D();
+    EndTextureMode();
+
+    preview->camera = camera;
+    preview->chunks = model.chunks;
+    preview->textureId = textureId;
+    preview->lastUpdate = time;
+    preview->dirty = false;
+    preview->redraws++;
+
+    return true;
+}
+
+// Draw preview texture (scaled to bounds)
+void DrawMazePreview(MazePreview preview, Rectangle bounds)
+{
+    Texture2D texture = preview.target.texture;
+
+    DrawTexturePro(texture, (Rectangle){ 0, 0, (float)texture.width, (float)-texture.height }, bounds, (Vector2){ 0, 0 }, 0.0f, WHITE);
+}
+
+// Load items renderer (billboard quad and instancing shader)
+// NOTE: Items buckets are allocated on first draw, for the items pool maze size
+MazeItemsRenderer LoadMazeItemsRenderer(void)
+{
+    MazeItemsRenderer renderer = { 0 };
+
+    // Billboard quad (half cell) centered at instance position, texcoords of atlas first frame (item not picked)
+    static const float vertices[12] = { -0.25f, -0.25f, 0.0f, 0.25f, -0.25f, 0.0f, 0.25f, 0.25f, 0.0f, -0.25f, 0.25f, 0.0f };
+    static const float texcoords[8] = { 0.0f, 1.0f, 0.5f, 1.0f, 0.5f, 0.0f, 0.0f, 0.0f };
+    static const unsigned short indices[6] = { 0, 1, 2, 0, 2, 3 };
+
+    renderer.quad.vertexCount = 4;
+    renderer.quad.triangleCount = 2;
+    renderer.quad.vertices = (float *)RL_MALLOC(sizeof(vertices));
+    renderer.quad.texcoords = (float *)RL_MALLOC(sizeof(texcoords));
+    renderer.quad.indices = (unsigned short *)RL_MALLOC(sizeof(indices));
+    memcpy(renderer.quad.vertices, vertices, sizeof(vertices));
+    memcpy(renderer.quad.texcoords, texcoords, sizeof(texcoords));
+    memcpy(renderer.quad.indices, indices, sizeof(indices));
+    UploadMesh(&renderer.quad, false);
+
+    renderer.shader = LoadShaderFromMemory(itemsVertexShader, itemsFragmentShader);
+    renderer.shader.locs[SHADER_LOC_MATRIX_MODEL] = GetShaderLocationAttrib(renderer.shader, "instanceTransform");
+
+    renderer.material = LoadMaterialDefault();
+    renderer.material.shader = renderer.shader;
+
+    return renderer;
+}
+
+// Unload items renderer
+// NOTE: Material maps are freed directly, atlas texture is owned by the user
+void UnloadMazeItemsRenderer(MazeItemsRenderer renderer)
+{
+    UnloadMesh(renderer.quad);
+    UnloadShader(renderer.shader);
+    RL_FREE(renderer.material.maps);
+
+    MAZE_FREE(renderer.chunkStart);
+    MAZE_FREE(renderer.bucket);
+    MAZE_FREE(renderer.transforms);
+}
+
+// Draw items visible by camera, must be called inside BeginMode2D()
+// NOTE: Atlas first frame is drawn for items not picked, second frame for picked items (only if drawPicked),
+// quads share the atlas texture so they are batched in a few draw calls
+void DrawMazeItems2D(MazeItemsRenderer *renderer, MazeItems items, Texture2D atlas, Camera2D camera, float cellSize, bool drawPicked)
+{
+    renderer->itemsDrawn = 0;
+
+    if (!ItemsRendererUpdate(renderer, items)) return;
+
+    // Get visible cells range from screen corners
+    Vector2 viewMin = GetScreenToWorld2D((Vector2){ 0, 0 }, camera);
+    Vector2 viewMax = GetScreenToWorld2D((Vector2){ (float)GetScreenWidth(), (float)GetScreenHeight() }, camera);
+    int firstX = (int)floorf(viewMin.x/cellSize);
+    int firstY = (int)floorf(viewMin.y/cellSize);
+    int lastX = (int)floorf(viewMax.x/cellSize);
+    int lastY = (int)floorf(viewMax.y/cellSize);
+    if (firstX < 0) firstX = 0;
+    if (firstY < 0) firstY = 0;
+    if (lastX >= renderer->width) lastX = renderer->width - 1;
+    if (lastY >= renderer->height) lastY = renderer->height - 1;
+    if ((firstX > lastX) || (firstY > lastY)) return;
+
+    Rectangle frames[2] = {
+        { 0, 0, atlas.width/2.0f, (float)atlas.height },                // Item not picked
+        { atlas.width/2.0f, 0, atlas.width/2.0f, (float)atlas.height }  // Item picked
+    };
+
+    for (int chunkY = firstY/MAZE_ITEMS_CHUNK; chunkY <= lastY/MAZE_ITEMS_CHUNK; chunkY++)
+    {
+        for (int chunkX = firstX/MAZE_ITEMS_CHUNK; chunkX <= lastX/MAZE_ITEMS_CHUNK; chunkX++)
+        {
+            int chunk = chunkY*renderer->chunkCountX + chunkX;
+
+            for (int k = renderer->chunkStart[chunk]; k < renderer->chunkStart[chunk + 1]; k++)
+            {
+                int i = renderer->bucket[k];
+                int x = items.x[i];
+                int y = items.y[i];
+
+                if (items.picked[i] && !drawPicked) continue;
+                if ((x < firstX) || (x > lastX) || (y < firstY) || (y > lastY)) continue;
+
+                DrawTexturePro(atlas, frames[items.picked[i]? 1 : 0], (Rectangle){ x*cellSize, y*cellSize, cellSize, cellSize }, (Vector2){ 0, 0 }, 0.0f, WHITE);
+                renderer->itemsDrawn++;
+            }
+        }
+    }
+}
+
+// Draw not picked items in view distance (instanced), must be called inside BeginMode3D()
+// NOTE: Item of cell (x, y) is drawn at (x, 0.5, y), items farther than view distance or behind
+// the camera are culled (by chunk, then by item), visible items are drawn with a single draw call
+void DrawMazeItems3D(MazeItemsRenderer *renderer, MazeItems items, Texture2D atlas, Camera3D camera, float viewDistance)
+{
+    renderer->itemsDrawn = 0;
+    renderer->drawCalls = 0;
+
+    if ((renderer->shader.id == 0) || !ItemsRendererUpdate(renderer, items)) return;
+
+    // Camera direction on ground plane (no direction culling if camera looks straight down)
+    float forwardX = camera.target.x - camera.position.x;
+    float forwardZ = camera.target.z - camera.position.z;
+    float forwardLength = sqrtf(forwardX*forwardX + forwardZ*forwardZ);
+    if (forwardLength > 0.0f)
+    {
+        forwardX /= forwardLength;
+        forwardZ /= forwardLength;
+    }
+
+    // Chunks range in view distance
+    int firstX = (int)floorf((camera.position.x - viewDistance)/MAZE_ITEMS_CHUNK);
+    int firstY = (int)floorf((camera.position.z - viewDistance)/MAZE_ITEMS_CHUNK);
+    int lastX = (int)floorf((camera.position.x + viewDistance)/MAZE_ITEMS_CHUNK);
+    int lastY = (int)floorf((camera.position.z + viewDistance)/MAZE_ITEMS_CHUNK);
+    if (firstX < 0) firstX = 0;
+    if (firstY < 0) firstY = 0;
+    if (lastX >= renderer->chunkCountX) lastX = renderer->chunkCountX - 1;
+    if (lastY >= renderer->chunkCountY) lastY = renderer->chunkCountY - 1;
+
+    float chunkRadius = MAZE_ITEMS_CHUNK*0.7072f;
+    float chunkDistance = viewDistance + chunkRadius;
+    int count = 0;
+
+    for (int chunkY = firstY; chunkY <= lastY; chunkY++)
+    {
+        for (int chunkX = firstX; chunkX <= lastX; chunkX++)
+        {
+            // Chunk bounding circle culling
+            float dx = (chunkX + 0.5f)*MAZE_ITEMS_CHUNK - 0.5f - camera.position.x;
+            float dz = (chunkY + 0.5f)*MAZE_ITEMS_CHUNK - 0.5f - camera.position.z;
+            if ((dx*dx + dz*dz) > chunkDistance*chunkDistance) continue;
+            if ((dx*forwardX + dz*forwardZ) < -chunkRadius) continue;
+
+            int chunk = chunkY*renderer->chunkCountX + chunkX;
+
+            for (int k = renderer->chunkStart[chunk]; k < renderer->chunkStart[chunk + 1]; k++)
+            {
+                int i = renderer->bucket[k];
+                if (items.picked[i]) continue;
+
+                dx = items.x[i] - camera.position.x;
+                dz = items.y[i] - camera.position.z;
+                if ((dx*dx + dz*dz) > viewDistance*viewDistance) continue;
+                if ((dx*forwardX + dz*forwardZ) < -0.5f) continue;
+
+                if (count >= renderer->transformCapacity)
+                {
+                    int capacity = (renderer->transformCapacity > 0)? renderer->transformCapacity*2 : 1024;
+                    Matrix *transforms = (Matrix *)MAZE_REALLOC(renderer->transforms, (size_t)capacity*sizeof(Matrix));
+                    if (transforms == NULL) break;
+
+                    renderer->transforms = transforms;
+                    renderer->transformCapacity = capacity;
+                }
+
+                renderer->transforms[count++] = (Matrix){ 1.0f, 0.0f, 0.0f, (float)items.x[i], 0.0f, 1.0f, 0.0f, 0.5f, 0.0f, 0.0f, 1.0f, (float)items.y[i], 0.0f, 0.0f, 0.0f, 1.0f };
+            }
+        }
+    }
+
+    if (count == 0) return;
+
+    renderer->material.maps[MATERIAL_MAP_DIFFUSE].texture = atlas;
+    DrawMeshInstanced(renderer->quad, renderer->material, renderer->transforms, count);
+
+    renderer->itemsDrawn = count;
+    renderer->drawCalls = 1;
+}
+
+//----------------------------------------------------------------------------------
+// Module specific Functions Definition
+//----------------------------------------------------------------------------------
+// Get a free cache slot, least recently used chunk is replaced
+// NOTE: Cache always has more slots than visible chunks, so a slot not used this frame exists
+static int RendererGetSlot(MazeRenderer *renderer)
+{
+    int result = 0;
+
+    for (int i = 0; i < renderer->slotCount; i++)
+    {
+        if (renderer->slots[i].chunk < 0) return i;
+        if (renderer->slots[i].lastUsed < renderer->slots[result].lastUsed) result = i;
+    }
+
+    renderer->chunkSlot[renderer->slots[result].chunk] = -1;
+    renderer->slots[result].chunk = -1;
+
+    return result;
+}
+
+// Draw chunk cells into slot render texture
+static void RendererBakeChunk(MazeRenderer *renderer, MazeChunkSlot *slot, MazeGrid grid, Texture2D atlas)
+{
+    int chunkX = slot->chunk%renderer->chunkCountX;
+    int chunkY = slot->chunk/renderer->chunkCountX;
+    int firstX = chunkX*renderer->chunkSize;
+    int firstY = chunkY*renderer->chunkSize;
+    int lastX = (firstX + renderer->chunkSize < grid.width)? firstX + renderer->chunkSize : grid.width;
+    int lastY = (firstY + renderer->chunkSize < grid.height)? firstY + renderer->chunkSize : grid.height;
+
+    Rectangle wallTile = { 0, atlas.height/2.0f, atlas.width/2.0f, atlas.height/2.0f };
+    Rectangle floorTile = { atlas.width/2.0f, atlas.height/2.0f, atlas.width/2.0f, atlas.height/2.0f };
+
+    if (slot->target.id == 0)
+    {
+        int size = (int)(renderer->chunkSize*renderer->cellSize);
+        slot->target = LoadRenderTexture(size, size);
+    }
+
+    slot->atlasId = atlas.id;
+
+    BeginTextureMode(slot->target);
+    ClearBackground(BLANK);
+
+    for (int y = firstY; y < lastY; y++)
+    {
+        for (int x = firstX; x < lastX; x++)
+        {
+            Rectangle dest = { (x - firstX)*renderer->cellSize, (y - firstY)*renderer->cellSize, renderer->cellSize, renderer->cellSize };
+            DrawTexturePro(atlas, IsMazeWall(grid, x, y)? wallTile : floorTile, dest, (Vector2){ 0, 0 }, 0.0f, WHITE);
+        }
+    }
+
+    EndTextureMode();
+}
+
+// Generate chunk model from its grid region
+// NOTE: Chunk mesh is generated in chunk local coordinates, DrawMazeModel() translates it
+static Model ModelGenChunk(MazeModel *model, MazeGrid grid, int chunkX, int chunkY)
+{
+    Rectangle rec = { (float)(chunkX*model->chunkSize), (float)(chunkY*model->chunkSize), (float)model->chunkSize, (float)model->chunkSize };
+
+    return LoadModelFromMesh(GenMeshMaze(grid, rec));
+}
+
+// Sort items in chunk buckets if items changed (added, removed or pool swapped), false if no buckets
+// NOTE: Counting sort by chunk, chunkStart[chunk] to chunkStart[chunk + 1] are the chunk items
+static bool ItemsRendererUpdate(MazeItemsRenderer *renderer, MazeItems items)
+{
+    if ((items.width <= 0) || (items.height <= 0)) return false;
+
+    if ((renderer->chunkStart != NULL) && (items.width == renderer->width) && (items.height == renderer->height) &&
+        (items.x == renderer->itemsX) && (items.count == renderer->itemsCount) && (items.version == renderer->version)) return true;
+
+    if ((renderer->chunkStart == NULL) || (items.width != renderer->width) || (items.height != renderer->height))
+    {
+        renderer->chunkCountX = (items.width + MAZE_ITEMS_CHUNK - 1)/MAZE_ITEMS_CHUNK;
+        renderer->chunkCountY = (items.height + MAZE_ITEMS_CHUNK - 1)/MAZE_ITEMS_CHUNK;
+        renderer->width = items.width;
+        renderer->height = items.height;
+
+        MAZE_FREE(renderer->chunkStart);
+        renderer->chunkStart = (int *)MAZE_MALLOC(((size_t)renderer->chunkCountX*renderer->chunkCountY + 1)*sizeof(int));
+        if (renderer->chunkStart == NULL) return false;
+    }
+
+    if (items.count > renderer->bucketCapacity)
+    {
+        int *bucket = (int *)MAZE_REALLOC(renderer->bucket, (size_t)items.capacity*sizeof(int));
+        if (bucket == NULL) return false;
+
+        renderer->bucket = bucket;
+        renderer->bucketCapacity = items.capacity;
+    }
+
+    int chunkCount = renderer->chunkCountX*renderer->chunkCountY;
+    memset(renderer->chunkStart, 0, ((size_t)chunkCount + 1)*sizeof(int));
+
+    for (int i = 0; i < items.count; i++) renderer->chunkStart[(items.y[i]/MAZE_ITEMS_CHUNK)*renderer->chunkCountX + items.x[i]/MAZE_ITEMS_CHUNK + 1]++;
+    for (int i = 0; i < chunkCount; i++) renderer->chunkStart[i + 1] += renderer->chunkStart[i];
+
+    // Chunks start are used as insert positions, then restored (shifted one chunk)
+    for (int i = 0; i < items.count; i++) renderer->bucket[renderer->chunkStart[(items.y[i]/MAZE_ITEMS_CHUNK)*renderer->chunkCountX + items.x[i]/MAZE_ITEMS_CHUNK]++] = i;
+    for (int i = chunkCount; i > 0; i--) renderer->chunkStart[i] = renderer->chunkStart[i - 1];
+    renderer->chunkStart[0] = 0;
+
+    renderer->itemsX = items.x;
+    renderer->itemsCount = items.count;
+    renderer->version = items.version;
+
+    return true;
+}
+
+#endif // MAZE_IMPLEMENTATION
+
+#endif // MAZE_RENDER_H
@@ -0,0 +1,132 @@
+/*******************************************************************************************
+*
+*   raylib maze generator - headless session replay
+*
+*   Replays a recorded game session (maze_session.mzr, recorded with KEY_V in game) on its
+*   level (maze_session.mzl) with the fixed-step simulation (maze_sim.h), no window, OpenGL
+*   context or audio device is required, the replay outcome (state, points, player position)
+*   is compared against the recorded outcome
+*
+*   USAGE:
+*       maze_replay [options] <level.mzl> <session.mzr>
+*           -n <repeats>    Times the session is replayed (replay speed measure, default: 1)
+*
+*   Exit code: 0 if replay matches the recording, 2 if it does not match, 1 on error
+*
+*   BUILD (Linux):
+*       gcc maze_replay.c -o maze_replay -O2 -lm -lpthread
+*
+********************************************************************************************/
+
+#define MAZE_IMPLEMENTATION
+#include "maze.h"                       // Required for: MazeGrid, GetElapsedTime()
+#include "maze_path.h"                  // Required for: FlowField (maze_items.h)
+#include "maze_stream.h"                // Required for: MazeStream (maze_sim.h)
+#include "maze_items.h"                 // Required for: MazeItems, AddMazeItem()
+#include "maze_file.h"                  // Required for: MazeLevel, LoadMazeLevel()
+#include "maze_sim.h"                   // Required for: MazeSim, MazeSimRecording, ReplayMazeSim()
+
+#include <stdio.h>                      // Required for: printf()
+#include <stdlib.h>                     // Required for: atoi()
+#include <string.h>                     // Required for: strcmp()
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static const char *GetSimStateName(int state);  // Get session state name
+
+//----------------------------------------------------------------------------------
+// Main entry point
+//----------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    const char *levelFileName = NULL;
+    const char *sessionFileName = NULL;
+    int repeats = 1;
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = (i + 1 < argc);
+
+        if ((strcmp(argv[i], "-n") == 0) && hasValue) repeats = atoi(argv[++i]);
+        else if ((argv[i][0] != '-') && (levelFileName == NULL)) levelFileName = argv[i];
+        else if ((argv[i][0] != '-') && (sessionFileName == NULL)) sessionFileName = argv[i];
+        else
+        {
+            printf("USAGE: %s [-n repeats] <level.mzl> <session.mzr>\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if ((levelFileName == NULL) || (sessionFileName == NULL) || (repeats < 1))
+    {
+        printf("USAGE: %s [-n repeats] <level.mzl> <session.mzr>\n", argv[0]);
+        return 1;
+    }
+
+    MazeLevel level = LoadMazeLevel(levelFileName, 0);
+    MazeSimRecording recording = LoadMazeSimRecording(sessionFileName);
+
+    if ((level.grid.cells == NULL) || (recording.inputs == NULL))
+    {
+        printf("ERROR: Failed to load %s\n", (level.grid.cells == NULL)? levelFileName : sessionFileName);
+        UnloadMazeLevel(level);
+        UnloadMazeSimRecording(recording);
+        return 1;
+    }
+
+    MazeItems items = LoadMazeItems(level.grid.width, level.grid.height, level.itemCount);
+    for (int i = 0; i < level.itemCount; i++) AddMazeItem(&items, level.items[i].x, level.items[i].y);
+
+    MazeSim sim = InitMazeSim(level.grid, &items, recording.config);
+
+    if (GetMazeSimLevelHash(sim) != recording.levelHash)
+    {
+        printf("ERROR: Session was not recorded on this level (level hash mismatch)\n");
+        UnloadMazeItems(items);
+        UnloadMazeLevel(level);
+        UnloadMazeSimRecording(recording);
+        return 1;
+    }
+
+    printf("Replaying session: %ix%i maze, %i items, %i steps (%.2f s at %i steps/sec)\n", level.grid.width, level.grid.height,
+        items.count, recording.inputCount, (float)recording.inputCount/MAZE_SIM_RATE, MAZE_SIM_RATE);
+
+    double startTime = GetElapsedTime();
+    long long stepCount = 0;
+
+    for (int i = 0; i < repeats; i++) stepCount += ReplayMazeSim(&sim, recording);
+
+    double elapsed = GetElapsedTime() - startTime;
+    double gameTime = (double)stepCount/MAZE_SIM_RATE;
+
+    printf("Replayed %lld steps in %.3f ms: %.0f steps/sec, %.0fx real time\n", stepCount, elapsed*1000.0,
+        (elapsed > 0.0)? stepCount/elapsed : 0.0, (elapsed > 0.0)? gameTime/elapsed : 0.0);
+
+    bool match = (sim.state == recording.state) && (sim.points == recording.points) && (sim.x == recording.x) && (sim.y == recording.y);
+
+    printf("Recorded: %s, %i points, player (%.4f, %.4f)\n", GetSimStateName(recording.state), recording.points, recording.x, recording.y);
+    printf("Replayed: %s, %i points, player (%.4f, %.4f)\n", GetSimStateName(sim.state), sim.points, sim.x, sim.y);
+    printf("%s\n", match? "Replay matches recording" : "ERROR: Replay does not match recording");
+
+    UnloadMazeItems(items);
+    UnloadMazeLevel(level);
+    UnloadMazeSimRecording(recording);
+
+    return match? 0 : 2;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Get session state name
+static const char *GetSimStateName(int state)
+{
+    switch (state)
+    {
+        case MAZE_SIM_RUNNING: return "running";
+        case MAZE_SIM_WON: return "exit reached";
+        case MAZE_SIM_TIMEOUT: return "time limit reached";
+        default: return "unknown";
+    }
+}
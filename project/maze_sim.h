@@ -0,0 +1,547 @@
+/**********************************************************************************************
+*
+*   maze_sim - Maze gameplay simulation module
+*
+*   Player movement, collisions, items pickup, time limit and exit detection advanced in fixed
+*   steps (MAZE_SIM_RATE steps per second) from an input per step (MazeSimInput), independent of
+*   frame rate and of any window, input or graphics device
+*
+*   The game accumulates frame time and runs as many steps as required, so a session is fully
+*   defined by its start state and the inputs of every step: sessions can be recorded
+*   (MazeSimRecording: start state, level hash, inputs and outcome), exported, and replayed
+*   without a window at thousands of times real time (regression tests, scores verification)
+*
+*   Views: 2D mode moves the player square along the maze axes (cursors/WASD), 3D mode moves
+*   the first-person player on the ground plane (forward/strafe) and rotates the view with the
+*   look input (mouse movement), the view can be switched during a session
+*
+*   Step phases can be timed (MazeSim.profiler, maze_prof.h): movement and collisions, and items
+*   pickup, are added as separate zones samples, one sample per step
+*
+*   NOTE: Replays are deterministic for the same build (same floating point code), positions
+*   are advanced with single precision operations only, time is counted in steps
+*
+*   CONFIGURATION:
+*       #define MAZE_IMPLEMENTATION
+*           Generates the implementation of the module in the including file,
+*           only ONE file of the program should define it
+*
+*   DEPENDENCIES:
+*       maze.h        - MazeGrid, Point, collision checks
+*       maze_items.h  - MazeItems, PickMazeItem()
+*       maze_stream.h - MazeStream collision checks (endless mode)
+*       maze_prof.h   - MazeProfiler, step phases timing
+*
+**********************************************************************************************/
+
+#ifndef MAZE_SIM_H
+#define MAZE_SIM_H
+
+#include "maze.h"                       // Required for: MazeGrid, Point, CheckMazeCollisionBox()
+#include "maze_items.h"                 // Required for: MazeItems, PickMazeItem()
+#include "maze_stream.h"                // Required for: MazeStream, CheckMazeStreamCollisionBox()
+#include "maze_prof.h"                  // Required for: MazeProfiler, BeginMazeProfilerZone()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define MAZE_SIM_RATE           60              // Simulation steps per second
+#define MAZE_SIM_STEP           (1.0f/MAZE_SIM_RATE)    // Simulation step time (seconds)
+#define MAZE_SIM_LOOK_SCALE     0.003f          // 3D view rotation per look unit (radians per mouse pixel)
+#define MAZE_SIM_ITEM_POINTS    50              // Points per item picked
+#define MAZE_SIM_FILE_VERSION   1               // Recording file version, recordings with other versions are not loaded
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Simulation input flags
+typedef enum {
+    MAZE_SIM_INPUT_UP = 1,      // 2D: move up, 3D: move forward
+    MAZE_SIM_INPUT_DOWN = 2,    // 2D: move down, 3D: move backward
+    MAZE_SIM_INPUT_LEFT = 4,    // 2D: move left, 3D: strafe left
+    MAZE_SIM_INPUT_RIGHT = 8,   // 2D: move right, 3D: strafe right
+    MAZE_SIM_INPUT_SWITCH = 16  // Switch view (2D/3D) before moving
+} MazeSimInputFlags;
+
+// Simulation input of one step
+typedef struct MazeSimInput {
+    unsigned char keys;         // Input flags (MazeSimInputFlags)
+    unsigned char reserved;     // Reserved (0)
+    short lookX;                // 3D view horizontal rotation (mouse pixels since previous step)
+    short lookY;                // 3D view vertical rotation (mouse pixels since previous step)
+} MazeSimInput;
+
+// Simulation view
+typedef enum {
+    MAZE_SIM_VIEW_2D = 0,       // Player position is cell corner based (cell center at x + 0.5)
+    MAZE_SIM_VIEW_3D            // Player position is cell center based (cell center at x)
+} MazeSimView;
+
+// Simulation state
+typedef enum {
+    MAZE_SIM_RUNNING = 0,       // Session running
+    MAZE_SIM_WON,               // Exit cell reached
+    MAZE_SIM_TIMEOUT            // Time limit reached
+} MazeSimState;
+
+// Simulation session configuration
+typedef struct MazeSimConfig {
+    int view;                   // Start view (MazeSimView)
+    Point start;                // Start cell
+    Point end;                  // Exit cell
+    float speed;                // Player speed (cells per second)
+    float radius;               // Player collision radius (2D view)
+    int timeLimit;              // Session time limit (seconds, 0: no limit)
+} MazeSimConfig;
+
+// Simulation session
+typedef struct MazeSim {
+    MazeGrid grid;              // Maze grid (not owned)
+    MazeItems *items;           // Maze items (not owned, can be NULL)
+    MazeStream *stream;         // Endless mode world (not owned), if set grid, items and exit are not used
+    MazeSimConfig config;       // Session configuration
+    MazeProfiler *profiler;     // Step phases profiler (not owned, can be NULL)
+    int profCollision;          // Profiler zone: movement and collisions
+    int profItems;              // Profiler zone: items pickup
+
+    int view;                   // Current view (MazeSimView)
+    float x;                    // Player position x
+    float y;                    // Player position y (3D: world z)
+    float previousX;            // Player position x of previous step (render interpolation)
+    float previousY;            // Player position y of previous step
+    float yaw;                  // 3D view rotation around vertical axis (radians, 0: looking to +x)
+    float pitch;                // 3D view vertical rotation (radians)
+    Point cell;                 // Player cell
+    int points;                 // Session points
+    unsigned int tick;          // Steps since session start
+    int state;                  // Session state (MazeSimState)
+} MazeSim;
+
+// Simulation session recording
+typedef struct MazeSimRecording {
+    MazeSimConfig config;       // Session configuration
+    uint64_t levelHash;         // Hash of session level (grid, start/exit cells and items)
+    MazeSimInput *inputs;       // Inputs, one per step
+    int inputCount;             // Inputs recorded
+    int inputCapacity;          // Inputs allocated
+
+    int state;                  // Session outcome: final state (MazeSimState)
+    int points;                 // Session outcome: final points
+    float x;                    // Session outcome: final player position x
+    float y;                    // Session outcome: final player position y
+} MazeSimRecording;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+MazeSim InitMazeSim(MazeGrid grid, MazeItems *items, MazeSimConfig config);    // Init simulation session at start cell (items set as not picked)
+void ResetMazeSim(MazeSim *sim);                                    // Restart session at start cell (items set as not picked)
+void SetMazeSimView(MazeSim *sim, int view);                        // Set session view, player position converted to view coordinates
+void SetMazeSimPosition(MazeSim *sim, float x, float y);            // Set player position (view coordinates), i.e. endless mode start
+int StepMazeSim(MazeSim *sim, MazeSimInput input);                  // Advance session one step, returns session state
+float GetMazeSimTime(MazeSim sim);                                  // Get session time left (seconds), time elapsed if no limit
+uint64_t GetMazeSimLevelHash(MazeSim sim);                          // Get hash of session level (grid, start/exit cells and items)
+
+void BeginMazeSimRecording(MazeSimRecording *recording, MazeSim sim);   // Begin recording session (previous inputs are discarded)
+void AddMazeSimRecordingInput(MazeSimRecording *recording, MazeSimInput input); // Add step input to recording
+void EndMazeSimRecording(MazeSimRecording *recording, MazeSim sim);     // End recording, session outcome is stored
+bool ExportMazeSimRecording(MazeSimRecording recording, const char *fileName);  // Export recording to file
+MazeSimRecording LoadMazeSimRecording(const char *fileName);        // Load recording from file
+void UnloadMazeSimRecording(MazeSimRecording recording);            // Unload recording inputs
+int ReplayMazeSim(MazeSim *sim, MazeSimRecording recording);        // Replay recording inputs from session start, returns steps replayed
+
+#if defined(__cplusplus)
+}
+#endif
+
+/***********************************************************************************
+*
+*   MAZE SIM IMPLEMENTATION
+*
+************************************************************************************/
+#if defined(MAZE_IMPLEMENTATION)
+
+#include <stdio.h>                      // Required for: FILE, fopen(), fwrite(), fread()
+#include <string.h>                     // Required for: memcpy(), memcmp()
+#include <math.h>                       // Required for: sinf(), cosf(), roundf()
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Recording file header, followed by inputs
+typedef struct MazeSimFileHeader {
+    char magic[4];              // "MZRP"
+    uint32_t version;           // MAZE_SIM_FILE_VERSION
+    uint32_t rate;              // Simulation steps per second (MAZE_SIM_RATE)
+    int32_t view;               // Start view
+    int32_t startX;             // Start cell x
+    int32_t startY;             // Start cell y
+    int32_t endX;               // Exit cell x
+    int32_t endY;               // Exit cell y
+    float speed;                // Player speed
+    float radius;               // Player collision radius
+    int32_t timeLimit;          // Session time limit (seconds)
+    uint32_t inputCount;        // Inputs following header
+    uint64_t levelHash;         // Session level hash
+    int32_t state;              // Outcome: final state
+    int32_t points;             // Outcome: final points
+    float x;                    // Outcome: final player position x
+    float y;                    // Outcome: final player position y
+} MazeSimFileHeader;
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static bool SimCheckBox(MazeSim *sim, float x, float y, int dirX, int dirY);   // Check 2D view collision (grid or stream)
+static bool SimCheckStep(MazeSim *sim, float x, float y, float dx, float dy);  // Check 3D view collision (grid or stream)
+static void SimUpdateCell(MazeSim *sim);                            // Update player cell from position (view coordinates)
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Init simulation session at start cell (items set as not picked)
+MazeSim InitMazeSim(MazeGrid grid, MazeItems *items, MazeSimConfig config)
+{
+    MazeSim sim = { 0 };
+
+    sim.grid = grid;
+    sim.items = items;
+    sim.config = config;
+
+    ResetMazeSim(&sim);
+
+    return sim;
+}
+
+// Restart session at start cell (items set as not picked)
+void ResetMazeSim(MazeSim *sim)
+{
+    sim->view = sim->config.view;
+    sim->x = sim->config.start.x + ((sim->view == MAZE_SIM_VIEW_2D)? 0.5f : 0.0f);
+    sim->y = sim->config.start.y + ((sim->view == MAZE_SIM_VIEW_2D)? 0.5f : 0.0f);
+    sim->previousX = sim->x;
+    sim->previousY = sim->y;
+    sim->yaw = 0.0f;
+    sim->pitch = 0.0f;
+    sim->cell = sim->config.start;
+    sim->points = 0;
+    sim->tick = 0;
+    sim->state = MAZE_SIM_RUNNING;
+
+    if (sim->items != NULL) ResetMazeItems(sim->items);
+}
+
+// Set session view, player position converted to view coordinates
+// NOTE: Player is placed at its cell center, as the game did when switching modes
+void SetMazeSimView(MazeSim *sim, int view)
+{
+    if (view == sim->view) return;
+
+    sim->view = view;
+    sim->x = sim->cell.x + ((view == MAZE_SIM_VIEW_2D)? 0.5f : 0.0f);
+    sim->y = sim->cell.y + ((view == MAZE_SIM_VIEW_2D)? 0.5f : 0.0f);
+    sim->previousX = sim->x;
+    sim->previousY = sim->y;
+}
+
+// Set player position (view coordinates), i.e. endless mode start
+void SetMazeSimPosition(MazeSim *sim, float x, float y)
+{
+    sim->x = x;
+    sim->y = y;
+    sim->previousX = x;
+    sim->previousY = y;
+    SimUpdateCell(sim);
+}
+
+// Advance session one step, returns session state
+// NOTE: Step order: view switch, movement and collisions, items pickup, exit, time limit
+int StepMazeSim(MazeSim *sim, MazeSimInput input)
+{
+    if (sim->state != MAZE_SIM_RUNNING) return sim->state;
+
+    if (input.keys & MAZE_SIM_INPUT_SWITCH) SetMazeSimView(sim, (sim->view == MAZE_SIM_VIEW_2D)? MAZE_SIM_VIEW_3D : MAZE_SIM_VIEW_2D);
+
+    sim->previousX = sim->x;
+    sim->previousY = sim->y;
+
+    float change = sim->config.speed*MAZE_SIM_STEP;
+
+    if (sim->profiler != NULL) BeginMazeProfilerZone(sim->profiler, sim->profCollision);
+
+    if (sim->view == MAZE_SIM_VIEW_2D)
+    {
+        // Every axis key moves the player square, colliding side is snapped to 0.1 cells
+        static const int direction[4][2] = { { 0, -1 }, { 0, 1 }, { -1, 0 }, { 1, 0 } };    // Up, Down, Left, Right
+
+        for (int i = 0; i < 4; i++)
+        {
+            if (!(input.keys & (1 << i))) continue;
+
+            float newX = sim->x + change*direction[i][0];
+            float newY = sim->y + change*direction[i][1];
+
+            if (SimCheckBox(sim, newX, newY, direction[i][0], direction[i][1]))
+            {
+                if (direction[i][0] != 0) newX = roundf(sim->x*10)/10;
+                else newY = roundf(sim->y*10)/10;
+            }
+
+            sim->x = newX;
+            sim->y = newY;
+        }
+    }
+    else
+    {
+        // Look input rotates the view, movement is on the ground plane (forward and strafe)
+        sim->yaw += input.lookX*MAZE_SIM_LOOK_SCALE;
+        sim->pitch -= input.lookY*MAZE_SIM_LOOK_SCALE;
+        if (sim->pitch > 1.45f) sim->pitch = 1.45f;
+        if (sim->pitch < -1.45f) sim->pitch = -1.45f;
+
+        float forward = (float)(((input.keys & MAZE_SIM_INPUT_UP)? 1 : 0) - ((input.keys & MAZE_SIM_INPUT_DOWN)? 1 : 0));
+        float strafe = (float)(((input.keys & MAZE_SIM_INPUT_RIGHT)? 1 : 0) - ((input.keys & MAZE_SIM_INPUT_LEFT)? 1 : 0));
+
+        if ((forward != 0.0f) || (strafe != 0.0f))
+        {
+            // View direction is (cos(yaw), sin(yaw)), right direction is (-sin(yaw), cos(yaw))
+            float directionX = cosf(sim->yaw);
+            float directionY = sinf(sim->yaw);
+            float dx = (forward*directionX - strafe*directionY)*change;
+            float dy = (forward*directionY + strafe*directionX)*change;
+
+            // Colliding steps are discarded (player does not move)
+            if (!SimCheckStep(sim, sim->x + dx, sim->y + dy, dx, dy))
+            {
+                sim->x += dx;
+                sim->y += dy;
+            }
+        }
+    }
+
+    SimUpdateCell(sim);
+
+    if (sim->profiler != NULL) EndMazeProfilerZone(sim->profiler, sim->profCollision);
+
+    if (sim->stream == NULL)
+    {
+        if (sim->profiler != NULL) BeginMazeProfilerZone(sim->profiler, sim->profItems);
+        if ((sim->items != NULL) && PickMazeItem(sim->items, sim->cell.x, sim->cell.y)) sim->points += MAZE_SIM_ITEM_POINTS;
+        if (sim->profiler != NULL) EndMazeProfilerZone(sim->profiler, sim->profItems);
+        if ((sim->cell.x == sim->config.end.x) && (sim->cell.y == sim->config.end.y)) sim->state = MAZE_SIM_WON;
+    }
+
+    sim->tick++;
+
+    if ((sim->state == MAZE_SIM_RUNNING) && (sim->config.timeLimit > 0) &&
+        (sim->tick >= (unsigned int)sim->config.timeLimit*MAZE_SIM_RATE)) sim->state = MAZE_SIM_TIMEOUT;
+
+    return sim->state;
+}
+
+// Get session time left (seconds), time elapsed if no limit
+float GetMazeSimTime(MazeSim sim)
+{
+    float elapsed = (float)sim.tick/MAZE_SIM_RATE;
+
+    return (sim.config.timeLimit > 0)? sim.config.timeLimit - elapsed : elapsed;
+}
+
+// Get hash of session level (grid, start/exit cells and items)
+// NOTE: 64 bit FNV-1a over grid words, items cells and start/exit cells
+uint64_t GetMazeSimLevelHash(MazeSim sim)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+
+    #define SIM_HASH(value) hash = (hash ^ (uint64_t)(value))*0x100000001b3ull
+
+    SIM_HASH(sim.grid.width);
+    SIM_HASH(sim.grid.height);
+    for (int y = 0; y < sim.grid.height; y++)
+    {
+        const uint64_t *row = GetMazeRow(sim.grid, y);
+        for (int k = 0; k < sim.grid.stride; k++) SIM_HASH(row[k]);
+    }
+
+    SIM_HASH(sim.config.start.x);
+    SIM_HASH(sim.config.start.y);
+    SIM_HASH(sim.config.end.x);
+    SIM_HASH(sim.config.end.y);
+
+    // Items order does not change the hash (items cells are xored)
+    uint64_t items = 0;
+    if (sim.items != NULL)
+    {
+        for (int i = 0; i < sim.items->count; i++) items ^= ((uint64_t)sim.items->y[i]*sim.grid.width + sim.items->x[i] + 1)*0x9e3779b97f4a7c15ull;
+        SIM_HASH(sim.items->count);
+    }
+    SIM_HASH(items);
+
+    #undef SIM_HASH
+
+    return hash;
+}
+
+// Begin recording session (previous inputs are discarded)
+void BeginMazeSimRecording(MazeSimRecording *recording, MazeSim sim)
+{
+    recording->config = sim.config;
+    recording->levelHash = GetMazeSimLevelHash(sim);
+    recording->inputCount = 0;
+    recording->state = MAZE_SIM_RUNNING;
+    recording->points = 0;
+    recording->x = sim.x;
+    recording->y = sim.y;
+}
+
+// Add step input to recording
+void AddMazeSimRecordingInput(MazeSimRecording *recording, MazeSimInput input)
+{
+    if (recording->inputCount >= recording->inputCapacity)
+    {
+        int capacity = (recording->inputCapacity > 0)? recording->inputCapacity*2 : 4096;
+        MazeSimInput *inputs = (MazeSimInput *)MAZE_REALLOC(recording->inputs, (size_t)capacity*sizeof(MazeSimInput));
+        if (inputs == NULL) return;
+
+        recording->inputs = inputs;
+        recording->inputCapacity = capacity;
+    }
+
+    recording->inputs[recording->inputCount++] = input;
+}
+
+// End recording, session outcome is stored
+void EndMazeSimRecording(MazeSimRecording *recording, MazeSim sim)
+{
+    recording->state = sim.state;
+    recording->points = sim.points;
+    recording->x = sim.x;
+    recording->y = sim.y;
+}
+
+// Export recording to file
+bool ExportMazeSimRecording(MazeSimRecording recording, const char *fileName)
+{
+    MazeSimFileHeader header = { 0 };
+    memcpy(header.magic, "MZRP", 4);
+    header.version = MAZE_SIM_FILE_VERSION;
+    header.rate = MAZE_SIM_RATE;
+    header.view = recording.config.view;
+    header.startX = recording.config.start.x;
+    header.startY = recording.config.start.y;
+    header.endX = recording.config.end.x;
+    header.endY = recording.config.end.y;
+    header.speed = recording.config.speed;
+    header.radius = recording.config.radius;
+    header.timeLimit = recording.config.timeLimit;
+    header.inputCount = (uint32_t)recording.inputCount;
+    header.levelHash = recording.levelHash;
+    header.state = recording.state;
+    header.points = recording.points;
+    header.x = recording.x;
+    header.y = recording.y;
+
+    FILE *file = fopen(fileName, "wb");
+    if (file == NULL) return false;
+
+    bool success = (fwrite(&header, sizeof(MazeSimFileHeader), 1, file) == 1) &&
+                   ((recording.inputCount == 0) || (fwrite(recording.inputs, sizeof(MazeSimInput), recording.inputCount, file) == (size_t)recording.inputCount));
+
+    if (fclose(file) != 0) success = false;
+    if (!success) remove(fileName);
+
+    return success;
+}
+
+// Load recording from file
+// NOTE: Recordings of another version or simulation rate are not loaded (inputCount is 0)
+MazeSimRecording LoadMazeSimRecording(const char *fileName)
+{
+    MazeSimRecording recording = { 0 };
+    MazeSimFileHeader header = { 0 };
+
+    FILE *file = fopen(fileName, "rb");
+    if (file == NULL) return recording;
+
+    if ((fread(&header, sizeof(MazeSimFileHeader), 1, file) == 1) && (memcmp(header.magic, "MZRP", 4) == 0) &&
+        (header.version == MAZE_SIM_FILE_VERSION) && (header.rate == MAZE_SIM_RATE) && (header.inputCount <= 0x7fffffff))
+    {
+        recording.inputs = (MazeSimInput *)MAZE_MALLOC(((size_t)header.inputCount + 1)*sizeof(MazeSimInput));
+
+        if ((recording.inputs != NULL) && (fread(recording.inputs, sizeof(MazeSimInput), header.inputCount, file) == header.inputCount))
+        {
+            recording.config = (MazeSimConfig){ header.view, { header.startX, header.startY }, { header.endX, header.endY }, header.speed, header.radius, header.timeLimit };
+            recording.levelHash = header.levelHash;
+            recording.inputCount = (int)header.inputCount;
+            recording.inputCapacity = (int)header.inputCount + 1;
+            recording.state = header.state;
+            recording.points = header.points;
+            recording.x = header.x;
+            recording.y = header.y;
+        }
+        else
+        {
+            MAZE_FREE(recording.inputs);
+            recording.inputs = NULL;
+        }
+    }
+
+    fclose(file);
+
+    return recording;
+}
+
+// Unload recording inputs
+void UnloadMazeSimRecording(MazeSimRecording recording)
+{
+    MAZE_FREE(recording.inputs);
+}
+
+// Replay recording inputs from session start, returns steps replayed
+// NOTE: Session configuration is taken from recording, replay stops when session ends
+int ReplayMazeSim(MazeSim *sim, MazeSimRecording recording)
+{
+    sim->config = recording.config;
+    ResetMazeSim(sim);
+
+    int steps = 0;
+
+    while ((steps < recording.inputCount) && (sim->state == MAZE_SIM_RUNNING)) StepMazeSim(sim, recording.inputs[steps++]);
+
+    return steps;
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+// Check 2D view collision (grid or stream)
+static bool SimCheckBox(MazeSim *sim, float x, float y, int dirX, int dirY)
+{
+    if (sim->stream != NULL) return CheckMazeStreamCollisionBox(*sim->stream, x, y, sim->config.radius, dirX, dirY);
+
+    return CheckMazeCollisionBox(sim->grid, x, y, sim->config.radius, dirX, dirY);
+}
+
+// Check 3D view collision (grid or stream)
+static bool SimCheckStep(MazeSim *sim, float x, float y, float dx, float dy)
+{
+    if (sim->stream != NULL) return CheckMazeStreamCollisionStep(*sim->stream, x, y, dx, dy);
+
+    return CheckMazeCollisionStep(sim->grid, x, y, dx, dy);
+}
+
+// Update player cell from position (view coordinates)
+static void SimUpdateCell(MazeSim *sim)
+{
+    float offset = (sim->view == MAZE_SIM_VIEW_2D)? 0.5f : 0.0f;
+
+    sim->cell = (Point){ (int)roundf(sim->x - offset), (int)roundf(sim->y - offset) };
+}
+
+#endif // MAZE_IMPLEMENTATION
+
+#endif // MAZE_SIM_H
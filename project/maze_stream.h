@@ -0,0 +1,466 @@
+/**********************************************************************************************
+*
+*   maze_stream - Endless streaming maze module
+*
+*   Endless maze world generated on demand around a center cell (i.e. player cell): the world
+*   is split in chunks of MAZE_STREAM_CHUNK x MAZE_STREAM_CHUNK cells and only a square window
+*   of chunks around the center is kept in memory, chunks leaving the window are replaced by
+*   the chunks entering it, so memory and per-frame cost do not depend on distance travelled
+*
+*   Every chunk only depends on the seed and its chunk coordinates: chunk cells are a perfect
+*   maze (Eller) generated from a coordinate-hashed seed, chunk west and north borders are walls
+*   with coordinate-hashed doors, connecting with the rooms of the neighbour chunks. Every chunk
+*   is connected inside and with its 4 neighbours, so the whole world is connected
+*
+*   Chunks are generated by a worker thread ahead of the center (nearest chunks first), the
+*   calling thread only copies generated chunks into the window (UpdateMazeStream()), so chunk
+*   generation never stalls a frame. Cells of chunks not generated yet are considered walls
+*
+*   CONFIGURATION:
+*       #define MAZE_IMPLEMENTATION
+*           Generates the implementation of the module in the including file,
+*           only ONE file of the program should define it
+*
+*       #define MAZE_NO_THREADS
+*           Disables worker thread (C11 threads.h), chunks are generated by UpdateMazeStream()
+*
+*   DEPENDENCIES:
+*       maze.h      - MazeGrid, Point, GetMazeRandom(), memory allocators
+*       maze_gen.h  - GenMazeEller()
+*       threads.h   - Chunks worker thread (C11), not required if MAZE_NO_THREADS is defined
+*
+**********************************************************************************************/
+
+#ifndef MAZE_STREAM_H
+#define MAZE_STREAM_H
+
+#include "maze.h"                       // Required for: MazeGrid, Point, GetMazeRandom()
+#include "maze_gen.h"                   // Required for: GenMazeEller()
+
+// Stream chunk size (cells)
+// NOTE: Chunk rows are exactly one grid word, chunks never share words in the window grid
+#define MAZE_STREAM_CHUNK   64
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Streamed maze world, window of chunks around a center cell
+// NOTE: Chunk (x, y) is stored in window slot (x mod windowChunks, y mod windowChunks)
+typedef struct MazeStream {
+    unsigned int seed;          // World seed
+    int windowChunks;           // Window size (chunks per side)
+    MazeGrid window;            // Window cells, windowChunks*MAZE_STREAM_CHUNK cells per side
+    Point *slotChunk;           // Chunk coordinates requested per slot
+    bool *slotReady;            // Slot cells are generated (requested chunk)
+    unsigned int *slotVersion;  // Slot chunk version, incremented every time a chunk is ready (caches)
+    Point center;               // Window center chunk
+    int chunksReady;            // Chunks copied into window by last update
+    struct MazeStreamWorker *worker;    // Chunks generation (internal)
+} MazeStream;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+MazeStream LoadMazeStream(unsigned int seed, int windowChunks);    // Load streamed maze world, window of windowChunks x windowChunks chunks
+void UnloadMazeStream(MazeStream stream);                           // Unload streamed maze world (stops worker)
+int UpdateMazeStream(MazeStream *stream, Point center);             // Request chunks around center cell, copy generated chunks, returns chunks copied
+bool IsMazeStreamWall(MazeStream stream, int x, int y);            // Check if world cell is a wall, cells of chunks not ready are walls
+bool IsMazeStreamChunkReady(MazeStream stream, int chunkX, int chunkY);     // Check if chunk cells are in the window
+bool CheckMazeStreamCollisionBox(MazeStream stream, float x, float y, float radius, int dirX, int dirY);  // Check collision of a square moving along one axis (2D movement)
+bool CheckMazeStreamCollisionStep(MazeStream stream, float x, float y, float dx, float dy);               // Check collision of a point moving (3D movement)
+
+// Generate chunk cells (world seed and chunk coordinates), one word per chunk row
+void GenMazeStreamChunk(unsigned int seed, int chunkX, int chunkY, uint64_t *cells);
+
+// Get chunk coordinate containing a cell coordinate (rounds towards negative infinity)
+static inline int GetMazeStreamChunk(int cell)
+{
+    return (cell >= 0)? cell/MAZE_STREAM_CHUNK : (cell + 1)/MAZE_STREAM_CHUNK - 1;
+}
+
+#if defined(__cplusplus)
+}
+#endif
+
+/***********************************************************************************
+*
+*   MAZE STREAM IMPLEMENTATION
+*
+************************************************************************************/
+#if defined(MAZE_IMPLEMENTATION)
+
+#include <stdlib.h>                     // Required for: abs()
+#include <limits.h>                     // Required for: INT_MIN
+
+#if !defined(MAZE_NO_THREADS)
+    #include <threads.h>                // Required for: thrd_create(), mtx_t, cnd_t
+#endif
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Generated chunk, waiting to be copied into the window
+typedef struct MazeStreamResult {
+    int slot;                   // Window slot
+    Point chunk;                // Chunk coordinates
+    uint64_t cells[MAZE_STREAM_CHUNK];  // Chunk cells, one word per row
+} MazeStreamResult;
+
+// Chunks generation state, shared with worker thread
+// NOTE: Worker only writes results, window is only written by the calling thread
+typedef struct MazeStreamWorker {
+    unsigned int seed;          // World seed
+    int windowChunks;           // Window size (chunks per side)
+    Point *requests;            // Chunk requested per slot
+    bool *pending;              // Slot request not taken by worker yet
+    Point center;               // Window center chunk, nearest chunks are generated first
+    MazeStreamResult *results;  // Generated chunks
+    int resultCount;            // Generated chunks not copied yet
+    int resultCapacity;         // Generated chunks capacity (worker waits if full)
+#if !defined(MAZE_NO_THREADS)
+    mtx_t mutex;                // Worker state lock
+    cnd_t wake;                 // Worker wake up (new requests or results copied)
+    thrd_t thread;              // Worker thread
+    bool running;               // Worker thread started
+    bool quit;                  // Worker must finish
+#endif
+} MazeStreamWorker;
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static int StreamNextRequest(MazeStreamWorker *worker);             // Get nearest pending slot to center, -1 if none
+#if !defined(MAZE_NO_THREADS)
+static int StreamWorker(void *arg);                                 // Worker thread: generate requested chunks until quit
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Load streamed maze world, window of windowChunks x windowChunks chunks
+// NOTE: No chunk is requested until first UpdateMazeStream()
+MazeStream LoadMazeStream(unsigned int seed, int windowChunks)
+{
+    MazeStream stream = { 0 };
+
+    if (windowChunks <= 0) return stream;
+
+    int slotCount = windowChunks*windowChunks;
+
+    stream.seed = seed;
+    stream.windowChunks = windowChunks;
+    stream.window = LoadMazeGrid(windowChunks*MAZE_STREAM_CHUNK, windowChunks*MAZE_STREAM_CHUNK);
+    stream.slotChunk = (Point *)MAZE_MALLOC(slotCount*sizeof(Point));
+    stream.slotReady = (bool *)MAZE_CALLOC(slotCount, sizeof(bool));
+    stream.slotVersion = (unsigned int *)MAZE_CALLOC(slotCount, sizeof(unsigned int));
+    stream.center = (Point){ INT_MIN, INT_MIN };
+    stream.worker = (MazeStreamWorker *)MAZE_CALLOC(1, sizeof(MazeStreamWorker));
+
+    MazeStreamWorker *worker = stream.worker;
+
+    if (worker != NULL)
+    {
+        worker->seed = seed;
+        worker->windowChunks = windowChunks;
+        worker->requests = (Point *)MAZE_MALLOC(slotCount*sizeof(Point));
+        worker->pending = (bool *)MAZE_CALLOC(slotCount, sizeof(bool));
+        worker->resultCapacity = slotCount;
+        worker->results = (MazeStreamResult *)MAZE_MALLOC(slotCount*sizeof(MazeStreamResult));
+    }
+
+    if ((stream.window.cells == NULL) || (stream.slotChunk == NULL) || (stream.slotReady == NULL) || (stream.slotVersion == NULL) ||
+        (worker == NULL) || (worker->requests == NULL) || (worker->pending == NULL) || (worker->results == NULL))
+    {
+        UnloadMazeStream(stream);
+        return (MazeStream){ 0 };
+    }
+
+    for (int i = 0; i < slotCount; i++) stream.slotChunk[i] = (Point){ INT_MIN, INT_MIN };
+
+#if !defined(MAZE_NO_THREADS)
+    // Chunks are generated by UpdateMazeStream() if worker thread can not be started
+    if (mtx_init(&worker->mutex, mtx_plain) == thrd_success)
+    {
+        if (cnd_init(&worker->wake) == thrd_success)
+        {
+            if (thrd_create(&worker->thread, StreamWorker, worker) == thrd_success) worker->running = true;
+            else cnd_destroy(&worker->wake);
+        }
+
+        if (!worker->running) mtx_destroy(&worker->mutex);
+    }
+#endif
+
+    return stream;
+}
+
+// Unload streamed maze world (stops worker)
+void UnloadMazeStream(MazeStream stream)
+{
+    MazeStreamWorker *worker = stream.worker;
+
+    if (worker != NULL)
+    {
+#if !defined(MAZE_NO_THREADS)
+        if (worker->running)
+        {
+            mtx_lock(&worker->mutex);
+            worker->quit = true;
+            cnd_signal(&worker->wake);
+            mtx_unlock(&worker->mutex);
+
+            thrd_join(worker->thread, NULL);
+            cnd_destroy(&worker->wake);
+            mtx_destroy(&worker->mutex);
+        }
+#endif
+        MAZE_FREE(worker->requests);
+        MAZE_FREE(worker->pending);
+        MAZE_FREE(worker->results);
+        MAZE_FREE(worker);
+    }
+
+    UnloadMazeGrid(stream.window);
+    MAZE_FREE(stream.slotChunk);
+    MAZE_FREE(stream.slotReady);
+    MAZE_FREE(stream.slotVersion);
+}
+
+// Request chunks around center cell, copy generated chunks, returns chunks copied
+// NOTE: Window is only changed by this function, cells can be read safely at any other time
+int UpdateMazeStream(MazeStream *stream, Point center)
+{
+    MazeStreamWorker *worker = stream->worker;
+    Point centerChunk = { GetMazeStreamChunk(center.x), GetMazeStreamChunk(center.y) };
+    int count = stream->windowChunks;
+
+    stream->chunksReady = 0;
+    if (worker == NULL) return 0;
+
+#if !defined(MAZE_NO_THREADS)
+    if (worker->running) mtx_lock(&worker->mutex);
+#endif
+
+    // Center chunk changed: window slots whose chunk left the window get the entering chunk
+    if ((centerChunk.x != stream->center.x) || (centerChunk.y != stream->center.y))
+    {
+        stream->center = centerChunk;
+        worker->center = centerChunk;
+
+        for (int y = centerChunk.y - count/2; y < (centerChunk.y - count/2 + count); y++)
+        {
+            for (int x = centerChunk.x - count/2; x < (centerChunk.x - count/2 + count); x++)
+            {
+                int slot = (((y%count) + count)%count)*count + (((x%count) + count)%count);
+
+                if ((stream->slotChunk[slot].x != x) || (stream->slotChunk[slot].y != y))
+                {
+                    stream->slotChunk[slot] = (Point){ x, y };
+                    stream->slotReady[slot] = false;
+                    worker->requests[slot] = (Point){ x, y };
+                    worker->pending[slot] = true;
+                }
+            }
+        }
+    }
+
+#if !defined(MAZE_NO_THREADS)
+    if (!worker->running)
+#endif
+    {
+        // No worker thread, requested chunks are generated now
+        for (int slot = StreamNextRequest(worker); (slot >= 0) && (worker->resultCount < worker->resultCapacity); slot = StreamNextRequest(worker))
+        {
+            MazeStreamResult *result = &worker->results[worker->resultCount++];
+            worker->pending[slot] = false;
+            result->slot = slot;
+            result->chunk = worker->requests[slot];
+            GenMazeStreamChunk(worker->seed, result->chunk.x, result->chunk.y, result->cells);
+        }
+    }
+
+    // Copy generated chunks into window, chunks no longer requested are discarded
+    for (int i = 0; i < worker->resultCount; i++)
+    {
+        MazeStreamResult *result = &worker->results[i];
+        int slot = result->slot;
+
+        if (stream->slotReady[slot] || (stream->slotChunk[slot].x != result->chunk.x) || (stream->slotChunk[slot].y != result->chunk.y)) continue;
+
+        int slotX = slot%count;
+        int slotY = slot/count;
+
+        for (int row = 0; row < MAZE_STREAM_CHUNK; row++) GetMazeRow(stream->window, slotY*MAZE_STREAM_CHUNK + row)[slotX] = result->cells[row];
+
+        stream->slotReady[slot] = true;
+        stream->slotVersion[slot]++;
+        stream->chunksReady++;
+    }
+
+    worker->resultCount = 0;
+
+#if !defined(MAZE_NO_THREADS)
+    if (worker->running)
+    {
+        cnd_signal(&worker->wake);
+        mtx_unlock(&worker->mutex);
+    }
+#endif
+
+    return stream->chunksReady;
+}
+
+// Check if world cell is a wall, cells of chunks not ready are walls
+bool IsMazeStreamWall(MazeStream stream, int x, int y)
+{
+    int chunkX = GetMazeStreamChunk(x);
+    int chunkY = GetMazeStreamChunk(y);
+
+    if (!IsMazeStreamChunkReady(stream, chunkX, chunkY)) return true;
+
+    int count = stream.windowChunks;
+    int slotX = ((chunkX%count) + count)%count;
+    int slotY = ((chunkY%count) + count)%count;
+
+    return IsMazeWall(stream.window, slotX*MAZE_STREAM_CHUNK + (x - chunkX*MAZE_STREAM_CHUNK), slotY*MAZE_STREAM_CHUNK + (y - chunkY*MAZE_STREAM_CHUNK));
+}
+
+// Check if chunk cells are in the window
+bool IsMazeStreamChunkReady(MazeStream stream, int chunkX, int chunkY)
+{
+    if (stream.slotChunk == NULL) return false;
+
+    int count = stream.windowChunks;
+    int slot = (((chunkY%count) + count)%count)*count + (((chunkX%count) + count)%count);
+
+    return stream.slotReady[slot] && (stream.slotChunk[slot].x == chunkX) && (stream.slotChunk[slot].y == chunkY);
+}
+
+// Check collision of a square moving along one axis (2D movement), cells of chunks not ready are walls
+bool CheckMazeStreamCollisionBox(MazeStream stream, float x, float y, float radius, int dirX, int dirY)
+{
+    Point cells[2];
+    GetMazeBoxCells(x, y, radius, dirX, dirY, cells);
+
+    return IsMazeStreamWall(stream, cells[0].x, cells[0].y) || IsMazeStreamWall(stream, cells[1].x, cells[1].y);
+}
+
+// Check collision of a point moving (3D movement), cells of chunks not ready are walls
+bool CheckMazeStreamCollisionStep(MazeStream stream, float x, float y, float dx, float dy)
+{
+    Point cells[2];
+    GetMazeStepCells(x, y, dx, dy, cells);
+
+    return IsMazeStreamWall(stream, cells[0].x, cells[0].y) || IsMazeStreamWall(stream, cells[1].x, cells[1].y);
+}
+
+// Generate chunk cells (world seed and chunk coordinates), one word per chunk row
+// NOTE: Chunk rooms are on odd local cells, local row/column 0 are walls with doors on rooms rows/columns,
+// rooms of last local row/column connect with the doors of the south/east neighbour chunks
+void GenMazeStreamChunk(unsigned int seed, int chunkX, int chunkY, uint64_t *cells)
+{
+    unsigned int chunkSeed = GetMazeRandom(seed, chunkX, chunkY, MAZE_RANDOM_CHUNK);
+
+    // Chunk maze is generated with one extra row/column (next chunk border)
+    MazeGrid grid = LoadMazeGrid(MAZE_STREAM_CHUNK + 1, MAZE_STREAM_CHUNK + 1);
+
+    if ((grid.cells == NULL) || !GenMazeEller(&grid, chunkSeed))
+    {
+        // Out of memory: chunk rows are corridors connected by column 1, still connected to doors
+        for (int row = 0; row < MAZE_STREAM_CHUNK; row++) cells[row] = (row == 0)? ~0ull : (row & 1)? 1ull : ~2ull;
+    }
+    else
+    {
+        for (int row = 0; row < MAZE_STREAM_CHUNK; row++) cells[row] = GetMazeRow(grid, row)[0];
+    }
+
+    UnloadMazeGrid(grid);
+
+    // West and north border doors, at least one per border
+    int roomCount = MAZE_STREAM_CHUNK/2;
+
+    for (int side = 0; side < 2; side++)
+    {
+        int forcedDoor = (int)(GetMazeRandom(chunkSeed, -1, side, MAZE_RANDOM_DOOR)%(unsigned int)roomCount);
+
+        for (int i = 0; i < roomCount; i++)
+        {
+            if ((i != forcedDoor) && ((GetMazeRandom(chunkSeed, i, side, MAZE_RANDOM_DOOR)%8) != 0)) continue;
+
+            if (side == 0) cells[2*i + 1] &= ~1ull;                 // West door at row 2*i + 1
+            else cells[0] &= ~(1ull << (2*i + 1));                  // North door at column 2*i + 1
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+// Get nearest pending slot to center, -1 if none
+static int StreamNextRequest(MazeStreamWorker *worker)
+{
+    int slotCount = worker->windowChunks*worker->windowChunks;
+    int result = -1;
+    int resultDistance = 0;
+
+    for (int i = 0; i < slotCount; i++)
+    {
+        if (!worker->pending[i]) continue;
+
+        int distance = abs(worker->requests[i].x - worker->center.x) + abs(worker->requests[i].y - worker->center.y);
+
+        if ((result < 0) || (distance < resultDistance))
+        {
+            result = i;
+            resultDistance = distance;
+        }
+    }
+
+    return result;
+}
+
+#if !defined(MAZE_NO_THREADS)
+// Worker thread: generate requested chunks until quit
+// NOTE: Chunk is generated unlocked, calling thread can request other chunks meanwhile
+static int StreamWorker(void *arg)
+{
+    MazeStreamWorker *worker = (MazeStreamWorker *)arg;
+    MazeStreamResult result = { 0 };
+
+    mtx_lock(&worker->mutex);
+
+    while (!worker->quit)
+    {
+        int slot = (worker->resultCount < worker->resultCapacity)? StreamNextRequest(worker) : -1;
+
+        if (slot < 0)
+        {
+            cnd_wait(&worker->wake, &worker->mutex);
+            continue;
+        }
+
+        worker->pending[slot] = false;
+        result.slot = slot;
+        result.chunk = worker->requests[slot];
+
+        mtx_unlock(&worker->mutex);
+        GenMazeStreamChunk(worker->seed, result.chunk.x, result.chunk.y, result.cells);
+        mtx_lock(&worker->mutex);
+
+        if (worker->resultCount < worker->resultCapacity) worker->results[worker->resultCount++] = result;
+        else worker->pending[slot] = true;
+    }
+
+    mtx_unlock(&worker->mutex);
+
+    return 0;
+}
+#endif
+
+#endif // MAZE_IMPLEMENTATION
+
+#endif // MAZE_STREAM_H